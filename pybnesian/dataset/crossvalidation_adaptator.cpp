@@ -2,8 +2,16 @@
 
 namespace dataset {
 
+void CrossValidation::materialize_fold_indices() const {
+    std::call_once(prop->fold_indices_flag, [this]() {
+        arrow::NumericBuilder<arrow::Int32Type> builder;
+        RAISE_STATUS_ERROR(builder.AppendValues(prop->indices));
+        RAISE_STATUS_ERROR(builder.Finish(&prop->arrow_indices));
+    });
+}
+
 std::pair<DataFrame, DataFrame> CrossValidation::generate_cv_pair(int fold) const {
-    arrow::NumericBuilder<arrow::Int32Type> builder;
+    materialize_fold_indices();
 
     auto test_fold_start = prop->limits[fold];
     auto test_fold_end = prop->limits[fold + 1];
@@ -11,6 +19,7 @@ std::pair<DataFrame, DataFrame> CrossValidation::generate_cv_pair(int fold) cons
 
     auto right_train_size = prop->limits.back() - test_fold_end;
 
+    arrow::NumericBuilder<arrow::Int32Type> builder;
     RAISE_STATUS_ERROR(builder.Reserve(prop->limits.back() - test_fold_size));
     if (test_fold_start > 0) {
         RAISE_STATUS_ERROR(builder.AppendValues(prop->indices.data(), test_fold_start));
@@ -20,14 +29,11 @@ std::pair<DataFrame, DataFrame> CrossValidation::generate_cv_pair(int fold) cons
         RAISE_STATUS_ERROR(builder.AppendValues(prop->indices.data() + test_fold_end, right_train_size));
     }
 
-    Array_ptr arrow_indices;
-    RAISE_STATUS_ERROR(builder.Finish(&arrow_indices));
-    auto train_df = m_df.take(arrow_indices);
-
-    RAISE_STATUS_ERROR(builder.AppendValues(prop->indices.data() + test_fold_start, test_fold_size));
-    RAISE_STATUS_ERROR(builder.Finish(&arrow_indices));
+    Array_ptr train_indices;
+    RAISE_STATUS_ERROR(builder.Finish(&train_indices));
 
-    return std::make_pair(std::move(train_df), m_df.take(arrow_indices));
+    auto test_indices = prop->arrow_indices->Slice(test_fold_start, test_fold_size);
+    return std::make_pair(m_df.take(train_indices), m_df.take(test_indices));
 }
 
 std::pair<std::vector<int>, std::vector<int>> CrossValidation::generate_cv_pair_indices(int fold) const {
@@ -1,6 +1,7 @@
 #ifndef PYBNESIAN_DATASET_CROSSVALIDATION_ADAPTATOR_HPP
 #define PYBNESIAN_DATASET_CROSSVALIDATION_ADAPTATOR_HPP
 
+#include <mutex>
 #include <random>
 #include <dataset/dataset.hpp>
 
@@ -15,7 +16,7 @@ namespace dataset {
 class CrossValidationProperties {
 public:
     CrossValidationProperties(const DataFrame& df, int k, unsigned int seed, bool include_null)
-        : k(k), m_seed(seed), indices(), limits() {
+        : k(k), m_seed(seed), indices(), limits(), arrow_indices(), fold_indices_flag() {
         if (k <= 1 || k > df->num_rows()) {
             throw std::invalid_argument("Cannot split " + std::to_string(df->num_rows()) + " instances into " +
                                         std::to_string(k) + " folds.");
@@ -64,6 +65,11 @@ private:
     unsigned int m_seed;
     std::vector<int> indices;
     std::vector<int> limits;
+    // Arrow array with the shuffled indices. It is created the first time a fold DataFrame is requested, and shared by
+    // all the CrossValidation objects created with loc(). The test indices of each fold are a slice of this array. The
+    // train indices are built for each requested fold, so the memory does not grow with the number of folds.
+    Array_ptr arrow_indices;
+    std::once_flag fold_indices_flag;
 };
 
 class CrossValidation {
@@ -122,7 +128,9 @@ public:
 
     cv_iterator end() { return cv_iterator(prop->k, *this); }
 
-    std::pair<DataFrame, DataFrame> fold(int fold) { return generate_cv_pair(fold); }
+    std::pair<DataFrame, DataFrame> fold(int fold) const { return generate_cv_pair(fold); }
+
+    int num_folds() const { return prop->k; }
 
     const DataFrame& data() const { return m_df; }
 
@@ -194,6 +202,7 @@ public:
 
 private:
     CrossValidation(const DataFrame df, const std::shared_ptr<CrossValidationProperties> prop) : m_df(df), prop(prop) {}
+    void materialize_fold_indices() const;
     std::pair<DataFrame, DataFrame> generate_cv_pair(int fold) const;
     std::pair<std::vector<int>, std::vector<int>> generate_cv_pair_indices(int fold) const;
 
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <factors/discrete/contingency_cache.hpp>
+
+namespace factors::discrete {
+
+// Sums the counts of table over the variables not included in variables. The result is laid out following the order
+// of variables and the given strides.
+VectorXi project_counts(const std::vector<std::string>& table_variables,
+                        const VectorXi& table_cardinality,
+                        const VectorXi& table_strides,
+                        const VectorXi& table_counts,
+                        const std::vector<std::string>& variables,
+                        const VectorXi& cardinality,
+                        const VectorXi& strides) {
+    std::vector<int> positions;
+    positions.reserve(variables.size());
+    for (const auto& v : variables) {
+        auto it = std::lower_bound(table_variables.begin(), table_variables.end(), v);
+        positions.push_back(std::distance(table_variables.begin(), it));
+    }
+
+    VectorXi result = VectorXi::Zero(cardinality.prod());
+
+    for (auto i = 0; i < table_counts.rows(); ++i) {
+        if (table_counts(i) == 0) continue;
+
+        auto index = 0;
+        for (size_t j = 0, j_end = positions.size(); j < j_end; ++j) {
+            auto p = positions[j];
+            index += ((i / table_strides(p)) % table_cardinality(p)) * strides(j);
+        }
+
+        result(index) += table_counts(i);
+    }
+
+    return result;
+}
+
+const ContingencyTableCache::ContingencyTable* ContingencyTableCache::find_superset(
+    const std::vector<std::string>& key) const {
+    const ContingencyTable* best = nullptr;
+
+    for (const auto& [table_key, table] : m_tables) {
+        // Marginalizing is only worth it if the table is smaller than the data.
+        if (table_key.size() <= key.size() || table.counts.rows() >= m_df->num_rows()) continue;
+        if (best && table.counts.rows() >= best->counts.rows()) continue;
+        if (!std::includes(table_key.begin(), table_key.end(), key.begin(), key.end())) continue;
+
+        // The rows with nulls in the extra variables were not counted in the table.
+        bool extra_nulls = false;
+        for (const auto& v : table_key) {
+            if (!std::binary_search(key.begin(), key.end(), v) && m_df.null_count(v) > 0) {
+                extra_nulls = true;
+                break;
+            }
+        }
+
+        if (!extra_nulls) best = &table;
+    }
+
+    return best;
+}
+
+void ContingencyTableCache::insert(ContingencyTable&& table) {
+    auto cells = table.counts.rows();
+    if (m_cells + cells > m_max_cells || m_tables.count(table.variables) > 0) return;
+
+    m_cells += cells;
+    auto key = table.variables;
+    m_tables.insert(std::make_pair(std::move(key), std::move(table)));
+}
+
+VectorXi ContingencyTableCache::joint_counts(const std::string& variable,
+                                             const std::vector<std::string>& evidence,
+                                             const VectorXi& cardinality,
+                                             const VectorXi& strides) {
+    std::vector<std::string> variables{variable};
+    variables.reserve(evidence.size() + 1);
+    variables.insert(variables.end(), evidence.begin(), evidence.end());
+
+    auto key = variables;
+    std::sort(key.begin(), key.end());
+
+    if (std::adjacent_find(key.begin(), key.end()) != key.end()) {
+        return factors::discrete::joint_counts(m_df, variable, evidence, cardinality, strides, m_num_threads);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_tables.find(key);
+        if (it != m_tables.end()) {
+            const auto& t = it->second;
+            if (variables == key) return t.counts;
+            return project_counts(t.variables, t.cardinality, t.strides, t.counts, variables, cardinality, strides);
+        }
+
+        if (const auto* superset = find_superset(key)) {
+            ContingencyTable t;
+            t.variables = key;
+            std::tie(t.cardinality, t.strides) = create_cardinality_strides(m_df, key);
+            t.counts = project_counts(superset->variables,
+                                      superset->cardinality,
+                                      superset->strides,
+                                      superset->counts,
+                                      key,
+                                      t.cardinality,
+                                      t.strides);
+
+            auto result =
+                project_counts(t.variables, t.cardinality, t.strides, t.counts, variables, cardinality, strides);
+            insert(std::move(t));
+            return result;
+        }
+    }
+
+    // Read the data without holding the lock, so other threads can use the cache meanwhile.
+    ContingencyTable t;
+    t.variables = key;
+    std::tie(t.cardinality, t.strides) = create_cardinality_strides(m_df, key);
+    std::vector<std::string> key_evidence(key.begin() + 1, key.end());
+    t.counts =
+        factors::discrete::joint_counts(m_df, key[0], key_evidence, t.cardinality, t.strides, m_num_threads);
+
+    VectorXi result;
+    if (variables == key)
+        result = t.counts;
+    else
+        result = project_counts(t.variables, t.cardinality, t.strides, t.counts, variables, cardinality, strides);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    insert(std::move(t));
+    return result;
+}
+
+}  // namespace factors::discrete
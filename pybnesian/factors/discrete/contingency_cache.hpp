@@ -0,0 +1,61 @@
+#ifndef PYBNESIAN_FACTORS_DISCRETE_CONTINGENCY_CACHE_HPP
+#define PYBNESIAN_FACTORS_DISCRETE_CONTINGENCY_CACHE_HPP
+
+#include <map>
+#include <mutex>
+#include <factors/discrete/discrete_indices.hpp>
+
+namespace factors::discrete {
+
+// Memoizes the contingency tables of a DataFrame, keyed by the set of variables. A count query is answered from the
+// cached table of the same set of variables or, if it is cheaper than reading the data, by marginalizing the smallest
+// cached superset. The raw data is only scanned for sets of variables that cannot be derived from the cache.
+//
+// The cache is thread safe. The data is read using num_threads threads (see factors::discrete::joint_counts()).
+class ContingencyTableCache {
+public:
+    ContingencyTableCache(const DataFrame& df, int num_threads = 1, int max_cells = 10000000)
+        : m_df(df), m_num_threads(num_threads), m_max_cells(max_cells), m_cells(0), m_tables(), m_mutex() {}
+
+    // Returns the same result as factors::discrete::joint_counts(df, variable, evidence, cardinality, strides).
+    VectorXi joint_counts(const std::string& variable,
+                          const std::vector<std::string>& evidence,
+                          const VectorXi& cardinality,
+                          const VectorXi& strides);
+
+    int num_threads() const { return m_num_threads; }
+
+    int num_tables() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_tables.size();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tables.clear();
+        m_cells = 0;
+    }
+
+private:
+    // Counts of a set of variables, stored with the variables sorted by name.
+    struct ContingencyTable {
+        std::vector<std::string> variables;
+        VectorXi cardinality;
+        VectorXi strides;
+        VectorXi counts;
+    };
+
+    const ContingencyTable* find_superset(const std::vector<std::string>& key) const;
+    void insert(ContingencyTable&& table);
+
+    const DataFrame m_df;
+    int m_num_threads;
+    int m_max_cells;
+    int m_cells;
+    std::map<std::vector<std::string>, ContingencyTable> m_tables;
+    mutable std::mutex m_mutex;
+};
+
+}  // namespace factors::discrete
+
+#endif  // PYBNESIAN_FACTORS_DISCRETE_CONTINGENCY_CACHE_HPP
@@ -1,4 +1,5 @@
 #include <factors/discrete/discrete_indices.hpp>
+#include <util/parallel.hpp>
 
 namespace factors::discrete {
 
@@ -51,6 +52,25 @@ void sum_to_discrete_indices(VectorXi& accum_indices, Array_ptr& indices, int st
     }
 }
 
+void sum_to_block_indices(int* block_indices, const Array_ptr& indices, int64_t offset, int64_t length, int stride) {
+    switch (indices->type_id()) {
+        case Type::INT8:
+            sum_to_block_indices<arrow::Int8Type>(block_indices, indices, offset, length, stride);
+            break;
+        case Type::INT16:
+            sum_to_block_indices<arrow::Int16Type>(block_indices, indices, offset, length, stride);
+            break;
+        case Type::INT32:
+            sum_to_block_indices<arrow::Int32Type>(block_indices, indices, offset, length, stride);
+            break;
+        case Type::INT64:
+            sum_to_block_indices<arrow::Int64Type>(block_indices, indices, offset, length, stride);
+            break;
+        default:
+            throw std::invalid_argument("Wrong indices array type of DictionaryArray.");
+    }
+}
+
 VectorXi discrete_indices(const DataFrame& df,
                           const std::string& variable,
                           const std::vector<std::string>& evidence,
@@ -135,18 +155,70 @@ VectorXi joint_counts(const DataFrame& df,
                       const std::string& variable,
                       const std::vector<std::string>& evidence,
                       const VectorXi& cardinality,
-                      const VectorXi& strides) {
+                      const VectorXi& strides,
+                      int num_threads) {
+    // Number of rows whose configuration indices are computed at once. The block fits in the L1 cache.
+    constexpr int64_t BLOCK_SIZE = 4096;
+
     auto joint_values = cardinality.prod();
 
-    VectorXi counts = VectorXi::Zero(joint_values);
-    VectorXi indices = discrete_indices(df, variable, evidence, strides);
+    std::vector<Array_ptr> indices;
+    indices.reserve(evidence.size() + 1);
+    indices.push_back(std::static_pointer_cast<arrow::DictionaryArray>(df.col(variable))->indices());
+    for (const auto& e : evidence) {
+        indices.push_back(std::static_pointer_cast<arrow::DictionaryArray>(df.col(e))->indices());
+    }
+
+    Buffer_ptr combined_bitmap = nullptr;
+    if (df.null_count(variable, evidence) > 0) combined_bitmap = df.combined_bitmap(variable, evidence);
+    const uint8_t* bitmap_data = combined_bitmap ? combined_bitmap->data() : nullptr;
+
+    auto num_rows = df->num_rows();
+    auto num_blocks = (num_rows + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    // Each task counts a contiguous range of blocks in its own histogram. The number of tasks is limited, so the
+    // private histograms do not take more memory than the data.
+    int64_t num_tasks = std::min(static_cast<int64_t>(util::resolve_num_threads(num_threads)), num_blocks);
+    num_tasks = std::max(int64_t{1}, std::min(num_tasks, num_rows / std::max(1, joint_values)));
+
+    std::vector<VectorXi> histograms(num_tasks);
+
+    util::parallel_for(0, static_cast<int>(num_tasks), static_cast<int>(num_tasks), [&](int t) {
+        VectorXi counts = VectorXi::Zero(joint_values);
+        std::vector<int> block_indices(BLOCK_SIZE);
+
+        auto begin_block = num_blocks * t / num_tasks;
+        auto end_block = num_blocks * (t + 1) / num_tasks;
+
+        for (auto b = begin_block; b < end_block; ++b) {
+            auto offset = b * BLOCK_SIZE;
+            auto length = std::min(BLOCK_SIZE, num_rows - offset);
+
+            std::fill(block_indices.begin(), block_indices.begin() + length, 0);
+            for (size_t j = 0, j_end = indices.size(); j < j_end; ++j) {
+                sum_to_block_indices(block_indices.data(), indices[j], offset, length, strides(j));
+            }
+
+            if (bitmap_data) {
+                // The indices of the null rows can be out of range, so they are never used.
+                for (auto i = 0; i < length; ++i) {
+                    if (util::bit_util::GetBit(bitmap_data, offset + i)) ++counts(block_indices[i]);
+                }
+            } else {
+                for (auto i = 0; i < length; ++i) {
+                    ++counts(block_indices[i]);
+                }
+            }
+        }
+
+        histograms[t] = std::move(counts);
+    });
 
-    // Compute counts
-    for (auto i = 0; i < indices.rows(); ++i) {
-        ++counts(indices(i));
+    for (auto t = 1; t < num_tasks; ++t) {
+        histograms[0] += histograms[t];
     }
 
-    return counts;
+    return histograms[0];
 }
 
 VectorXi marginal_counts(const VectorXi& joint_counts,
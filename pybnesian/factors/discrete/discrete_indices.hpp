@@ -44,6 +44,19 @@ void sum_to_discrete_indices(VectorXi& accum_indices, Array_ptr& indices, int st
 
 void sum_to_discrete_indices(VectorXi& accum_indices, Array_ptr& indices, int stride);
 
+// Adds stride * indices[offset + i] to block_indices[i] for every i in [0, length).
+template <typename ArrowType>
+void sum_to_block_indices(int* block_indices, const Array_ptr& indices, int64_t offset, int64_t length, int stride) {
+    using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+    const auto* raw_values = std::static_pointer_cast<ArrayType>(indices)->raw_values() + offset;
+
+    for (int64_t i = 0; i < length; ++i) {
+        block_indices[i] += static_cast<int>(raw_values[i]) * stride;
+    }
+}
+
+void sum_to_block_indices(int* block_indices, const Array_ptr& indices, int64_t offset, int64_t length, int stride);
+
 template <bool contains_null>
 VectorXi discrete_indices(const DataFrame& df,
                           const std::string& variable,
@@ -132,11 +145,14 @@ std::pair<VectorXi, VectorXi> create_cardinality_strides(const DataFrame& df,
 std::pair<VectorXi, VectorXi> create_cardinality_strides(const DataFrame& df,
                                                          const std::vector<std::string>& variables);
 
+// Counts the rows of df for each joint configuration of variable and evidence. The rows are counted in blocks split
+// among num_threads threads (0 uses all the available hardware threads).
 VectorXi joint_counts(const DataFrame& df,
                       const std::string& variable,
                       const std::vector<std::string>& evidence,
                       const VectorXi& cardinality,
-                      const VectorXi& strides);
+                      const VectorXi& strides,
+                      int num_threads = 1);
 
 VectorXi marginal_counts(const VectorXi& joint_counts, int index, const VectorXi& cardinality, const VectorXi& strides);
 
@@ -1133,6 +1133,9 @@ public:
     const std::unordered_set<int>& roots() const { return m_roots; }
     const std::unordered_set<int>& leaves() const { return m_leaves; }
 
+    // Number of arcs added to the graph since its creation. It allows the derived classes to detect arc additions.
+    std::size_t arc_additions() const { return m_arc_additions; }
+
 private:
     // friend int GraphBase<Derived>::add_node(const std::string& node);
     // friend void GraphBase<Derived>::remove_node_unsafe(int index);
@@ -1152,6 +1155,7 @@ private:
     ArcSet m_arcs;
     std::unordered_set<int> m_roots;
     std::unordered_set<int> m_leaves;
+    std::size_t m_arc_additions = 0;
 };
 
 template <typename Derived, template <typename> typename BaseClass>
@@ -1210,6 +1214,7 @@ void ArcGraph<Derived, BaseClass>::add_arc_unsafe(int source, int target) {
     m_arcs.insert({source, target});
     base().m_nodes[target].add_parent(source);
     base().m_nodes[source].add_children(target);
+    ++m_arc_additions;
 }
 
 template <typename Derived, template <typename> typename BaseClass>
@@ -1900,6 +1905,7 @@ public:
         if (!this->has_arc_unsafe(s, t)) {
             check_can_exist_arc(*this, s, t);
             BaseClass::add_arc_unsafe(s, t);
+            update_rank(s, t);
         }
     }
 
@@ -1915,6 +1921,7 @@ public:
         if (this->has_arc_unsafe(s, t)) {
             check_can_exist_arc(*this, t, s);
             BaseClass::flip_arc_unsafe(s, t);
+            update_rank(t, s);
         }
     }
 
@@ -1941,6 +1948,23 @@ public:
                                                         const std::vector<std::string>& interface_nodes) const;
     ConditionalGraph<DirectedAcyclic> conditional_graph() const;
     Graph<DirectedAcyclic> unconditional_graph() const;
+
+private:
+    bool sync_rank() const;
+    bool has_path_rank(int source, int target, bool skip_direct_arc) const;
+    void update_rank(int source, int target);
+    unsigned int new_mark_epoch() const;
+
+    // Topological rank of each raw node index, used to answer the acyclicity queries without traversing the whole
+    // graph. Removing arcs never invalidates a topological order, and the arcs added by add_arc()/flip_arc() update
+    // the order incrementally (Pearce-Kelly algorithm). If the arcs were added by other means, m_rank_additions is
+    // outdated and the rank is recomputed in the next query.
+    mutable std::vector<int> m_rank;
+    mutable int m_next_rank = 0;
+    mutable std::size_t m_rank_additions = std::numeric_limits<std::size_t>::max();
+    // Visited marks of the graph traversals. A node is visited if its mark is equal to the current epoch.
+    mutable std::vector<unsigned int> m_mark;
+    mutable unsigned int m_mark_epoch = 0;
 };
 
 class DagBase {
@@ -2709,12 +2733,14 @@ std::vector<std::string> DagImpl<Derived, BaseClass>::topological_sort() const {
 
 template <typename Derived, typename BaseClass>
 bool DagImpl<Derived, BaseClass>::can_add_arc_unsafe(int source, int target) const {
-    if (source != target && can_exist_arc(*this, source, target) &&
-        (this->num_parents_unsafe(source) == 0 || this->num_children_unsafe(target) == 0 ||
-         !this->has_path_unsafe(target, source))) {
-        return true;
-    }
-    return false;
+    if (source == target || !can_exist_arc(*this, source, target)) return false;
+
+    if (this->num_parents_unsafe(source) == 0 || this->num_children_unsafe(target) == 0) return true;
+
+    if (sync_rank())
+        return !has_path_rank(target, source, false);
+    else
+        return !this->has_path_unsafe(target, source);
 }
 
 template <typename Derived, typename BaseClass>
@@ -2724,7 +2750,8 @@ bool DagImpl<Derived, BaseClass>::can_flip_arc_unsafe(int source, int target) co
     if (this->has_arc_unsafe(source, target)) {
         if (this->num_parents_unsafe(target) == 1 || this->num_children_unsafe(source) == 1) return true;
 
-        bool thereis_path = this->has_path_unsafe_no_direct_arc(source, target);
+        bool thereis_path =
+            sync_rank() ? has_path_rank(source, target, true) : this->has_path_unsafe_no_direct_arc(source, target);
         if (thereis_path) {
             return false;
         } else {
@@ -2733,7 +2760,7 @@ bool DagImpl<Derived, BaseClass>::can_flip_arc_unsafe(int source, int target) co
     } else {
         if (this->num_parents_unsafe(target) == 0 || this->num_children_unsafe(source) == 0) return true;
 
-        bool thereis_path = this->has_path_unsafe(source, target);
+        bool thereis_path = sync_rank() ? has_path_rank(source, target, false) : this->has_path_unsafe(source, target);
         if (thereis_path) {
             return false;
         } else {
@@ -2742,6 +2769,159 @@ bool DagImpl<Derived, BaseClass>::can_flip_arc_unsafe(int source, int target) co
     }
 }
 
+// Makes m_rank a valid topological rank of the graph. Returns false if the graph is not acyclic.
+template <typename Derived, typename BaseClass>
+bool DagImpl<Derived, BaseClass>::sync_rank() const {
+    const auto& raw_nodes = this->raw_nodes();
+    int num_raw = static_cast<int>(raw_nodes.size());
+
+    if (m_rank_additions == this->arc_additions()) {
+        // Nodes added after the last update do not have arcs, so any rank is valid for them.
+        while (static_cast<int>(m_rank.size()) < num_raw) {
+            m_rank.push_back(m_next_rank++);
+        }
+
+        return true;
+    }
+
+    m_rank.assign(num_raw, -1);
+    m_next_rank = 0;
+
+    std::vector<int> incoming_edges(num_raw);
+    std::vector<int> stack;
+    for (int i = 0; i < num_raw; ++i) {
+        if (raw_nodes[i].is_valid()) {
+            incoming_edges[i] = raw_nodes[i].parents().size();
+            if (incoming_edges[i] == 0) stack.push_back(i);
+        } else {
+            m_rank[i] = m_next_rank++;
+        }
+    }
+
+    while (!stack.empty()) {
+        auto idx = stack.back();
+        stack.pop_back();
+
+        m_rank[idx] = m_next_rank++;
+
+        for (auto ch : raw_nodes[idx].children()) {
+            if (--incoming_edges[ch] == 0) stack.push_back(ch);
+        }
+    }
+
+    if (m_next_rank < num_raw) {
+        m_rank_additions = std::numeric_limits<std::size_t>::max();
+        return false;
+    }
+
+    m_rank_additions = this->arc_additions();
+    return true;
+}
+
+template <typename Derived, typename BaseClass>
+unsigned int DagImpl<Derived, BaseClass>::new_mark_epoch() const {
+    m_mark.resize(this->num_raw_nodes(), m_mark_epoch);
+
+    if (++m_mark_epoch == 0) {
+        std::fill(m_mark.begin(), m_mark.end(), 0);
+        m_mark_epoch = 1;
+    }
+
+    return m_mark_epoch;
+}
+
+// Checks if there is a path from source to target using a valid m_rank. Every node in a path from source to target has
+// a rank between the rank of source and the rank of target, so the traversal does not leave that window.
+template <typename Derived, typename BaseClass>
+bool DagImpl<Derived, BaseClass>::has_path_rank(int source, int target, bool skip_direct_arc) const {
+    if (m_rank[source] > m_rank[target]) return false;
+
+    const auto& raw_nodes = this->raw_nodes();
+    auto epoch = new_mark_epoch();
+    auto target_rank = m_rank[target];
+
+    std::vector<int> stack{source};
+    m_mark[source] = epoch;
+
+    while (!stack.empty()) {
+        auto v = stack.back();
+        stack.pop_back();
+
+        for (auto ch : raw_nodes[v].children()) {
+            if (ch == target) {
+                if (v == source && skip_direct_arc) continue;
+                return true;
+            }
+
+            if (m_rank[ch] < target_rank && m_mark[ch] != epoch) {
+                m_mark[ch] = epoch;
+                stack.push_back(ch);
+            }
+        }
+    }
+
+    return false;
+}
+
+// Updates m_rank after adding the acyclic arc source -> target.
+template <typename Derived, typename BaseClass>
+void DagImpl<Derived, BaseClass>::update_rank(int source, int target) {
+    // If the rank was already outdated, it will be recomputed in the next query.
+    if (m_rank_additions + 1 != this->arc_additions()) return;
+
+    m_rank_additions = this->arc_additions();
+    // Nodes added after the last update did not have arcs, so any rank was valid for them.
+    while (static_cast<int>(m_rank.size()) < this->num_raw_nodes()) {
+        m_rank.push_back(m_next_rank++);
+    }
+
+    auto lower = m_rank[target];
+    auto upper = m_rank[source];
+    if (upper < lower) return;
+
+    // Only the nodes reachable from target and the nodes that reach source with a rank in [lower, upper] are
+    // reordered.
+    const auto& raw_nodes = this->raw_nodes();
+    auto epoch = new_mark_epoch();
+
+    std::vector<int> forward{target};
+    m_mark[target] = epoch;
+    for (size_t i = 0; i < forward.size(); ++i) {
+        for (auto ch : raw_nodes[forward[i]].children()) {
+            if (m_rank[ch] < upper && m_mark[ch] != epoch) {
+                m_mark[ch] = epoch;
+                forward.push_back(ch);
+            }
+        }
+    }
+
+    std::vector<int> backward{source};
+    m_mark[source] = epoch;
+    for (size_t i = 0; i < backward.size(); ++i) {
+        for (auto pa : raw_nodes[backward[i]].parents()) {
+            if (m_rank[pa] > lower && m_mark[pa] != epoch) {
+                m_mark[pa] = epoch;
+                backward.push_back(pa);
+            }
+        }
+    }
+
+    auto by_rank = [this](int a, int b) { return m_rank[a] < m_rank[b]; };
+    std::sort(forward.begin(), forward.end(), by_rank);
+    std::sort(backward.begin(), backward.end(), by_rank);
+
+    std::vector<int> ranks;
+    ranks.reserve(forward.size() + backward.size());
+    for (auto n : backward) ranks.push_back(m_rank[n]);
+    for (auto n : forward) ranks.push_back(m_rank[n]);
+    std::sort(ranks.begin(), ranks.end());
+
+    // The nodes that reach source go before the nodes reachable from target, keeping their relative order.
+    size_t r = 0;
+    for (auto n : backward) m_rank[n] = ranks[r++];
+    for (auto n : forward) m_rank[n] = ranks[r++];
+}
+
 template <typename Derived, typename BaseClass>
 std::vector<Arc> sort_arcs(const DagImpl<Derived, BaseClass>& g) {
     auto top_sort = g.topological_sort();
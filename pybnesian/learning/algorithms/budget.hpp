@@ -0,0 +1,148 @@
+#ifndef PYBNESIAN_LEARNING_ALGORITHMS_BUDGET_HPP
+#define PYBNESIAN_LEARNING_ALGORITHMS_BUDGET_HPP
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <learning/scores/scores.hpp>
+
+using learning::scores::Score, learning::scores::ValidatedScore, learning::scores::LocalScoreBound;
+
+namespace learning::algorithms {
+
+// Thrown when a local score is requested after the budget of the search is exhausted.
+class BudgetExhausted : public std::runtime_error {
+public:
+    BudgetExhausted() : std::runtime_error("The budget of the search is exhausted.") {}
+};
+
+// Wall-clock time and local score evaluations allowed in a search. A non-positive limit means no limit. All the methods
+// can be called concurrently.
+class SearchBudget {
+public:
+    SearchBudget(double max_time, int max_evaluations)
+        : m_start(std::chrono::steady_clock::now()),
+          m_max_time(max_time),
+          m_max_evaluations(max_evaluations),
+          m_evaluations(0) {}
+
+    // Elapsed time in seconds since the budget was created.
+    double elapsed_time() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+    long long evaluations() const { return m_evaluations.load(); }
+
+    // True if the time or the number of evaluations is limited.
+    bool limited() const { return m_max_time > 0 || m_max_evaluations > 0; }
+
+    bool exhausted() const {
+        return (m_max_time > 0 && elapsed_time() >= m_max_time) ||
+               (m_max_evaluations > 0 && m_evaluations.load() >= m_max_evaluations);
+    }
+
+    // Registers a new local score evaluation. Throws BudgetExhausted if the budget does not allow it.
+    void consume() {
+        if (m_max_time > 0 && elapsed_time() >= m_max_time) throw BudgetExhausted();
+
+        auto previous = m_evaluations.fetch_add(1);
+        if (m_max_evaluations > 0 && previous >= m_max_evaluations) {
+            m_evaluations.fetch_sub(1);
+            throw BudgetExhausted();
+        }
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+    double m_max_time;
+    int m_max_evaluations;
+    std::atomic<long long> m_evaluations;
+};
+
+// Implements the Score interface on top of another score, consuming the SearchBudget on each local score evaluation.
+// Both objects must outlive the adaptator.
+template <typename BaseScore>
+class BudgetedScoreAdaptator : public BaseScore {
+public:
+    BudgetedScoreAdaptator(BaseScore& score, SearchBudget& budget) : m_score(score), m_budget(budget) {}
+
+    using BaseScore::local_score;
+
+    double local_score(const BayesianNetworkBase& model,
+                       const std::string& variable,
+                       const std::vector<std::string>& parents) const override {
+        m_budget.consume();
+        return m_score.local_score(model, variable, parents);
+    }
+
+    double local_score(const BayesianNetworkBase& model,
+                       const std::shared_ptr<FactorType>& node_type,
+                       const std::string& variable,
+                       const std::vector<std::string>& parents) const override {
+        m_budget.consume();
+        return m_score.local_score(model, node_type, variable, parents);
+    }
+
+    LocalScoreBound local_score_bound(const BayesianNetworkBase& model,
+                                      const std::string& variable,
+                                      const std::vector<std::string>& parents,
+                                      double threshold) const override {
+        m_budget.consume();
+        return m_score.local_score_bound(model, variable, parents, threshold);
+    }
+
+    LocalScoreBound local_score_bound(const BayesianNetworkBase& model,
+                                      const std::shared_ptr<FactorType>& node_type,
+                                      const std::string& variable,
+                                      const std::vector<std::string>& parents,
+                                      double threshold) const override {
+        m_budget.consume();
+        return m_score.local_score_bound(model, node_type, variable, parents, threshold);
+    }
+
+    std::string ToString() const override { return m_score.ToString(); }
+    bool has_variables(const std::string& name) const override { return m_score.has_variables(name); }
+    bool has_variables(const std::vector<std::string>& cols) const override { return m_score.has_variables(cols); }
+    bool compatible_bn(const BayesianNetworkBase& model) const override { return m_score.compatible_bn(model); }
+    bool compatible_bn(const ConditionalBayesianNetworkBase& model) const override {
+        return m_score.compatible_bn(model);
+    }
+    DataFrame data() const override { return m_score.data(); }
+    bool is_thread_safe() const override { return m_score.is_thread_safe(); }
+
+protected:
+    BaseScore& m_score;
+    SearchBudget& m_budget;
+};
+
+class BudgetedScore : public BudgetedScoreAdaptator<Score> {
+public:
+    BudgetedScore(Score& score, SearchBudget& budget) : BudgetedScoreAdaptator<Score>(score, budget) {}
+};
+
+class BudgetedValidatedScore : public BudgetedScoreAdaptator<ValidatedScore> {
+public:
+    BudgetedValidatedScore(ValidatedScore& score, SearchBudget& budget)
+        : BudgetedScoreAdaptator<ValidatedScore>(score, budget) {}
+
+    using ValidatedScore::vlocal_score;
+
+    double vlocal_score(const BayesianNetworkBase& model,
+                        const std::string& variable,
+                        const std::vector<std::string>& parents) const override {
+        m_budget.consume();
+        return m_score.vlocal_score(model, variable, parents);
+    }
+
+    double vlocal_score(const BayesianNetworkBase& model,
+                        const std::shared_ptr<FactorType>& node_type,
+                        const std::string& variable,
+                        const std::vector<std::string>& parents) const override {
+        m_budget.consume();
+        return m_score.vlocal_score(model, node_type, variable, parents);
+    }
+};
+
+}  // namespace learning::algorithms
+
+#endif  // PYBNESIAN_LEARNING_ALGORITHMS_BUDGET_HPP
@@ -15,6 +15,8 @@ class Callback {
 public:
     virtual ~Callback() = default;
     virtual void call(BayesianNetworkBase& model, Operator* new_operator, Score& score, int num_iter) const = 0;
+    // Called after each call() with the elapsed time (in seconds) and the number of local score evaluations.
+    virtual void report(double, long long) const {}
 };
 
 }  // namespace learning::algorithms::callbacks
@@ -5,6 +5,7 @@
 #include <learning/independences/independence.hpp>
 #include <util/progress.hpp>
 #include <util/combinations.hpp>
+#include <util/parallel.hpp>
 
 using graph::PartiallyDirectedGraph;
 using learning::independences::IndependenceTest;
@@ -40,6 +41,14 @@ private:
     std::unordered_map<Edge, std::pair<std::unordered_set<int>, double>, EdgeHash, EdgeEqualTo> m_sep;
 };
 
+// Returns the number of threads to run the independence tests. The tests are run in the calling thread if test is not
+// thread-safe.
+inline int test_num_threads(int num_threads, const IndependenceTest& test) {
+    if (!test.is_thread_safe()) return 1;
+
+    return util::resolve_num_threads(num_threads);
+}
+
 template <typename G>
 void direct_arc_blacklist(G& g, const ArcSet& arc_blacklist) {
     for (const auto& arc : arc_blacklist) {
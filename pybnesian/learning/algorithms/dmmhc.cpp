@@ -43,7 +43,8 @@ std::shared_ptr<DynamicBayesianNetworkBase> DMMHC::estimate(const DynamicIndepen
                                                             double epsilon,
                                                             int patience,
                                                             double alpha,
-                                                            int verbose) {
+                                                            int verbose,
+                                                            int num_threads) {
     std::vector<std::string> vars;
     if (variables.empty())
         vars = test.variable_names();
@@ -88,7 +89,8 @@ std::shared_ptr<DynamicBayesianNetworkBase> DMMHC::estimate(const DynamicIndepen
                             epsilon,
                             patience,
                             alpha,
-                            verbose);
+                            verbose,
+                            num_threads);
 
     auto transition_nodes = util::temporal_names(vars, 0, 0);
     const auto& transition_tests = test.transition_tests();
@@ -112,7 +114,8 @@ std::shared_ptr<DynamicBayesianNetworkBase> DMMHC::estimate(const DynamicIndepen
                                         epsilon,
                                         patience,
                                         alpha,
-                                        verbose);
+                                        verbose,
+                                        num_threads);
 
     return std::make_shared<DynamicBayesianNetwork>(vars, markovian_order, std::move(g0), std::move(gt));
 }
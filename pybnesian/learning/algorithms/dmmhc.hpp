@@ -27,7 +27,8 @@ public:
                                                          double epsilon,
                                                          int patience,
                                                          double alpha,
-                                                         int verbose = 0);
+                                                         int verbose = 0,
+                                                         int num_threads = 1);
 };
 
 }  // namespace learning::algorithms
@@ -1,3 +1,4 @@
+#include <random>
 #include <learning/algorithms/hillclimbing.hpp>
 #include <util/validate_options.hpp>
 #include <dataset/dataset.hpp>
@@ -9,7 +10,10 @@
 #include <learning/scores/bic.hpp>
 #include <learning/scores/cv_likelihood.hpp>
 #include <learning/scores/holdout_likelihood.hpp>
+#include <learning/scores/cached_score.hpp>
+#include <learning/scores/screening_score.hpp>
 #include <learning/operators/operators.hpp>
+#include <util/parallel.hpp>
 
 using namespace dataset;
 
@@ -17,6 +21,7 @@ using Eigen::VectorXd, Eigen::MatrixXd;
 ;
 using learning::operators::OperatorSet, learning::operators::ArcOperatorSet, learning::operators::ChangeNodeTypeSet;
 using learning::scores::BIC, learning::scores::CVLikelihood, learning::scores::HoldoutLikelihood;
+using learning::scores::CachedScore, learning::scores::CachedValidatedScore, learning::scores::ScreeningScore;
 using models::BayesianNetworkType, models::GaussianNetwork, models::SemiparametricBN, models::KDENetwork;
 
 using util::ArcStringVector;
@@ -40,7 +45,14 @@ std::shared_ptr<BayesianNetworkBase> hc(const DataFrame& df,
                                         std::optional<unsigned int> seed,
                                         int num_folds,
                                         double test_holdout_ratio,
-                                        int verbose) {
+                                        int verbose,
+                                        int num_threads,
+                                        const ArcCandidates& arc_candidates,
+                                        int batch_size,
+                                        double max_time,
+                                        int max_score_evaluations,
+                                        int screening_rows,
+                                        int num_confirmations) {
     if (!bn_type && !start) {
         throw std::invalid_argument("\"bn_type\" or \"start\" parameter must be specified.");
     }
@@ -60,7 +72,7 @@ std::shared_ptr<BayesianNetworkBase> hc(const DataFrame& df,
     }();
 
     auto operators = util::check_valid_operators(
-        bn_type_, operators_str, arc_blacklist, arc_whitelist, max_indegree, type_whitelist);
+        bn_type_, operators_str, arc_blacklist, arc_whitelist, max_indegree, type_whitelist, arc_candidates);
 
     if (max_iters == 0) max_iters = std::numeric_limits<int>::max();
 
@@ -72,7 +84,20 @@ std::shared_ptr<BayesianNetworkBase> hc(const DataFrame& df,
     }();
 
     GreedyHillClimbing hc;
-    auto score = util::check_valid_score(df, bn_type_, score_str, iseed, num_folds, test_holdout_ratio);
+    std::shared_ptr<Score> score =
+        util::check_valid_score(df, bn_type_, score_str, iseed, num_folds, test_holdout_ratio);
+
+    if (screening_rows > 0) {
+        if (std::dynamic_pointer_cast<ValidatedScore>(score)) {
+            throw std::invalid_argument("screening_rows cannot be used with a ValidatedScore.");
+        }
+
+        // The operators are ranked with the same score learned from a stratified subsample of df.
+        auto subsample = ScreeningScore::stratified_subsample(df, screening_rows, iseed);
+        auto screening_score =
+            util::check_valid_score(subsample, bn_type_, score_str, iseed, num_folds, test_holdout_ratio);
+        score = std::make_shared<ScreeningScore>(screening_score, score, num_confirmations);
+    }
 
     return hc.estimate(*operators,
                        *score,
@@ -86,7 +111,150 @@ std::shared_ptr<BayesianNetworkBase> hc(const DataFrame& df,
                        max_iters,
                        epsilon,
                        patience,
-                       verbose);
+                       verbose,
+                       num_threads,
+                       batch_size,
+                       max_time,
+                       max_score_evaluations);
+}
+
+// Returns a random DAG that contains the whitelisted arcs. Each pair of nodes is connected with probability 2 / (n - 1)
+// following a random topological order, so the DAG has n arcs on average. The node types are set before sampling the
+// arcs, so the DAG only contains arcs allowed by the node types (e.g. no continuous -> discrete arcs in a CLG network).
+std::shared_ptr<BayesianNetworkBase> random_start(const BayesianNetworkType& bn_type,
+                                                  const DataFrame& df,
+                                                  const ArcStringVector& arc_blacklist,
+                                                  const ArcStringVector& arc_whitelist,
+                                                  const FactorTypeVector& type_blacklist,
+                                                  const FactorTypeVector& type_whitelist,
+                                                  int max_indegree,
+                                                  unsigned int seed) {
+    auto model = bn_type.new_bn(df.column_names());
+    model->force_type_whitelist(type_whitelist);
+    model->set_unknown_node_types(df, type_blacklist);
+
+    auto restrictions = util::validate_restrictions(*model, arc_blacklist, arc_whitelist);
+    model->force_whitelist(arc_whitelist);
+
+    auto order = model->nodes();
+    if (order.size() < 2) return model;
+
+    std::mt19937 rng{seed};
+    std::shuffle(order.begin(), order.end(), rng);
+    std::bernoulli_distribution connect(std::min(1., 2. / (order.size() - 1)));
+
+    for (std::size_t j = 1; j < order.size(); ++j) {
+        const auto& target = order[j];
+        for (std::size_t i = 0; i < j; ++i) {
+            const auto& source = order[i];
+            // The distribution is always sampled, so the DAG does not depend on the restrictions of previous arcs.
+            if (!connect(rng)) continue;
+
+            if ((max_indegree > 0 && model->num_parents(target) >= max_indegree) ||
+                restrictions.arc_blacklist.count(std::make_pair(model->index(source), model->index(target))) > 0 ||
+                model->has_arc(target, source) || !model->can_add_arc(source, target))
+                continue;
+
+            model->add_arc(source, target);
+        }
+    }
+
+    return model;
+}
+
+std::pair<std::shared_ptr<BayesianNetworkBase>, std::vector<double>> hc_restarts(
+    const DataFrame& df,
+    const std::shared_ptr<BayesianNetworkType> bn_type,
+    int n_starts,
+    const std::optional<std::string>& score_str,
+    const std::optional<std::vector<std::string>>& operators_str,
+    const ArcStringVector& arc_blacklist,
+    const ArcStringVector& arc_whitelist,
+    const FactorTypeVector& type_blacklist,
+    const FactorTypeVector& type_whitelist,
+    int max_indegree,
+    int max_iters,
+    double epsilon,
+    int patience,
+    std::optional<unsigned int> seed,
+    int num_folds,
+    double test_holdout_ratio,
+    int num_threads,
+    const ArcCandidates& arc_candidates,
+    int max_cache_size) {
+    if (!bn_type) {
+        throw std::invalid_argument("\"bn_type\" parameter must be specified.");
+    }
+
+    if (n_starts <= 0) {
+        throw std::invalid_argument("The number of starts must be positive.");
+    }
+
+    auto iseed = [seed]() {
+        if (seed)
+            return *seed;
+        else
+            return std::random_device{}();
+    }();
+
+    if (max_iters == 0) max_iters = std::numeric_limits<int>::max();
+
+    // All the starts share the same memo of local scores.
+    std::shared_ptr<Score> base_score =
+        util::check_valid_score(df, *bn_type, score_str, iseed, num_folds, test_holdout_ratio);
+    std::shared_ptr<Score> score = [&]() -> std::shared_ptr<Score> {
+        if (auto validated_score = std::dynamic_pointer_cast<ValidatedScore>(base_score))
+            return std::make_shared<CachedValidatedScore>(validated_score, max_cache_size);
+        else
+            return std::make_shared<CachedScore>(base_score, max_cache_size);
+    }();
+
+    // The first start is the empty network. The start i uses the seed (seed + i), so the results do not depend on
+    // the number of threads.
+    std::vector<std::shared_ptr<BayesianNetworkBase>> starts;
+    starts.reserve(n_starts);
+    starts.push_back(bn_type->new_bn(df.column_names()));
+    for (int i = 1; i < n_starts; ++i) {
+        starts.push_back(random_start(
+            *bn_type, df, arc_blacklist, arc_whitelist, type_blacklist, type_whitelist, max_indegree, iseed + i));
+    }
+
+    // If many starts run concurrently, each start is learned with a single thread.
+    auto starts_threads = std::min(learning::operators::score_num_threads(num_threads, *starts[0], *score), n_starts);
+    auto hc_threads = (starts_threads > 1) ? 1 : num_threads;
+
+    std::vector<std::shared_ptr<BayesianNetworkBase>> models(n_starts);
+    std::vector<double> scores(n_starts);
+
+    util::parallel_for(0, n_starts, starts_threads, [&](int i) {
+        auto operators = util::check_valid_operators(
+            *bn_type, operators_str, arc_blacklist, arc_whitelist, max_indegree, type_whitelist, arc_candidates);
+
+        GreedyHillClimbing hc;
+        models[i] = hc.estimate(*operators,
+                                *score,
+                                *starts[i],
+                                arc_blacklist,
+                                arc_whitelist,
+                                type_blacklist,
+                                type_whitelist,
+                                nullptr,
+                                max_indegree,
+                                max_iters,
+                                epsilon,
+                                patience,
+                                0,
+                                hc_threads);
+
+        if (auto validated_score = std::dynamic_pointer_cast<ValidatedScore>(score))
+            scores[i] = validated_score->vscore(*models[i]);
+        else
+            scores[i] = score->score(*models[i]);
+    });
+
+    // Ties are broken in favour of the first start.
+    auto best = std::max_element(scores.begin(), scores.end()) - scores.begin();
+    return std::make_pair(models[best], scores);
 }
 
 }  // namespace learning::algorithms
@@ -4,7 +4,10 @@
 #include <dataset/dataset.hpp>
 #include <models/BayesianNetwork.hpp>
 #include <learning/scores/scores.hpp>
+#include <learning/scores/cached_score.hpp>
+#include <learning/scores/screening_score.hpp>
 #include <learning/operators/operators.hpp>
+#include <learning/algorithms/budget.hpp>
 #include <learning/algorithms/callbacks/callback.hpp>
 #include <util/validate_whitelists.hpp>
 #include <util/math_constants.hpp>
@@ -14,10 +17,14 @@
 namespace py = pybind11;
 
 using dataset::DataFrame;
+using learning::algorithms::BudgetExhausted, learning::algorithms::SearchBudget, learning::algorithms::BudgetedScore,
+    learning::algorithms::BudgetedValidatedScore;
 using learning::algorithms::callbacks::Callback;
 using learning::operators::Operator, learning::operators::ArcOperator, learning::operators::ChangeNodeType,
-    learning::operators::OperatorTabuSet, learning::operators::OperatorSet, learning::operators::LocalScoreCache;
-using learning::scores::Score;
+    learning::operators::AddArc, learning::operators::FlipArc,
+    learning::operators::OperatorTabuSet, learning::operators::OperatorSet, learning::operators::LocalScoreCache,
+    learning::operators::ArcCandidates;
+using learning::scores::CachedScore, learning::scores::Score, learning::scores::ScreeningScore;
 using models::BayesianNetworkType, models::ConditionalBayesianNetworkBase;
 
 using util::ArcStringVector;
@@ -41,7 +48,37 @@ std::shared_ptr<BayesianNetworkBase> hc(const DataFrame& df,
                                         std::optional<unsigned int> seed,
                                         int num_folds,
                                         double test_holdout_ratio,
-                                        int verbose = 0);
+                                        int verbose = 0,
+                                        int num_threads = 1,
+                                        const ArcCandidates& arc_candidates = ArcCandidates(),
+                                        int batch_size = 1,
+                                        double max_time = 0,
+                                        int max_score_evaluations = 0,
+                                        int screening_rows = 0,
+                                        int num_confirmations = 5);
+
+// Runs hc() from n_starts starting structures and returns the model with the best score and the score of the model
+// learned from each start.
+std::pair<std::shared_ptr<BayesianNetworkBase>, std::vector<double>> hc_restarts(
+    const DataFrame& df,
+    const std::shared_ptr<BayesianNetworkType> bn_type,
+    int n_starts,
+    const std::optional<std::string>& score_str,
+    const std::optional<std::vector<std::string>>& operators_str,
+    const ArcStringVector& arc_blacklist,
+    const ArcStringVector& arc_whitelist,
+    const FactorTypeVector& type_blacklist,
+    const FactorTypeVector& type_whitelist,
+    int max_indegree,
+    int max_iters,
+    double epsilon,
+    int patience,
+    std::optional<unsigned int> seed,
+    int num_folds,
+    double test_holdout_ratio,
+    int num_threads,
+    const ArcCandidates& arc_candidates = ArcCandidates(),
+    int max_cache_size = 100000);
 
 template <typename T>
 double validation_delta_score(const T& model,
@@ -59,6 +96,91 @@ double validation_delta_score(const T& model,
     return nnew - prev;
 }
 
+inline std::string batch_status(const std::vector<std::shared_ptr<Operator>>& applied) {
+    if (applied.size() > 1)
+        return " (+" + std::to_string(applied.size() - 1) + " operators)";
+    else
+        return std::string();
+}
+
+// Applies the operators returned by OperatorSet::find_max_batch() to the model. The first operator is always applied.
+// The rest are applied if their delta is greater than epsilon and they do not create a cycle together with the applied
+// operators. Returns the applied operators.
+template <typename T>
+std::vector<std::shared_ptr<Operator>> apply_batch(T& model,
+                                                   const std::vector<std::shared_ptr<Operator>>& operators,
+                                                   double epsilon) {
+    std::vector<std::shared_ptr<Operator>> applied;
+    for (const auto& op : operators) {
+        if (!applied.empty()) {
+            if ((op->delta() - epsilon) < util::machine_tol) break;
+
+            if (auto add = dynamic_cast<const AddArc*>(op.get())) {
+                if (!model.can_add_arc(add->source(), add->target())) continue;
+            } else if (auto flip = dynamic_cast<const FlipArc*>(op.get())) {
+                if (!model.can_flip_arc(flip->source(), flip->target())) continue;
+            }
+        }
+
+        op->apply(model);
+        applied.push_back(op);
+    }
+
+    return applied;
+}
+
+// Returns the delta of the operator computed with the exact score. The exact local scores of the current model are
+// memoized in current_scores.
+template <typename T>
+double exact_delta_score(const T& model,
+                         const Score& exact,
+                         const Operator& op,
+                         std::unordered_map<std::string, double>& current_scores) {
+    auto new_model = model.clone();
+    op.apply(*new_model);
+
+    double delta = 0;
+    for (const auto& n : op.nodes_changed(model)) {
+        auto it = current_scores.find(n);
+        if (it == current_scores.end()) it = current_scores.emplace(n, exact.local_score(model, n)).first;
+
+        delta += exact.local_score(*new_model, n) - it->second;
+    }
+
+    return delta;
+}
+
+// Evaluates with the exact score the ScreeningScore::num_confirmations() operators with the best screening delta, and
+// returns the operator with the best exact delta and its exact delta. Only the operators with a positive screening
+// delta are confirmed, but the best operator is always evaluated.
+template <typename T>
+std::pair<std::shared_ptr<Operator>, double> confirm_screening(OperatorSet& op_set,
+                                                               const T& model,
+                                                               const OperatorTabuSet& tabu_set,
+                                                               const ScreeningScore& screening,
+                                                               const Score& exact) {
+    std::unordered_map<std::string, double> current_scores;
+    std::shared_ptr<Operator> best_op;
+    double best_delta = std::numeric_limits<double>::lowest();
+
+    // The confirmed operators are excluded from the next find_max() as if they were tabu.
+    auto excluded = tabu_set;
+    for (auto i = 0; i < screening.num_confirmations(); ++i) {
+        auto op = excluded.empty() ? op_set.find_max(model) : op_set.find_max(model, excluded);
+        if (!op || (best_op && op->delta() < util::machine_tol)) break;
+
+        auto delta = exact_delta_score(model, exact, *op, current_scores);
+        if (delta > best_delta) {
+            best_op = op;
+            best_delta = delta;
+        }
+
+        excluded.insert(op, model);
+    }
+
+    return std::make_pair(best_op, best_delta);
+}
+
 template <bool zero_patience, typename S, typename T>
 std::shared_ptr<T> estimate_hc(OperatorSet& op_set,
                                S& score,
@@ -72,7 +194,46 @@ std::shared_ptr<T> estimate_hc(OperatorSet& op_set,
                                int max_iters,
                                double epsilon,
                                int patience,
-                               int verbose) {
+                               int verbose,
+                               int num_threads,
+                               int batch_size,
+                               double max_time,
+                               int max_score_evaluations) {
+    if (batch_size < 1) {
+        throw std::invalid_argument("batch_size must be positive.");
+    }
+
+    SearchBudget budget(max_time, max_score_evaluations);
+    // If the search has a budget, the local scores are computed through a budgeted score, so the budget is also
+    // checked inside OperatorSet::cache_scores() and OperatorSet::update_scores(). Otherwise, the operators receive the
+    // original score. The callback always receives the original score.
+    using BudgetedType =
+        std::conditional_t<std::is_base_of_v<ValidatedScore, S>, BudgetedValidatedScore, BudgetedScore>;
+    std::optional<BudgetedType> budgeted;
+    if (budget.limited()) budgeted.emplace(score, budget);
+    S& budgeted_score = budgeted ? static_cast<S&>(*budgeted) : score;
+
+    // The operators are ranked with the screening score and confirmed with the exact score. A ScreeningScore wrapped in
+    // a CachedScore is also detected, so the memoized screening deltas are confirmed too.
+    const ScreeningScore* screening = nullptr;
+    if constexpr (!std::is_base_of_v<ValidatedScore, S>) {
+        const Score* base = &score;
+        while (auto cached = dynamic_cast<const CachedScore*>(base)) {
+            base = cached->base_score().get();
+        }
+
+        screening = dynamic_cast<const ScreeningScore*>(base);
+    }
+
+    if (screening && batch_size > 1) {
+        throw std::invalid_argument("ScreeningScore cannot be used with batch_size > 1.");
+    }
+
+    auto notify = [&](BayesianNetworkBase& model, Operator* op, int num_iter) {
+        callback->call(model, op, score, num_iter);
+        callback->report(budget.elapsed_time(), budget.evaluations());
+    };
+
     auto spinner = util::indeterminate_spinner(verbose);
     spinner->update_status("Checking dataset...");
 
@@ -100,99 +261,153 @@ std::shared_ptr<T> estimate_hc(OperatorSet& op_set,
     op_set.set_type_blacklist(type_blacklist);
     op_set.set_type_whitelist(type_whitelist);
     op_set.set_max_indegree(max_indegree);
+    op_set.set_num_threads(num_threads);
 
     auto prev_current_model = current_model->clone();
     auto best_model = current_model;
 
-    spinner->update_status("Caching scores...");
-
-    LocalScoreCache local_validation = [&]() {
-        if constexpr (std::is_base_of_v<ValidatedScore, S>) {
-            LocalScoreCache lc(*current_model);
-            lc.cache_vlocal_scores(*current_model, score);
-            return lc;
-        } else if constexpr (std::is_base_of_v<Score, S>) {
-            return LocalScoreCache{};
-        } else {
-            static_assert(util::always_false<S>, "Wrong Score class for hill-climbing.");
-        }
-    }();
-
-    op_set.cache_scores(*current_model, score);
+    LocalScoreCache local_validation;
     int p = 0;
     double accumulated_offset = 0;
 
     OperatorTabuSet tabu_set;
 
-    if (callback) callback->call(*current_model, nullptr, score, 0);
-
     auto iter = 0;
-    while (iter < max_iters) {
-        ++iter;
-
-        auto best_op = [&]() {
-            if constexpr (zero_patience)
-                return op_set.find_max(*current_model);
-            else
-                return op_set.find_max(*current_model, tabu_set);
-        }();
-
-        if (!best_op || (best_op->delta() - epsilon) < util::machine_tol) {
-            break;
-        }
-
-        best_op->apply(*current_model);
+    // True while the operators applied in the current iteration are not validated.
+    bool pending_validation = false;
 
-        auto nodes_changed = best_op->nodes_changed(*current_model);
+    try {
+        spinner->update_status("Caching scores...");
 
-        double validation_delta = [&]() {
+        local_validation = [&]() {
             if constexpr (std::is_base_of_v<ValidatedScore, S>) {
-                return validation_delta_score(*current_model, score, nodes_changed, local_validation);
+                LocalScoreCache lc(*current_model);
+                lc.cache_vlocal_scores(*current_model, budgeted_score);
+                return lc;
+            } else if constexpr (std::is_base_of_v<Score, S>) {
+                return LocalScoreCache{};
             } else {
-                return best_op->delta();
+                static_assert(util::always_false<S>, "Wrong Score class for hill-climbing.");
             }
         }();
 
-        if ((validation_delta + accumulated_offset) > util::machine_tol) {
-            if constexpr (!zero_patience) {
-                if (p > 0) {
-                    best_model = current_model;
-                    p = 0;
-                    accumulated_offset = 0;
+        op_set.cache_scores(*current_model, budgeted_score);
+
+        if (callback) notify(*current_model, nullptr, 0);
+
+        while (iter < max_iters && !budget.exhausted()) {
+            ++iter;
+
+            std::vector<std::shared_ptr<Operator>> best_ops;
+            // Delta of the best operator with the exact score of a ScreeningScore.
+            std::optional<double> confirmed_delta;
+            if (screening) {
+                auto& exact = *screening->exact_score();
+                auto [best_op, exact_delta] =
+                    budget.limited()
+                        ? confirm_screening(
+                              op_set, *current_model, tabu_set, *screening, BudgetedScore(exact, budget))
+                        : confirm_screening(op_set, *current_model, tabu_set, *screening, exact);
+                if (best_op) {
+                    best_ops.push_back(std::move(best_op));
+                    confirmed_delta = exact_delta;
                 }
-
-                tabu_set.clear();
+            } else if (batch_size > 1) {
+                best_ops = op_set.find_max_batch(*current_model, tabu_set, batch_size);
+            } else {
+                auto best_op = [&]() {
+                    if constexpr (zero_patience)
+                        return op_set.find_max(*current_model);
+                    else
+                        return op_set.find_max(*current_model, tabu_set);
+                }();
+
+                if (best_op) best_ops.push_back(std::move(best_op));
             }
-        } else {
-            if constexpr (zero_patience) {
-                best_model = prev_current_model;
+
+            if (best_ops.empty() ||
+                (confirmed_delta.value_or(best_ops.front()->delta()) - epsilon) < util::machine_tol) {
                 break;
+            }
+
+            // The operators of a batch change the local score of disjoint sets of nodes, so their deltas can be added.
+            auto applied = apply_batch(*current_model, best_ops, epsilon);
+            const auto& best_op = applied.front();
+            pending_validation = true;
+
+            std::vector<std::string> nodes_changed;
+            double delta = 0;
+            for (const auto& op : applied) {
+                auto op_nodes = op->nodes_changed(*current_model);
+                nodes_changed.insert(nodes_changed.end(), op_nodes.begin(), op_nodes.end());
+                delta += op->delta();
+            }
+
+            if (confirmed_delta) delta = *confirmed_delta;
+
+            double validation_delta = [&]() {
+                if constexpr (std::is_base_of_v<ValidatedScore, S>) {
+                    return validation_delta_score(*current_model, budgeted_score, nodes_changed, local_validation);
+                } else {
+                    return delta;
+                }
+            }();
+
+            if ((validation_delta + accumulated_offset) > util::machine_tol) {
+                if constexpr (!zero_patience) {
+                    if (p > 0) {
+                        best_model = current_model;
+                        p = 0;
+                        accumulated_offset = 0;
+                    }
+
+                    tabu_set.clear();
+                }
             } else {
-                if (p == 0) best_model = prev_current_model->clone();
-                if (++p > patience) break;
-                accumulated_offset += validation_delta;
-                tabu_set.insert(best_op->opposite(*current_model));
+                if constexpr (zero_patience) {
+                    best_model = prev_current_model;
+                    break;
+                } else {
+                    if (p == 0) best_model = prev_current_model->clone();
+                    if (++p > patience) break;
+                    accumulated_offset += validation_delta;
+                    for (const auto& op : applied) {
+                        tabu_set.insert(op->opposite(*current_model), *current_model);
+                    }
+                }
             }
-        }
 
-        best_op->apply(*prev_current_model);
+            pending_validation = false;
 
-        if (callback) callback->call(*current_model, best_op.get(), score, iter);
+            for (const auto& op : applied) {
+                op->apply(*prev_current_model);
+            }
 
-        op_set.update_scores(*current_model, score, nodes_changed);
+            if (callback) {
+                for (const auto& op : applied) {
+                    notify(*current_model, op.get(), iter);
+                }
+            }
 
-        if constexpr (std::is_base_of_v<ValidatedScore, S>) {
-            spinner->update_status(best_op->ToString() + " | Validation delta: " + std::to_string(validation_delta));
-        } else if constexpr (std::is_base_of_v<Score, S>) {
-            spinner->update_status(best_op->ToString());
-        } else {
-            static_assert(util::always_false<S>, "Wrong Score class for hill-climbing.");
+            op_set.update_scores(*current_model, budgeted_score, nodes_changed);
+
+            if constexpr (std::is_base_of_v<ValidatedScore, S>) {
+                spinner->update_status(best_op->ToString() + batch_status(applied) +
+                                       " | Validation delta: " + std::to_string(validation_delta));
+            } else if constexpr (std::is_base_of_v<Score, S>) {
+                spinner->update_status(best_op->ToString() + batch_status(applied));
+            } else {
+                static_assert(util::always_false<S>, "Wrong Score class for hill-climbing.");
+            }
         }
+    } catch (const BudgetExhausted&) {
+        // The operators applied in the last iteration could not be validated, so they are discarded.
+        if (pending_validation && p == 0) best_model = prev_current_model;
     }
 
     op_set.finished();
 
-    if (callback) callback->call(*best_model, nullptr, score, iter);
+    if (callback) notify(*best_model, nullptr, iter);
 
     spinner->mark_as_completed("Finished Hill-climbing!");
     return best_model;
@@ -211,7 +426,11 @@ std::shared_ptr<T> estimate_downcast_score(OperatorSet& op_set,
                                            int max_iters,
                                            double epsilon,
                                            int patience,
-                                           int verbose) {
+                                           int verbose,
+                                           int num_threads = 1,
+                                           int batch_size = 1,
+                                           double max_time = 0,
+                                           int max_score_evaluations = 0) {
     if (auto validated_score = dynamic_cast<ValidatedScore*>(&score)) {
         if (patience == 0) {
             return estimate_hc<true>(op_set,
@@ -226,7 +445,11 @@ std::shared_ptr<T> estimate_downcast_score(OperatorSet& op_set,
                                      max_iters,
                                      epsilon,
                                      patience,
-                                     verbose);
+                                     verbose,
+                                     num_threads,
+                                     batch_size,
+                                     max_time,
+                                     max_score_evaluations);
         } else {
             return estimate_hc<false>(op_set,
                                       *validated_score,
@@ -240,7 +463,11 @@ std::shared_ptr<T> estimate_downcast_score(OperatorSet& op_set,
                                       max_iters,
                                       epsilon,
                                       patience,
-                                      verbose);
+                                      verbose,
+                                      num_threads,
+                                      batch_size,
+                                      max_time,
+                                      max_score_evaluations);
         }
     } else {
         if (patience == 0) {
@@ -256,7 +483,11 @@ std::shared_ptr<T> estimate_downcast_score(OperatorSet& op_set,
                                      max_iters,
                                      epsilon,
                                      patience,
-                                     verbose);
+                                     verbose,
+                                     num_threads,
+                                     batch_size,
+                                     max_time,
+                                     max_score_evaluations);
         } else {
             return estimate_hc<false>(op_set,
                                       score,
@@ -270,7 +501,11 @@ std::shared_ptr<T> estimate_downcast_score(OperatorSet& op_set,
                                       max_iters,
                                       epsilon,
                                       patience,
-                                      verbose);
+                                      verbose,
+                                      num_threads,
+                                      batch_size,
+                                      max_time,
+                                      max_score_evaluations);
         }
     }
 }
@@ -288,7 +523,11 @@ std::shared_ptr<T> estimate_checks(OperatorSet& op_set,
                                    int max_iters,
                                    double epsilon,
                                    int patience,
-                                   int verbose) {
+                                   int verbose,
+                                   int num_threads = 1,
+                                   int batch_size = 1,
+                                   double max_time = 0,
+                                   int max_score_evaluations = 0) {
     if (!score.compatible_bn(start)) {
         throw std::invalid_argument("BayesianNetwork is not compatible with the score.");
     }
@@ -308,7 +547,11 @@ std::shared_ptr<T> estimate_checks(OperatorSet& op_set,
                                    max_iters,
                                    epsilon,
                                    patience,
-                                   verbose);
+                                   verbose,
+                                   num_threads,
+                                   batch_size,
+                                   max_time,
+                                   max_score_evaluations);
 }
 
 class GreedyHillClimbing {
@@ -326,7 +569,11 @@ public:
                                 int max_iters,
                                 double epsilon,
                                 int patience,
-                                int verbose = 0) {
+                                int verbose = 0,
+                                int num_threads = 1,
+                                int batch_size = 1,
+                                double max_time = 0,
+                                int max_score_evaluations = 0) {
         return estimate_checks(op_set,
                                score,
                                start,
@@ -339,7 +586,11 @@ public:
                                max_iters,
                                epsilon,
                                patience,
-                               verbose);
+                               verbose,
+                               num_threads,
+                               batch_size,
+                               max_time,
+                               max_score_evaluations);
     }
 };
 
@@ -90,7 +90,8 @@ std::shared_ptr<BayesianNetworkBase> MMHC::estimate(const IndependenceTest& test
                                                     double epsilon,
                                                     int patience,
                                                     double alpha,
-                                                    int verbose) {
+                                                    int verbose,
+                                                    int num_threads) {
     PartiallyDirectedGraph skeleton;
     std::shared_ptr<BayesianNetworkBase> bn;
     if (nodes.empty()) {
@@ -121,6 +122,7 @@ std::shared_ptr<BayesianNetworkBase> MMHC::estimate(const IndependenceTest& test
                                    restrictions.arc_whitelist,
                                    restrictions.edge_blacklist,
                                    restrictions.edge_whitelist,
+                                   num_threads,
                                    *progress);
 
     remove_asymmetries(cpcs);
@@ -146,7 +148,8 @@ std::shared_ptr<BayesianNetworkBase> MMHC::estimate(const IndependenceTest& test
                                                          max_iters,
                                                          epsilon,
                                                          patience,
-                                                         verbose);
+                                                         verbose,
+                                                         num_threads);
 }
 
 std::shared_ptr<ConditionalBayesianNetworkBase> MMHC::estimate_conditional(
@@ -168,7 +171,8 @@ std::shared_ptr<ConditionalBayesianNetworkBase> MMHC::estimate_conditional(
     double epsilon,
     int patience,
     double alpha,
-    int verbose) {
+    int verbose,
+    int num_threads) {
     if (nodes.empty())
         throw std::invalid_argument("Node list cannot be empty to train a Conditional Bayesian network.");
     if (interface_nodes.empty())
@@ -189,7 +193,8 @@ std::shared_ptr<ConditionalBayesianNetworkBase> MMHC::estimate_conditional(
                               epsilon,
                               patience,
                               alpha,
-                              verbose)
+                              verbose,
+                              num_threads)
             ->conditional_bn();
 
     if (!test.has_variables(nodes) || !test.has_variables(interface_nodes))
@@ -217,6 +222,7 @@ std::shared_ptr<ConditionalBayesianNetworkBase> MMHC::estimate_conditional(
                                    restrictions.arc_whitelist,
                                    restrictions.edge_blacklist,
                                    restrictions.edge_whitelist,
+                                   num_threads,
                                    *progress);
     remove_asymmetries(cpcs);
     auto hc_blacklist = create_conditional_hc_blacklist(*bn, cpcs);
@@ -241,7 +247,8 @@ std::shared_ptr<ConditionalBayesianNetworkBase> MMHC::estimate_conditional(
                                                          max_iters,
                                                          epsilon,
                                                          patience,
-                                                         verbose);
+                                                         verbose,
+                                                         num_threads);
 }
 
 }  // namespace learning::algorithms
\ No newline at end of file
@@ -32,7 +32,8 @@ public:
                                                   double epsilon,
                                                   int patience,
                                                   double alpha,
-                                                  int verbose = 0);
+                                                  int verbose = 0,
+                                                  int num_threads = 1);
 
     std::shared_ptr<ConditionalBayesianNetworkBase> estimate_conditional(
         const IndependenceTest& test,
@@ -53,7 +54,8 @@ public:
         double epsilon,
         int patience,
         double alpha,
-        int verbose = 0);
+        int verbose = 0,
+        int num_threads = 1);
 };
 
 }  // namespace learning::algorithms
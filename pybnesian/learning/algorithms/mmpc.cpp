@@ -353,6 +353,36 @@ private:
 template <typename G>
 BNCPCAssoc(const G&, double) -> BNCPCAssoc<G>;
 
+// Candidates of a forward phase step. The tests of all the candidates with the same conditioning set are computed with
+// IndependenceTest::pvalues(), so the test can share the work on the conditioning set.
+template <typename G>
+struct CPCCandidates {
+    CPCCandidates(const G& g, const std::unordered_set<int>& to_be_checked)
+        : indices(to_be_checked.begin(), to_be_checked.end()), names() {
+        names.reserve(indices.size());
+        for (auto v : indices) {
+            names.push_back(g.name(v));
+        }
+    }
+
+    std::vector<int> indices;
+    std::vector<std::string> names;
+};
+
+// Sets the maxmin association to the minimum association of the candidates. The association of a candidate can grow
+// after it was compared with the maxmin association, so it is computed when all the tests of the step are finished.
+template <typename ColAssoc>
+void find_maxmin_assoc(ColAssoc& assoc, const std::vector<int>& candidates) {
+    assoc.reset_maxmin();
+
+    for (auto v : candidates) {
+        if (assoc.min_assoc(v) < assoc.maxmin_assoc()) {
+            assoc.maxmin_assoc() = assoc.min_assoc(v);
+            assoc.maxmin_index() = v;
+        }
+    }
+}
+
 template <typename G, typename ColAssoc>
 void recompute_assoc(const IndependenceTest& test,
                      const G& g,
@@ -372,13 +402,15 @@ void recompute_assoc(const IndependenceTest& test,
         cpc_vec.push_back(g.name(c));
     }
 
-    assoc.reset_maxmin();
+    CPCCandidates candidates(g, to_be_checked);
+    auto pvalues = test.pvalues(variable_name, candidates.names, cpc_vec);
 
-    for (auto it = to_be_checked.begin(); it != to_be_checked.end();) {
-        double pvalue = test.pvalue(variable_name, g.name(*it), cpc_vec);
-        assoc.initialize_assoc(*it, pvalue);
-        progress.tick();
+    assoc.reset_maxmin();
+    for (int i = 0, size = candidates.indices.size(); i < size; ++i) {
+        assoc.initialize_assoc(candidates.indices[i], pvalues[i]);
     }
+
+    progress.set_progress(to_be_checked.size());
 }
 
 template <typename G, typename ColAssoc>
@@ -392,31 +424,30 @@ void update_min_assoc(const IndependenceTest& test,
                       util::BaseProgressBar& progress) {
     const auto& variable_name = g.name(variable);
 
-    assoc.reset_maxmin();
+    CPCCandidates candidates(g, to_be_checked);
+    auto update_assoc = [&](const std::vector<std::string>& cond) {
+        auto pvalues = test.pvalues(variable_name, candidates.names, cond);
+        for (int i = 0, size = candidates.indices.size(); i < size; ++i) {
+            assoc.update_assoc(candidates.indices[i], pvalues[i]);
+        }
+    };
+
+    progress.set_max_progress(to_be_checked.size());
+    progress.set_progress(0);
 
     if (cpc.empty()) {
         progress.set_text("MMPC Forward: no sepset for " + variable_name);
-        progress.set_max_progress(to_be_checked.size());
-        progress.set_progress(0);
 
-        for (auto v : to_be_checked) {
-            double pvalue = test.pvalue(variable_name, g.name(v));
-            assoc.initialize_assoc(v, pvalue);
-            progress.tick();
+        auto pvalues = test.pvalues(variable_name, candidates.names, {});
+        for (int i = 0, size = candidates.indices.size(); i < size; ++i) {
+            assoc.initialize_assoc(candidates.indices[i], pvalues[i]);
         }
     } else if (cpc.size() == 1) {
         progress.set_text("MMPC Forward: sepset order 1 for " + variable_name);
-        progress.set_max_progress(to_be_checked.size());
-        progress.set_progress(0);
 
-        const auto& last_added_name = g.name(last_added_cpc);
-        for (auto v : to_be_checked) {
-            double pvalue = test.pvalue(variable_name, g.name(v), last_added_name);
-            assoc.update_assoc(v, pvalue);
-            progress.tick();
-        }
+        update_assoc({g.name(last_added_cpc)});
     } else if (cpc.size() == 2) {
-        const auto& last_added_name = g.name(last_added_cpc);
+        progress.set_text("MMPC Forward: sepset order 2 for " + variable_name);
 
         std::vector<std::string> cond;
         cond.reserve(2);
@@ -424,25 +455,10 @@ void update_min_assoc(const IndependenceTest& test,
             cond.push_back(g.name(pc));
         }
 
-        progress.set_text("MMPC Forward: sepset order 2 for " + variable_name);
-        progress.set_max_progress(to_be_checked.size());
-        progress.set_progress(0);
-
-        for (auto v : to_be_checked) {
-            const auto& v_name = g.name(v);
-
-            double pvalue = test.pvalue(variable_name, v_name, last_added_name);
-            assoc.update_assoc(v, pvalue);
-
-            pvalue = test.pvalue(variable_name, v_name, cond);
-            assoc.update_assoc(v, pvalue);
-
-            progress.tick();
-        }
+        update_assoc({g.name(last_added_cpc)});
+        update_assoc(cond);
     } else {
         progress.set_text("MMPC Forward: sepset up to order " + std::to_string(cpc.size()) + " for " + variable_name);
-        progress.set_max_progress(to_be_checked.size());
-        progress.set_progress(0);
 
         const auto& last_added_name = g.name(last_added_cpc);
 
@@ -456,44 +472,32 @@ void update_min_assoc(const IndependenceTest& test,
             }
         }
 
+        // Conditioning in just the last variable added.
+        update_assoc(fixed);
+
+        // Conditioning in the last variable and another variable added.
         std::vector<std::string> cond(2);
         cond[1] = last_added_name;
-
-        // Conditioning in all the subsets of 2 to CPC.size()-1 size, including last variable added.
-        AllSubsets<std::string> comb;
-        if (cpc.size() > 3) {
-            comb = AllSubsets(old_cpc, std::move(fixed), 3, cpc.size() - 1);
+        for (const auto& pc : old_cpc) {
+            cond[0] = pc;
+            update_assoc(cond);
         }
 
-        for (auto v : to_be_checked) {
-            const auto& v_name = g.name(v);
-            // Conditioning in just the last variable added.
-            double pvalue = test.pvalue(variable_name, v_name, last_added_name);
-            assoc.update_assoc(v, pvalue);
-
-            // Conditioning in the last variable and another variable added.
-            for (const auto& pc : old_cpc) {
-                cond[0] = pc;
-                pvalue = test.pvalue(variable_name, v_name, cond);
-                assoc.update_assoc(v, pvalue);
-            }
-
-            if (cpc.size() > 3) {
-                for (const auto& subset : comb) {
-                    pvalue = test.pvalue(variable_name, v_name, subset);
-                    assoc.update_assoc(v, pvalue);
-                }
+        // Conditioning in all the subsets of 3 to CPC.size()-1 size, including last variable added.
+        if (cpc.size() > 3) {
+            AllSubsets comb(old_cpc, std::move(fixed), 3, cpc.size() - 1);
+            for (const auto& subset : comb) {
+                update_assoc(subset);
             }
-
-            // Conditioning in all the variables.
-            old_cpc.push_back(last_added_name);
-            pvalue = test.pvalue(variable_name, v_name, old_cpc);
-            assoc.update_assoc(v, pvalue);
-            old_cpc.pop_back();
         }
 
-        progress.tick();
+        // Conditioning in all the variables.
+        old_cpc.push_back(last_added_name);
+        update_assoc(old_cpc);
     }
+
+    find_maxmin_assoc(assoc, candidates.indices);
+    progress.set_progress(to_be_checked.size());
 }
 
 template <typename ColAssoc>
@@ -713,27 +717,36 @@ void marginal_cpcs_all_variables(const IndependenceTest& test,
     for (int i = 0, i_end = nnodes - 1; i < i_end; ++i) {
         const auto& i_name = g.collapsed_name(i);
         auto i_index = g.index(i_name);
+
+        std::vector<int> js;
+        std::vector<std::string> j_names;
         for (int j = i + 1; j < nnodes; ++j) {
             const auto& j_name = g.collapsed_name(j);
             auto j_index = g.index(j_name);
             if ((cpcs[i_index].empty() || cpcs[j_index].empty()) && edge_blacklist.count({i_index, j_index}) == 0) {
-                double pvalue = test.pvalue(i_name, j_name);
-                if (pvalue < alpha) {
-                    if (cpcs[i_index].empty()) {
-                        assoc.initialize_assoc(j_index, i_index, pvalue);
-                    }
+                js.push_back(j_index);
+                j_names.push_back(j_name);
+            }
+        }
 
-                    if (cpcs[j_index].empty()) {
-                        assoc.initialize_assoc(i_index, j_index, pvalue);
-                    }
-                } else {
-                    to_be_checked[i_index].erase(j_index);
-                    to_be_checked[j_index].erase(i_index);
+        auto pvalues = test.pvalues(i_name, j_names, {});
+        for (int k = 0, size = js.size(); k < size; ++k) {
+            auto j_index = js[k];
+            if (pvalues[k] < alpha) {
+                if (cpcs[i_index].empty()) {
+                    assoc.initialize_assoc(j_index, i_index, pvalues[k]);
                 }
-            }
 
-            progress.tick();
+                if (cpcs[j_index].empty()) {
+                    assoc.initialize_assoc(i_index, j_index, pvalues[k]);
+                }
+            } else {
+                to_be_checked[i_index].erase(j_index);
+                to_be_checked[j_index].erase(i_index);
+            }
         }
+
+        progress.add_progress(nnodes - i - 1);
     }
 }
 
@@ -759,27 +772,35 @@ void marginal_cpcs_all_variables(const IndependenceTest& test,
     // Cache between nodes and interface_nodes
     for (const auto& node : g.nodes()) {
         auto nindex = g.index(node);
+
+        std::vector<int> iindices;
+        std::vector<std::string> inames;
         for (const auto& inode : g.interface_nodes()) {
             auto iindex = g.index(inode);
-
             if ((cpcs[nindex].empty() || cpcs[iindex].empty()) && edge_blacklist.count({nindex, iindex}) == 0) {
-                double pvalue = test.pvalue(node, inode);
-                if (pvalue < alpha) {
-                    if (cpcs[nindex].empty()) {
-                        assoc.initialize_assoc(iindex, nindex, pvalue);
-                    }
+                iindices.push_back(iindex);
+                inames.push_back(inode);
+            }
+        }
 
-                    if (cpcs[iindex].empty()) {
-                        assoc.initialize_assoc(nindex, iindex, pvalue);
-                    }
-                } else {
-                    to_be_checked[nindex].erase(iindex);
-                    to_be_checked[iindex].erase(nindex);
+        auto pvalues = test.pvalues(node, inames, {});
+        for (int k = 0, size = iindices.size(); k < size; ++k) {
+            auto iindex = iindices[k];
+            if (pvalues[k] < alpha) {
+                if (cpcs[nindex].empty()) {
+                    assoc.initialize_assoc(iindex, nindex, pvalues[k]);
                 }
-            }
 
-            progress.tick();
+                if (cpcs[iindex].empty()) {
+                    assoc.initialize_assoc(nindex, iindex, pvalues[k]);
+                }
+            } else {
+                to_be_checked[nindex].erase(iindex);
+                to_be_checked[iindex].erase(nindex);
+            }
         }
+
+        progress.add_progress(inodes);
     }
 }
 
@@ -800,28 +821,31 @@ void univariate_cpcs_all_variables(const IndependenceTest& test,
         if (cpcs[i].size() == 1) {
             int cpc_variable = *cpcs[i].begin();
             const auto& i_name = g.name(i);
-            const auto& cpc_name = g.name(cpc_variable);
-            for (auto it = to_be_checked[i].begin(), end = to_be_checked[i].end(); it != end;) {
-                auto p = *it;
+
+            // A test repeated from both variables (with the same CPC) is only executed for the lowest index.
+            std::vector<int> ps;
+            std::vector<std::string> p_names;
+            std::vector<bool> repeated;
+            for (auto p : to_be_checked[i]) {
                 bool repeated_test =
                     cpcs[p].size() == 1 && cpc_variable == *cpcs[p].begin() && to_be_checked[p].count(i) > 0;
 
                 if (!repeated_test || i < p) {
-                    const auto& p_name = g.name(p);
-                    double pvalue = test.pvalue(i_name, p_name, cpc_name);
+                    ps.push_back(p);
+                    p_names.push_back(g.name(p));
+                    repeated.push_back(repeated_test);
+                }
+            }
 
-                    assoc.update_assoc(p, i, pvalue);
-                    if (assoc.min_assoc(p, i) > alpha)
-                        it = to_be_checked[i].erase(it);
-                    else
-                        ++it;
+            auto pvalues = test.pvalues(i_name, p_names, {g.name(cpc_variable)});
+            for (int k = 0, size = ps.size(); k < size; ++k) {
+                auto p = ps[k];
+                assoc.update_assoc(p, i, pvalues[k]);
+                if (assoc.min_assoc(p, i) > alpha) to_be_checked[i].erase(p);
 
-                    if (repeated_test) {
-                        assoc.update_assoc(i, p, pvalue);
-                        if (assoc.min_assoc(i, p) > alpha) to_be_checked[p].erase(i);
-                    }
-                } else {
-                    ++it;
+                if (repeated[k]) {
+                    assoc.update_assoc(i, p, pvalues[k]);
+                    if (assoc.min_assoc(i, p) > alpha) to_be_checked[p].erase(i);
                 }
             }
         }
@@ -915,6 +939,7 @@ std::vector<std::unordered_set<int>> mmpc_all_variables(const IndependenceTest&
                                                         const ArcSet& arc_whitelist,
                                                         const EdgeSet& edge_blacklist,
                                                         const EdgeSet& edge_whitelist,
+                                                        int num_threads,
                                                         util::BaseProgressBar& progress) {
     auto [cpcs, to_be_checked] = generate_cpcs(g, arc_whitelist, edge_blacklist, edge_whitelist);
 
@@ -938,7 +963,20 @@ std::vector<std::unordered_set<int>> mmpc_all_variables(const IndependenceTest&
     if (!all_finished) {
         univariate_cpcs_all_variables(test, g, num_total_nodes, alpha, cpcs, to_be_checked, assoc, progress);
 
-        for (int i = 0; i < num_total_nodes; ++i) {
+        // The forward and backward phases of a variable only modify its CPC, its set of candidates and its column of
+        // the association matrices, so the variables are processed concurrently. The symmetry of the CPCs is checked
+        // by the caller after all the CPCs are found.
+        num_threads = test_num_threads(num_threads, test);
+
+        util::VoidProgressBar void_progress;
+        util::BaseProgressBar& variable_progress = (num_threads > 1) ? void_progress : progress;
+        if (num_threads > 1) {
+            progress.set_text("MMPC Forward/Backward");
+            progress.set_max_progress(num_total_nodes);
+            progress.set_progress(0);
+        }
+
+        util::parallel_for(0, num_total_nodes, num_threads, [&](int i) {
             auto col_min_assoc = assoc.min_assoc_col(i);
             // The cpc is whitelisted.
             if (cpcs[i].size() > 1) {
@@ -950,16 +988,25 @@ std::vector<std::unordered_set<int>> mmpc_all_variables(const IndependenceTest&
                                    to_be_checked[i],
                                    col_min_assoc,
                                    MMPC_FORWARD_PHASE_RECOMPUTE_ASSOC,
-                                   progress);
+                                   variable_progress);
             } else if (assoc.maxmin_index(i) != MMPC_FORWARD_PHASE_STOP) {
                 cpcs[i].insert(assoc.maxmin_index(i));
                 to_be_checked[i].erase(assoc.maxmin_index(i));
-                mmpc_forward_phase(
-                    test, g, i, alpha, cpcs[i], to_be_checked[i], col_min_assoc, assoc.maxmin_index(i), progress);
+                mmpc_forward_phase(test,
+                                   g,
+                                   i,
+                                   alpha,
+                                   cpcs[i],
+                                   to_be_checked[i],
+                                   col_min_assoc,
+                                   assoc.maxmin_index(i),
+                                   variable_progress);
             }
 
-            mmpc_backward_phase(test, g, i, alpha, cpcs[i], arc_whitelist, edge_whitelist, progress);
-        }
+            mmpc_backward_phase(test, g, i, alpha, cpcs[i], arc_whitelist, edge_whitelist, variable_progress);
+        });
+
+        if (num_threads > 1) progress.set_progress(num_total_nodes);
     }
 
     return cpcs;
@@ -974,8 +1021,10 @@ std::vector<std::unordered_set<int>> mmpc_all_variables(const IndependenceTest&
                                                         const ArcSet& arc_whitelist,
                                                         const EdgeSet& edge_blacklist,
                                                         const EdgeSet& edge_whitelist,
+                                                        int num_threads,
                                                         util::BaseProgressBar& progress) {
-    return mmpc_all_variables(test, g, g.num_nodes(), alpha, arc_whitelist, edge_blacklist, edge_whitelist, progress);
+    return mmpc_all_variables(
+        test, g, g.num_nodes(), alpha, arc_whitelist, edge_blacklist, edge_whitelist, num_threads, progress);
 }
 
 //
@@ -987,9 +1036,10 @@ std::vector<std::unordered_set<int>> mmpc_all_variables(const IndependenceTest&
                                                         const ArcSet& arc_whitelist,
                                                         const EdgeSet& edge_blacklist,
                                                         const EdgeSet& edge_whitelist,
+                                                        int num_threads,
                                                         util::BaseProgressBar& progress) {
     return mmpc_all_variables(
-        test, g, g.num_joint_nodes(), alpha, arc_whitelist, edge_blacklist, edge_whitelist, progress);
+        test, g, g.num_joint_nodes(), alpha, arc_whitelist, edge_blacklist, edge_whitelist, num_threads, progress);
 }
 
 template <typename G>
@@ -1002,7 +1052,8 @@ void estimate(G& skeleton,
               double alpha,
               double ambiguous_threshold,
               bool allow_bidirected,
-              int verbose) {
+              int verbose,
+              int num_threads) {
     auto restrictions =
         util::validate_restrictions(skeleton, varc_blacklist, varc_whitelist, vedge_blacklist, vedge_whitelist);
 
@@ -1018,6 +1069,7 @@ void estimate(G& skeleton,
                                    restrictions.arc_whitelist,
                                    restrictions.edge_blacklist,
                                    restrictions.edge_whitelist,
+                                   num_threads,
                                    *progress);
 
     for (auto i = 0; i < skeleton.num_nodes(); ++i) {
@@ -1079,7 +1131,8 @@ PartiallyDirectedGraph MMPC::estimate(const IndependenceTest& test,
                                       double alpha,
                                       double ambiguous_threshold,
                                       bool allow_bidirected,
-                                      int verbose) const {
+                                      int verbose,
+                                      int num_threads) const {
     if (alpha <= 0 || alpha >= 1) throw std::invalid_argument("alpha must be a number between 0 and 1.");
     if (ambiguous_threshold < 0 || ambiguous_threshold > 1)
         throw std::invalid_argument("ambiguous_threshold must be a number between 0 and 1.");
@@ -1102,7 +1155,8 @@ PartiallyDirectedGraph MMPC::estimate(const IndependenceTest& test,
                                    alpha,
                                    ambiguous_threshold,
                                    allow_bidirected,
-                                   verbose);
+                                   verbose,
+                                   num_threads);
 
     return skeleton;
 }
@@ -1117,7 +1171,8 @@ ConditionalPartiallyDirectedGraph MMPC::estimate_conditional(const IndependenceT
                                                              double alpha,
                                                              double ambiguous_threshold,
                                                              bool allow_bidirected,
-                                                             int verbose) const {
+                                                             int verbose,
+                                                             int num_threads) const {
     if (alpha <= 0 || alpha >= 1) throw std::invalid_argument("alpha must be a number between 0 and 1.");
     if (ambiguous_threshold < 0 || ambiguous_threshold > 1)
         throw std::invalid_argument("ambiguous_threshold must be a number between 0 and 1.");
@@ -1133,7 +1188,8 @@ ConditionalPartiallyDirectedGraph MMPC::estimate_conditional(const IndependenceT
                               alpha,
                               ambiguous_threshold,
                               allow_bidirected,
-                              verbose)
+                              verbose,
+                              num_threads)
             .conditional_graph();
 
     if (!test.has_variables(nodes) || !test.has_variables(interface_nodes))
@@ -1151,7 +1207,8 @@ ConditionalPartiallyDirectedGraph MMPC::estimate_conditional(const IndependenceT
                                    alpha,
                                    ambiguous_threshold,
                                    allow_bidirected,
-                                   verbose);
+                                   verbose,
+                                   num_threads);
     return skeleton;
 }
 
@@ -26,6 +26,7 @@ std::vector<std::unordered_set<int>> mmpc_all_variables(const IndependenceTest&
                                                         const ArcSet& arc_whitelist,
                                                         const EdgeSet& edge_blacklist,
                                                         const EdgeSet& edge_whitelist,
+                                                        int num_threads,
                                                         util::BaseProgressBar& progress);
 
 std::vector<std::unordered_set<int>> mmpc_all_variables(const IndependenceTest& test,
@@ -34,6 +35,7 @@ std::vector<std::unordered_set<int>> mmpc_all_variables(const IndependenceTest&
                                                         const ArcSet& arc_whitelist,
                                                         const EdgeSet& edge_blacklist,
                                                         const EdgeSet& edge_whitelist,
+                                                        int num_threads,
                                                         util::BaseProgressBar& progress);
 
 class MMPC {
@@ -47,7 +49,8 @@ public:
                                     double alpha,
                                     double ambiguous_threshold,
                                     bool allow_bidirected,
-                                    int verbose) const;
+                                    int verbose,
+                                    int num_threads = 1) const;
 
     ConditionalPartiallyDirectedGraph estimate_conditional(const IndependenceTest& test,
                                                            const std::vector<std::string>& nodes,
@@ -59,7 +62,8 @@ public:
                                                            double alpha,
                                                            double ambiguous_threshold,
                                                            bool allow_bidirected,
-                                                           int verbose) const;
+                                                           int verbose,
+                                                           int num_threads = 1) const;
 };
 
 }  // namespace learning::algorithms
@@ -22,10 +22,27 @@ bool max_cardinality(const G& g, int max_cardinality) {
     return true;
 }
 
-template <typename G>
-void remove_edges(G& g, const std::vector<Edge>& edges) {
-    for (auto edge : edges) {
-        g.remove_edge(edge.first, edge.second);
+// Removes the edges in edges_to_test whose independence test (found with find_sepset(edge)) finds a sepset. The tests of
+// a level are run concurrently on the frozen graph, and the edges are removed after all the tests of the level, so the
+// result does not depend on the order of the edges or the number of threads (PC-stable).
+template <typename G, typename FindSepset>
+void filter_level(G& skeleton,
+                  const std::vector<Edge>& edges_to_test,
+                  SepSet& sepset,
+                  int num_threads,
+                  util::BaseProgressBar& progress,
+                  FindSepset&& find_sepset) {
+    std::vector<std::optional<std::pair<std::unordered_set<int>, double>>> results(edges_to_test.size());
+    util::parallel_for(0, static_cast<int>(edges_to_test.size()), num_threads, [&](int i) {
+        results[i] = find_sepset(edges_to_test[i]);
+    });
+
+    for (std::size_t i = 0; i < edges_to_test.size(); ++i) {
+        if (results[i]) {
+            skeleton.remove_edge_unsafe(edges_to_test[i].first, edges_to_test[i].second);
+            sepset.insert(edges_to_test[i], std::move(results[i]->first), results[i]->second);
+        }
+        progress.tick();
     }
 }
 
@@ -35,6 +52,7 @@ void filter_marginal_skeleton(G& skeleton,
                               SepSet& sepset,
                               double alpha,
                               EdgeSet& edge_whitelist,
+                              int num_threads,
                               util::BaseProgressBar& progress) {
     int nnodes = skeleton.num_nodes();
     if constexpr (graph::is_unconditional_graph_v<G>)
@@ -50,18 +68,14 @@ void filter_marginal_skeleton(G& skeleton,
 
     const auto& nodes = skeleton.nodes();
 
+    std::vector<Edge> edges_to_test;
     for (int i = 0; i < nnodes - 1; ++i) {
         auto index = skeleton.index(nodes[i]);
         for (int j = i + 1; j < nnodes; ++j) {
             auto other_index = skeleton.index(nodes[j]);
 
             if (skeleton.has_edge_unsafe(index, other_index) && edge_whitelist.count({index, other_index}) == 0) {
-                double pvalue = test.pvalue(nodes[i], nodes[j]);
-                if (pvalue > alpha) {
-                    skeleton.remove_edge_unsafe(index, other_index);
-                    sepset.insert({index, other_index}, {}, pvalue);
-                }
-                progress.tick();
+                edges_to_test.emplace_back(index, other_index);
             }
         }
     }
@@ -75,17 +89,33 @@ void filter_marginal_skeleton(G& skeleton,
                 auto iindex = skeleton.index(inode);
 
                 if (skeleton.has_edge_unsafe(nindex, iindex) && edge_whitelist.count({nindex, iindex}) == 0) {
-                    double pvalue = test.pvalue(node, inode);
-                    if (pvalue > alpha) {
-                        skeleton.remove_edge_unsafe(nindex, iindex);
-                        sepset.insert({nindex, iindex}, {}, pvalue);
-                    }
-
-                    progress.tick();
+                    edges_to_test.emplace_back(nindex, iindex);
                 }
             }
         }
     }
+
+    filter_level(skeleton,
+                 edges_to_test,
+                 sepset,
+                 num_threads,
+                 progress,
+                 [&](const Edge& edge) -> std::optional<std::pair<std::unordered_set<int>, double>> {
+                     double pvalue = test.pvalue(skeleton.name(edge.first), skeleton.name(edge.second));
+                     if (pvalue > alpha) return std::make_pair(std::unordered_set<int>{}, pvalue);
+                     return {};
+                 });
+}
+
+// Returns the edges of the graph that are not whitelisted.
+template <typename G>
+std::vector<Edge> edges_to_test(const G& g, const EdgeSet& edge_whitelist) {
+    std::vector<Edge> edges;
+    for (const auto& edge : g.edge_indices()) {
+        if (edge_whitelist.count({edge.first, edge.second}) == 0) edges.push_back(edge);
+    }
+
+    return edges;
 }
 
 template <typename G>
@@ -123,25 +153,22 @@ void filter_univariate_skeleton(G& skeleton,
                                 SepSet& sepset,
                                 double alpha,
                                 EdgeSet& edge_whitelist,
+                                int num_threads,
                                 util::BaseProgressBar& progress) {
     progress.set_max_progress(skeleton.num_edges() - edge_whitelist.size());
     progress.set_text("Sepset Order 1");
     progress.set_progress(0);
 
-    std::vector<Edge> edges_to_remove;
-
-    for (const auto& edge : skeleton.edge_indices()) {
-        if (edge_whitelist.count({edge.first, edge.second}) == 0) {
-            auto indep = find_univariate_sepset(skeleton, edge, alpha, test);
-            if (indep) {
-                edges_to_remove.push_back(edge);
-                sepset.insert(edge, {indep->first}, indep->second);
-            }
-            progress.tick();
-        }
-    }
-
-    remove_edges(skeleton, edges_to_remove);
+    filter_level(skeleton,
+                 edges_to_test(skeleton, edge_whitelist),
+                 sepset,
+                 num_threads,
+                 progress,
+                 [&](const Edge& edge) -> std::optional<std::pair<std::unordered_set<int>, double>> {
+                     auto indep = find_univariate_sepset(skeleton, edge, alpha, test);
+                     if (indep) return std::make_pair(std::unordered_set<int>{indep->first}, indep->second);
+                     return {};
+                 });
 }
 
 template <typename G, typename Comb>
@@ -220,42 +247,37 @@ std::optional<std::pair<std::unordered_set<int>, double>> find_multivariate_seps
 }
 
 template <typename G>
-SepSet find_skeleton(
-    G& g, const IndependenceTest& test, double alpha, EdgeSet& edge_whitelist, util::BaseProgressBar& progress) {
+SepSet find_skeleton(G& g,
+                     const IndependenceTest& test,
+                     double alpha,
+                     EdgeSet& edge_whitelist,
+                     int num_threads,
+                     util::BaseProgressBar& progress) {
     if (static_cast<size_t>(g.num_edges()) == edge_whitelist.size()) {
         return SepSet{};
     }
 
+    num_threads = test_num_threads(num_threads, test);
     SepSet sepset;
 
-    filter_marginal_skeleton(g, test, sepset, alpha, edge_whitelist, progress);
+    filter_marginal_skeleton(g, test, sepset, alpha, edge_whitelist, num_threads, progress);
 
     if (static_cast<size_t>(g.num_edges()) == edge_whitelist.size() || max_cardinality(g, 1)) {
         return sepset;
     }
 
-    filter_univariate_skeleton(g, test, sepset, alpha, edge_whitelist, progress);
+    filter_univariate_skeleton(g, test, sepset, alpha, edge_whitelist, num_threads, progress);
 
-    std::vector<Edge> edges_to_remove;
     auto limit = 2;
     while (static_cast<size_t>(g.num_edges()) > edge_whitelist.size() && !max_cardinality(g, limit)) {
         progress.set_max_progress(g.num_edges() - edge_whitelist.size());
         progress.set_text("Sepset Order " + std::to_string(limit));
         progress.set_progress(0);
 
-        for (auto& edge : g.edge_indices()) {
-            if (edge_whitelist.count({edge.first, edge.second}) == 0) {
-                auto indep = find_multivariate_sepset(g, edge, limit, test, alpha);
-                if (indep) {
-                    edges_to_remove.push_back(edge);
-                    sepset.insert(edge, std::move(indep->first), indep->second);
-                }
-                progress.tick();
-            }
-        }
+        filter_level(g, edges_to_test(g, edge_whitelist), sepset, num_threads, progress, [&](const Edge& edge) {
+            return find_multivariate_sepset(g, edge, limit, test, alpha);
+        });
 
-        remove_edges(g, edges_to_remove);
-        edges_to_remove.clear();
         ++limit;
     }
 
@@ -273,7 +295,8 @@ void estimate(G& skeleton,
               bool use_sepsets,
               double ambiguous_threshold,
               bool allow_bidirected,
-              int verbose) {
+              int verbose,
+              int num_threads) {
     auto restrictions =
         util::validate_restrictions(skeleton, varc_blacklist, varc_whitelist, vedge_blacklist, vedge_whitelist);
 
@@ -297,7 +320,7 @@ void estimate(G& skeleton,
     }
 
     auto progress = util::progress_bar(verbose);
-    auto sepset = find_skeleton(skeleton, test, alpha, restrictions.edge_whitelist, *progress);
+    auto sepset = find_skeleton(skeleton, test, alpha, restrictions.edge_whitelist, num_threads, *progress);
 
     if constexpr (graph::is_conditional_graph_v<G>) {
         skeleton.direct_interface_edges();
@@ -345,7 +368,8 @@ PartiallyDirectedGraph PC::estimate(const IndependenceTest& test,
                                     bool use_sepsets,
                                     double ambiguous_threshold,
                                     bool allow_bidirected,
-                                    int verbose) const {
+                                    int verbose,
+                                    int num_threads) const {
     if (alpha <= 0 || alpha >= 1) throw std::invalid_argument("alpha must be a number between 0 and 1.");
     if (ambiguous_threshold < 0 || ambiguous_threshold > 1)
         throw std::invalid_argument("ambiguous_threshold must be a number between 0 and 1.");
@@ -370,7 +394,8 @@ PartiallyDirectedGraph PC::estimate(const IndependenceTest& test,
                                    use_sepsets,
                                    ambiguous_threshold,
                                    allow_bidirected,
-                                   verbose);
+                                   verbose,
+                                   num_threads);
     return skeleton;
 }
 
@@ -385,7 +410,8 @@ ConditionalPartiallyDirectedGraph PC::estimate_conditional(const IndependenceTes
                                                            bool use_sepsets,
                                                            double ambiguous_threshold,
                                                            bool allow_bidirected,
-                                                           int verbose) const {
+                                                           int verbose,
+                                                           int num_threads) const {
     if (alpha <= 0 || alpha >= 1) throw std::invalid_argument("alpha must be a number between 0 and 1.");
     if (ambiguous_threshold < 0 || ambiguous_threshold > 1)
         throw std::invalid_argument("ambiguous_threshold must be a number between 0 and 1.");
@@ -402,7 +428,8 @@ ConditionalPartiallyDirectedGraph PC::estimate_conditional(const IndependenceTes
                             use_sepsets,
                             ambiguous_threshold,
                             allow_bidirected,
-                            verbose)
+                            verbose,
+                            num_threads)
             .conditional_graph();
 
     if (!test.has_variables(nodes) || !test.has_variables(interface_nodes))
@@ -421,7 +448,8 @@ ConditionalPartiallyDirectedGraph PC::estimate_conditional(const IndependenceTes
                                    use_sepsets,
                                    ambiguous_threshold,
                                    allow_bidirected,
-                                   verbose);
+                                   verbose,
+                                   num_threads);
     return skeleton;
 }
 
@@ -22,7 +22,8 @@ public:
                                     bool use_sepsets,
                                     double ambiguous_threshold,
                                     bool allow_bidirected,
-                                    int verbose) const;
+                                    int verbose,
+                                    int num_threads = 1) const;
 
     ConditionalPartiallyDirectedGraph estimate_conditional(const IndependenceTest& test,
                                                            const std::vector<std::string>& nodes,
@@ -35,7 +36,8 @@ public:
                                                            bool use_sepsets,
                                                            double ambiguous_threshold,
                                                            bool allow_bidirected,
-                                                           int verbose) const;
+                                                           int verbose,
+                                                           int num_threads = 1) const;
 };
 
 }  // namespace learning::algorithms
@@ -0,0 +1,99 @@
+#include <learning/independences/cached_independence.hpp>
+#include <util/hash_utils.hpp>
+
+namespace learning::independences {
+
+std::size_t PValueKeyHash::operator()(const PValueKey& key) const {
+    std::size_t seed = std::hash<std::string>{}(key.x);
+    util::hash_combine(seed, key.y);
+
+    for (const auto& e : key.z) {
+        util::hash_combine(seed, e);
+    }
+
+    return seed;
+}
+
+std::optional<double> PValueMemo::find(const PValueKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_map.find(key);
+    if (it == m_map.end()) {
+        ++m_misses;
+        return std::nullopt;
+    }
+
+    ++m_hits;
+    m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+    return it->second.first;
+}
+
+void PValueMemo::insert(PValueKey&& key, double value) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto [it, inserted] = m_map.try_emplace(std::move(key), value, m_lru.end());
+    if (!inserted) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+        return;
+    }
+
+    m_lru.push_front(&it->first);
+    it->second.second = m_lru.begin();
+
+    if (static_cast<int>(m_map.size()) > m_max_size) {
+        m_map.erase(*m_lru.back());
+        m_lru.pop_back();
+    }
+}
+
+int PValueMemo::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<int>(m_map.size());
+}
+
+long long PValueMemo::hits() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+long long PValueMemo::misses() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+void PValueMemo::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_map.clear();
+    m_lru.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+std::vector<double> CachedIndependenceTest::pvalues(const std::string& v1,
+                                                    const std::vector<std::string>& ys,
+                                                    const std::vector<std::string>& ev) const {
+    std::vector<double> res(ys.size());
+    std::vector<int> missing;
+    std::vector<std::string> missing_ys;
+
+    for (int i = 0, size = ys.size(); i < size; ++i) {
+        if (auto value = m_memo.find(PValueKey(v1, ys[i], ev))) {
+            res[i] = *value;
+        } else {
+            missing.push_back(i);
+            missing_ys.push_back(ys[i]);
+        }
+    }
+
+    if (!missing.empty()) {
+        auto computed = m_test->pvalues(v1, missing_ys, ev);
+        for (int i = 0, size = missing.size(); i < size; ++i) {
+            res[missing[i]] = computed[i];
+            m_memo.insert(PValueKey(v1, missing_ys[i], ev), computed[i]);
+        }
+    }
+
+    return res;
+}
+
+}  // namespace learning::independences
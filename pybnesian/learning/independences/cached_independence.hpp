@@ -0,0 +1,127 @@
+#ifndef PYBNESIAN_LEARNING_INDEPENDENCES_CACHED_INDEPENDENCE_HPP
+#define PYBNESIAN_LEARNING_INDEPENDENCES_CACHED_INDEPENDENCE_HPP
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <learning/independences/independence.hpp>
+
+namespace learning::independences {
+
+// Identifies a test of independence x ⊥ y | z. The tests are symmetric, so x is always the lowest name of the pair, and
+// the conditioning set is sorted.
+struct PValueKey {
+    std::string x;
+    std::string y;
+    std::vector<std::string> z;
+
+    PValueKey(const std::string& v1, const std::string& v2, std::vector<std::string> ev)
+        : x(std::min(v1, v2)), y(std::max(v1, v2)), z(std::move(ev)) {
+        std::sort(z.begin(), z.end());
+    }
+
+    bool operator==(const PValueKey& other) const { return x == other.x && y == other.y && z == other.z; }
+};
+
+struct PValueKeyHash {
+    std::size_t operator()(const PValueKey& key) const;
+};
+
+// Least recently used memo of p-values. All the methods can be called concurrently.
+class PValueMemo {
+public:
+    PValueMemo(int max_size) : m_max_size(max_size), m_map(), m_lru(), m_hits(0), m_misses(0), m_mutex() {
+        if (max_size <= 0) {
+            throw std::invalid_argument("The maximum size of the p-value cache must be positive.");
+        }
+    }
+
+    std::optional<double> find(const PValueKey& key);
+    void insert(PValueKey&& key, double value);
+
+    int max_size() const { return m_max_size; }
+    int size() const;
+    long long hits() const;
+    long long misses() const;
+    void clear();
+
+private:
+    using MapType =
+        std::unordered_map<PValueKey, std::pair<double, std::list<const PValueKey*>::iterator>, PValueKeyHash>;
+
+    int m_max_size;
+    MapType m_map;
+    // Keys of m_map from the most recently used to the least recently used.
+    std::list<const PValueKey*> m_lru;
+    long long m_hits;
+    long long m_misses;
+    mutable std::mutex m_mutex;
+};
+
+// Implements the IndependenceTest interface on top of another test, memoizing its p-values. The memo is kept between
+// calls, so the same object can be reused in many structure learning runs over the same data: the p-values do not
+// depend on the significance level, so running PC or MMPC with many values of alpha only computes each test once.
+//
+// The wrapped test must be symmetric in x and y. A test with a random p-value (e.g. a permutation test) always returns
+// the first p-value computed for each query.
+class CachedIndependenceTest : public IndependenceTest {
+public:
+    CachedIndependenceTest(std::shared_ptr<IndependenceTest> test, int max_size = 100000)
+        : m_test(test), m_memo(max_size) {
+        if (!m_test) {
+            throw std::invalid_argument("The cached independence test cannot be null.");
+        }
+    }
+
+    double pvalue(const std::string& v1, const std::string& v2) const override {
+        return cached(PValueKey(v1, v2, {}), [&]() { return m_test->pvalue(v1, v2); });
+    }
+
+    double pvalue(const std::string& v1, const std::string& v2, const std::string& ev) const override {
+        return cached(PValueKey(v1, v2, {ev}), [&]() { return m_test->pvalue(v1, v2, ev); });
+    }
+
+    double pvalue(const std::string& v1, const std::string& v2, const std::vector<std::string>& ev) const override {
+        return cached(PValueKey(v1, v2, ev), [&]() { return m_test->pvalue(v1, v2, ev); });
+    }
+
+    // The p-values not found in the cache are computed together by the underlying test.
+    std::vector<double> pvalues(const std::string& v1,
+                                const std::vector<std::string>& ys,
+                                const std::vector<std::string>& ev) const override;
+
+    int num_variables() const override { return m_test->num_variables(); }
+    std::vector<std::string> variable_names() const override { return m_test->variable_names(); }
+    const std::string& name(int i) const override { return m_test->name(i); }
+    bool has_variables(const std::string& name) const override { return m_test->has_variables(name); }
+    bool has_variables(const std::vector<std::string>& cols) const override { return m_test->has_variables(cols); }
+    bool is_thread_safe() const override { return m_test->is_thread_safe(); }
+
+    const std::shared_ptr<IndependenceTest>& base_test() const { return m_test; }
+    PValueMemo& memo() { return m_memo; }
+    const PValueMemo& memo() const { return m_memo; }
+
+private:
+    // The p-value is computed without holding the lock, so different threads can compute p-values concurrently. If two
+    // threads compute the same p-value, both store the same value.
+    template <typename F>
+    double cached(PValueKey&& key, F&& compute) const {
+        if (auto value = m_memo.find(key)) {
+            return *value;
+        }
+
+        double value = compute();
+        m_memo.insert(std::move(key), value);
+        return value;
+    }
+
+    std::shared_ptr<IndependenceTest> m_test;
+    mutable PValueMemo m_memo;
+};
+
+}  // namespace learning::independences
+
+#endif  // PYBNESIAN_LEARNING_INDEPENDENCES_CACHED_INDEPENDENCE_HPP
@@ -6,7 +6,7 @@ using boost::math::students_t_distribution;
 
 namespace learning::independences::continuous {
 
-double cor_pvalue(double cor, int df) {
+double cor_pvalue(double cor, int64_t df) {
     double statistic = cor * sqrt(df) / sqrt(1 - cor * cor);
     students_t_distribution tdist(static_cast<double>(df));
     return 2 * cdf(complement(tdist, fabs(statistic)));
@@ -14,7 +14,28 @@ double cor_pvalue(double cor, int df) {
 
 double LinearCorrelation::pvalue_cached(const std::string& v1, const std::string& v2) const {
     double cor = cor_0cond(m_cov, cached_index(v1), cached_index(v2));
-    return cor_pvalue(cor, m_df->num_rows() - 2);
+    return cor_pvalue(cor, m_rows - 2);
+}
+
+double LinearCorrelation::pvalue_patterns(const std::string& v1,
+                                          const std::string& v2,
+                                          const std::vector<std::string>& ev) const {
+    std::vector<int> indices;
+    indices.reserve(ev.size() + 2);
+    indices.push_back(cached_index(v1));
+    indices.push_back(cached_index(v2));
+    for (const auto& e : ev) {
+        indices.push_back(cached_index(e));
+    }
+
+    auto statistics = m_pattern_statistics->complete_statistics(indices);
+    int k = ev.size();
+    // Not enough complete rows to reject the independence.
+    if (statistics.rows() - 2 - k <= 0) return 1;
+
+    MatrixXd cov = statistics.sse() / static_cast<double>(statistics.rows() - 1);
+    double cor = (k == 0) ? cor_0cond(cov, 0, 1) : cor_general(cov);
+    return cor_pvalue(cor, statistics.rows() - 2 - k);
 }
 
 double LinearCorrelation::pvalue_impl(const std::string& v1, const std::string& v2) const {
@@ -42,7 +63,7 @@ double LinearCorrelation::pvalue_impl(const std::string& v1, const std::string&
 
 double LinearCorrelation::pvalue_cached(const std::string& v1, const std::string& v2, const std::string& ev) const {
     double cor = cor_1cond(m_cov, cached_index(v1), cached_index(v2), cached_index(ev));
-    return cor_pvalue(cor, m_df->num_rows() - 3);
+    return cor_pvalue(cor, m_rows - 3);
 }
 
 double LinearCorrelation::pvalue_impl(const std::string& v1, const std::string& v2, const std::string& ev) const {
@@ -91,7 +112,73 @@ double LinearCorrelation::pvalue_cached(const std::string& v1,
     }
 
     double cor = cor_general(cov);
-    return cor_pvalue(cor, m_df->num_rows() - 2 - k);
+    // k includes v1 and v2.
+    return cor_pvalue(cor, m_rows - k);
+}
+
+std::vector<double> LinearCorrelation::pvalues_cached(const std::string& v1,
+                                                      const std::vector<std::string>& ys,
+                                                      const std::vector<std::string>& ev) const {
+    int k = ev.size();
+    int m = ys.size();
+
+    std::vector<int> ev_indices;
+    ev_indices.reserve(k);
+    for (const auto& e : ev) {
+        ev_indices.push_back(cached_index(e));
+    }
+
+    MatrixXd cov_ev(k, k);
+    for (int i = 0; i < k; ++i) {
+        cov_ev(i, i) = m_cov(ev_indices[i], ev_indices[i]);
+        for (int j = i + 1; j < k; ++j) {
+            cov_ev(i, j) = cov_ev(j, i) = m_cov(ev_indices[i], ev_indices[j]);
+        }
+    }
+
+    LLT<MatrixXd> llt(cov_ev);
+    // The pseudo-inverse of each test handles the singular (or almost singular) covariances.
+    if (llt.info() != Eigen::Success ||
+        (llt.matrixLLT().diagonal().array().square() <= util::machine_tol * cov_ev.diagonal().array()).any())
+        return IndependenceTest::pvalues(v1, ys, ev);
+
+    // Column 0 is v1, and column i + 1 is ys[i].
+    std::vector<int> indices;
+    indices.reserve(m + 1);
+    indices.push_back(cached_index(v1));
+    for (const auto& y : ys) {
+        indices.push_back(cached_index(y));
+    }
+
+    MatrixXd cross_cov(k, m + 1);
+    VectorXd var(m + 1);
+    VectorXd cov_v1(m);
+    for (int j = 0; j <= m; ++j) {
+        for (int i = 0; i < k; ++i) {
+            cross_cov(i, j) = m_cov(ev_indices[i], indices[j]);
+        }
+
+        var(j) = m_cov(indices[j], indices[j]);
+        if (j > 0) cov_v1(j - 1) = m_cov(indices[0], indices[j]);
+    }
+
+    // The covariance of a and b given ev is cov(a, b) - w_a^T w_b, where w = L^{-1} cov(ev, ·).
+    MatrixXd w = llt.matrixL().solve(cross_cov);
+    VectorXd partial_var = var - w.colwise().squaredNorm().transpose();
+    VectorXd partial_cov = cov_v1 - w.rightCols(m).transpose() * w.col(0);
+
+    std::vector<double> res;
+    res.reserve(m);
+    for (int i = 0; i < m; ++i) {
+        double cor = 0;
+        if (partial_var(0) >= util::machine_tol && partial_var(i + 1) >= util::machine_tol) {
+            cor = std::clamp(partial_cov(i) / sqrt(partial_var(0) * partial_var(i + 1)), -1., 1.);
+        }
+
+        res.push_back(cor_pvalue(cor, m_rows - 2 - k));
+    }
+
+    return res;
 }
 
 double LinearCorrelation::pvalue_impl(const std::string& v1,
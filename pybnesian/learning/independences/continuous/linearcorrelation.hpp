@@ -4,15 +4,17 @@
 #include <algorithm>
 #include <dataset/dataset.hpp>
 #include <learning/independences/independence.hpp>
+#include <learning/scores/sufficient_statistics.hpp>
 #include <util/math_constants.hpp>
 
 using dataset::DataFrame;
 using Eigen::LLT, Eigen::Ref;
 using learning::independences::IndependenceTest;
+using learning::scores::SufficientStatistics, learning::scores::MissingPatternStatistics;
 
 namespace learning::independences::continuous {
 
-double cor_pvalue(double cor, int df);
+double cor_pvalue(double cor, int64_t df);
 
 template <typename EigenMat>
 double cor_0cond(const EigenMat& cov, int v1, int v2) {
@@ -67,18 +69,27 @@ double cor_general(EigenMatrix& cov) {
 
 class LinearCorrelation : public IndependenceTest {
 public:
-    LinearCorrelation(const DataFrame& df) : m_df(df), m_cached_cov(false), m_indices(), m_cov() {
+    LinearCorrelation(const DataFrame& df)
+        : m_df(df), m_cached_cov(false), m_indices(), m_cov(), m_pattern_statistics(), m_rows(df->num_rows()) {
         auto continuous_indices = df.continuous_columns();
 
         if (continuous_indices.size() < 2) {
             throw std::invalid_argument("DataFrame does not contain enough continuous columns.");
         }
 
-        if (m_df.null_count(continuous_indices) == 0) {
+        for (int i = 0, size = continuous_indices.size(); i < size; ++i) {
+            m_indices.insert(std::make_pair(m_df->column_name(continuous_indices[i]), i));
+        }
+
+        if (m_df.null_count(continuous_indices) > 0) {
+            // The tests use the rows where the tested variables are not null, so they are computed from the statistics
+            // of each missingness pattern. These take O(p²) memory for each pattern, so they are only kept if they fit
+            // in about 32 MB.
+            int p = continuous_indices.size();
+            int max_patterns = std::max(1, (1 << 22) / (p * p));
+            m_pattern_statistics = MissingPatternStatistics::compute(m_df, continuous_indices, max_patterns);
+        } else {
             m_cached_cov = true;
-            for (int i = 0, size = continuous_indices.size(); i < size; ++i) {
-                m_indices.insert(std::make_pair(m_df->column_name(continuous_indices[i]), i));
-            }
             switch (m_df.same_type(continuous_indices)->id()) {
                 case Type::DOUBLE:
                     m_cov = *(m_df.cov<arrow::DoubleType, false>(continuous_indices).release());
@@ -92,9 +103,30 @@ public:
         }
     }
 
+    // Computes the tests from the sufficient statistics of a dataset, without reading the data.
+    LinearCorrelation(const std::shared_ptr<SufficientStatistics>& statistics)
+        : m_df(statistics->data()),
+          m_cached_cov(true),
+          m_indices(statistics->continuous_indices()),
+          m_cov(),
+          m_pattern_statistics(),
+          m_rows(statistics->gaussian_statistics().rows()) {
+        if (m_indices.size() < 2) {
+            throw std::invalid_argument("SufficientStatistics does not contain enough continuous variables.");
+        }
+
+        if (m_rows < 2) {
+            throw std::invalid_argument("SufficientStatistics does not contain enough rows.");
+        }
+
+        m_cov = statistics->gaussian_statistics().sse() / static_cast<double>(m_rows - 1);
+    }
+
     double pvalue(const std::string& v1, const std::string& v2) const override {
         if (m_cached_cov)
             return pvalue_cached(v1, v2);
+        else if (m_pattern_statistics)
+            return pvalue_patterns(v1, v2, {});
         else
             return pvalue_impl(v1, v2);
     }
@@ -102,6 +134,8 @@ public:
     double pvalue(const std::string& v1, const std::string& v2, const std::string& ev) const override {
         if (m_cached_cov)
             return pvalue_cached(v1, v2, ev);
+        else if (m_pattern_statistics)
+            return pvalue_patterns(v1, v2, {ev});
         else
             return pvalue_impl(v1, v2, ev);
     }
@@ -109,10 +143,23 @@ public:
     double pvalue(const std::string& v1, const std::string& v2, const std::vector<std::string>& ev) const override {
         if (m_cached_cov)
             return pvalue_cached(v1, v2, ev);
+        else if (m_pattern_statistics)
+            return pvalue_patterns(v1, v2, ev);
         else
             return pvalue_impl(v1, v2, ev);
     }
 
+    // The tests with conditioning variables share the Cholesky factor of the covariance of the conditioning variables,
+    // so all the partial correlations are computed with a single triangular solve.
+    std::vector<double> pvalues(const std::string& v1,
+                                const std::vector<std::string>& ys,
+                                const std::vector<std::string>& ev) const override {
+        if (m_cached_cov && !ev.empty())
+            return pvalues_cached(v1, ys, ev);
+        else
+            return IndependenceTest::pvalues(v1, ys, ev);
+    }
+
     int num_variables() const override { return m_df->num_columns(); }
 
     std::vector<std::string> variable_names() const override { return m_df.column_names(); }
@@ -122,6 +169,7 @@ public:
     bool has_variables(const std::string& name) const override { return m_df.has_columns(name); }
 
     bool has_variables(const std::vector<std::string>& cols) const override { return m_df.has_columns(cols); }
+    bool is_thread_safe() const override { return true; }
 
 private:
     int cached_index(int v) const {
@@ -143,6 +191,12 @@ private:
     double pvalue_cached(const std::string& v1, const std::string& v2, const std::string& ev) const;
     double pvalue_cached(const std::string& v1, const std::string& v2, const std::vector<std::string>& ev) const;
 
+    std::vector<double> pvalues_cached(const std::string& v1,
+                                       const std::vector<std::string>& ys,
+                                       const std::vector<std::string>& ev) const;
+
+    double pvalue_patterns(const std::string& v1, const std::string& v2, const std::vector<std::string>& ev) const;
+
     double pvalue_impl(const std::string& v1, const std::string& v2) const;
     double pvalue_impl(const std::string& v1, const std::string& v2, const std::string& ev) const;
     double pvalue_impl(const std::string& v1, const std::string& v2, const std::vector<std::string>& ev) const;
@@ -151,6 +205,8 @@ private:
     bool m_cached_cov;
     std::unordered_map<std::string, int> m_indices;
     MatrixXd m_cov;
+    std::optional<MissingPatternStatistics> m_pattern_statistics;
+    int64_t m_rows;
 };
 
 using DynamicLinearCorrelation = DynamicIndependenceTestAdaptator<LinearCorrelation>;
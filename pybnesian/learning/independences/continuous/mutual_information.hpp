@@ -105,6 +105,7 @@ public:
     bool has_variables(const std::string& name) const override { return m_df.has_columns(name); }
 
     bool has_variables(const std::vector<std::string>& cols) const override { return m_df.has_columns(cols); }
+    bool is_thread_safe() const override { return true; }
 
 private:
     DataFrame m_df;
@@ -8,7 +8,7 @@ namespace learning::independences::discrete {
 double ChiSquare::pvalue(const std::string& v1, const std::string& v2) const {
     std::vector<std::string> dummy_v2{v2};
     auto [cardinality, strides] = factors::discrete::create_cardinality_strides(m_df, v1, dummy_v2);
-    auto joint_counts = factors::discrete::joint_counts(m_df, v1, dummy_v2, cardinality, strides);
+    auto joint_counts = this->joint_counts(v1, dummy_v2, cardinality, strides);
 
     auto v1_marg = factors::discrete::marginal_counts(joint_counts, 0, cardinality, strides);
     auto v2_marg = factors::discrete::marginal_counts(joint_counts, 1, cardinality, strides);
@@ -38,7 +38,7 @@ double ChiSquare::pvalue(const std::string& v1, const std::string& v2) const {
 double ChiSquare::pvalue(const std::string& v1, const std::string& v2, const std::string& ev) const {
     std::vector<std::string> dummy_vars{v2, ev};
     auto [cardinality, strides] = factors::discrete::create_cardinality_strides(m_df, v1, dummy_vars);
-    auto joint_counts = factors::discrete::joint_counts(m_df, v1, dummy_vars, cardinality, strides);
+    auto joint_counts = this->joint_counts(v1, dummy_vars, cardinality, strides);
 
     auto evidence_marg = factors::discrete::marginal_counts(joint_counts, 2, cardinality, strides);
 
@@ -84,7 +84,7 @@ double ChiSquare::pvalue(const std::string& v1, const std::string& v2, const std
     dummy_vars.insert(dummy_vars.end(), ev.begin(), ev.end());
 
     auto [cardinality, strides] = factors::discrete::create_cardinality_strides(m_df, v1, dummy_vars);
-    auto joint_counts = factors::discrete::joint_counts(m_df, v1, dummy_vars, cardinality, strides);
+    auto joint_counts = this->joint_counts(v1, dummy_vars, cardinality, strides);
 
     auto evidence_configurations = cardinality.tail(ev.size()).prod();
     auto vars_configurations = cardinality(0) * cardinality(1);
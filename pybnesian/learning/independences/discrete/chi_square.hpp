@@ -1,13 +1,21 @@
 #ifndef PYBNESIAN_LEARNING_INDEPENDENCES_DISCRETE_CHI_SQUARE_HPP
 #define PYBNESIAN_LEARNING_INDEPENDENCES_DISCRETE_CHI_SQUARE_HPP
 
+#include <factors/discrete/contingency_cache.hpp>
 #include <learning/independences/independence.hpp>
+#include <learning/scores/sufficient_statistics.hpp>
+
+using learning::scores::SufficientStatistics;
 
 namespace learning::independences::discrete {
 
 class ChiSquare : public IndependenceTest {
 public:
-    ChiSquare(const DataFrame& df) : m_df(df) {
+    // The discrete counts are computed using num_threads threads.
+    ChiSquare(const DataFrame& df, int num_threads = 1)
+        : m_df(df),
+          m_counts(std::make_shared<factors::discrete::ContingencyTableCache>(df, num_threads)),
+          m_statistics(nullptr) {
         auto discrete_indices = df.discrete_columns();
 
         if (discrete_indices.size() < 2) {
@@ -15,6 +23,14 @@ public:
         }
     }
 
+    // Computes the tests from the sufficient statistics of a dataset, without reading the data.
+    ChiSquare(const std::shared_ptr<SufficientStatistics>& statistics)
+        : m_df(statistics->data()), m_counts(nullptr), m_statistics(statistics) {
+        if (m_df.discrete_columns().size() < 2) {
+            throw std::invalid_argument("SufficientStatistics does not contain enough categorical variables.");
+        }
+    }
+
     double pvalue(const std::string& v1, const std::string& v2) const override;
     double pvalue(const std::string& v1, const std::string& v2, const std::string& ev) const override;
     double pvalue(const std::string& v1, const std::string& v2, const std::vector<std::string>& ev) const override;
@@ -24,9 +40,20 @@ public:
     const std::string& name(int i) const override { return m_df.name(i); }
     bool has_variables(const std::string& name) const override { return m_df.has_columns(name); }
     bool has_variables(const std::vector<std::string>& cols) const override { return m_df.has_columns(cols); }
+    bool is_thread_safe() const override { return true; }
 
 private:
+    VectorXi joint_counts(const std::string& variable,
+                          const std::vector<std::string>& evidence,
+                          const VectorXi& cardinality,
+                          const VectorXi& strides) const {
+        if (m_statistics) return m_statistics->joint_counts(variable, evidence, cardinality, strides);
+        return m_counts->joint_counts(variable, evidence, cardinality, strides);
+    }
+
     const DataFrame m_df;
+    std::shared_ptr<factors::discrete::ContingencyTableCache> m_counts;
+    std::shared_ptr<SufficientStatistics> m_statistics;
 };
 
 using DynamicChiSquare = DynamicIndependenceTestAdaptator<ChiSquare>;
@@ -32,6 +32,7 @@ public:
     const std::string& name(int i) const override { return m_df.name(i); }
     bool has_variables(const std::string& name) const override { return m_df.has_columns(name); }
     bool has_variables(const std::vector<std::string>& cols) const override { return m_df.has_columns(cols); }
+    bool is_thread_safe() const override { return true; }
 
 private:
     double mi_discrete(const std::string& x, const std::string& y) const;
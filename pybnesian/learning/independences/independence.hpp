@@ -22,12 +22,34 @@ public:
     virtual double pvalue(const std::string& v1, const std::string& v2) const = 0;
     virtual double pvalue(const std::string& v1, const std::string& v2, const std::string& ev) const = 0;
     virtual double pvalue(const std::string& v1, const std::string& v2, const std::vector<std::string>& ev) const = 0;
+    // Returns the p-values of the tests v1 ⊥ y | ev for each y in ys. The tests that share the conditioning set can
+    // reuse work between them, so this method should be overridden by the tests that can compute them together.
+    virtual std::vector<double> pvalues(const std::string& v1,
+                                        const std::vector<std::string>& ys,
+                                        const std::vector<std::string>& ev) const {
+        std::vector<double> res;
+        res.reserve(ys.size());
+
+        for (const auto& y : ys) {
+            if (ev.empty())
+                res.push_back(pvalue(v1, y));
+            else if (ev.size() == 1)
+                res.push_back(pvalue(v1, y, ev[0]));
+            else
+                res.push_back(pvalue(v1, y, ev));
+        }
+
+        return res;
+    }
 
     virtual int num_variables() const = 0;
     virtual std::vector<std::string> variable_names() const = 0;
     virtual const std::string& name(int i) const = 0;
     virtual bool has_variables(const std::string& name) const = 0;
     virtual bool has_variables(const std::vector<std::string>& cols) const = 0;
+
+    // Returns true if pvalue() can be called concurrently from many threads without holding the GIL.
+    virtual bool is_thread_safe() const { return false; }
 };
 
 class DynamicIndependenceTest {
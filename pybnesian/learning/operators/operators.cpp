@@ -1,8 +1,11 @@
+#include <numeric>
 #include <models/BayesianNetwork.hpp>
 #include <models/SemiparametricBN.hpp>
 #include <learning/scores/scores.hpp>
 #include <learning/operators/operators.hpp>
 #include <util/validate_whitelists.hpp>
+#include <util/bn_traits.hpp>
+#include <util/parallel.hpp>
 
 using models::BayesianNetworkType, models::SemiparametricBNType;
 
@@ -16,6 +19,60 @@ std::shared_ptr<Operator> AddArc::opposite(const ConditionalBayesianNetworkBase&
     return opposite(static_cast<const BayesianNetworkBase&>(m));
 }
 
+int score_num_threads(int num_threads, const BayesianNetworkBase& model, const Score& score) {
+    if (util::resolve_num_threads(num_threads) == 1 || !score.is_thread_safe() || model.is_python_derived() ||
+        model.type_ref().is_python_derived()) {
+        return 1;
+    }
+
+    for (const auto& node_type : model.node_types()) {
+        if (node_type.second->is_python_derived()) return 1;
+    }
+
+    return util::resolve_num_threads(num_threads);
+}
+
+// Returns the operator that changes the arc between source and target (model indices) with the given delta: RemoveArc
+// if source -> target exists, FlipArc if target -> source exists or AddArc otherwise. Returns nullptr if the operator
+// is not valid in the model or it is in the tabu set.
+template <bool limited_indegree, typename M>
+std::shared_ptr<Operator> valid_arc_operator(const M& model,
+                                             int source_index,
+                                             int target_index,
+                                             double delta,
+                                             int max_indegree,
+                                             const OperatorTabuSet* tabu_set) {
+    const auto& source = model.name(source_index);
+    const auto& target = model.name(target_index);
+
+    if (model.has_arc(source, target))
+        return arc_operator_not_tabu<RemoveArc>(tabu_set, source_index, target_index, source, target, delta);
+
+    if constexpr (limited_indegree) {
+        if (model.num_parents(target) >= max_indegree) return nullptr;
+    }
+
+    bool is_interface = [&model, &source]() {
+        if constexpr (util::is_conditionalbn_v<M>)
+            return model.is_interface(source);
+        else
+            return false;
+    }();
+
+    if (is_interface) {
+        // If source is interface, the arc cannot produce cycles as source cannot have parents.
+        if (model.type_ref().can_have_arc(model, source, target))
+            return arc_operator_not_tabu<AddArc>(tabu_set, source_index, target_index, source, target, delta);
+    } else if (model.has_arc(target, source)) {
+        if (model.can_flip_arc(target, source))
+            return arc_operator_not_tabu<FlipArc>(tabu_set, target_index, source_index, target, source, delta);
+    } else if (model.can_add_arc(source, target)) {
+        return arc_operator_not_tabu<AddArc>(tabu_set, source_index, target_index, source, target, delta);
+    }
+
+    return nullptr;
+}
+
 void ArcOperatorSet::update_valid_ops(const BayesianNetworkBase& model) {
     int num_nodes = model.num_nodes();
 
@@ -56,18 +113,39 @@ void ArcOperatorSet::update_valid_ops(const BayesianNetworkBase& model) {
         delta(i, i) = std::numeric_limits<double>::lowest();
     }
 
-    sorted_idx.clear();
-    sorted_idx.reserve(valid_ops);
+    valid_idx.clear();
+    valid_idx.reserve(valid_ops);
 
     for (int i = 0; i < num_nodes; ++i) {
         for (int j = 0; j < num_nodes; ++j) {
             if (valid_op(i, j)) {
-                sorted_idx.push_back(i + j * num_nodes);
+                valid_idx.push_back(i + j * num_nodes);
             }
         }
     }
 }
 
+// Returns score.local_score(model, variable, parents) - current_score. The score can abandon the evaluation if the
+// delta cannot be greater than -margin (see Score::local_score_bound()). Then, the returned delta is an upper bound
+// lower than -margin, so an abandoned operator is never selected while an operator with positive delta exists.
+double local_score_delta(const BayesianNetworkBase& model,
+                         const Score& score,
+                         const std::string& variable,
+                         const std::vector<std::string>& parents,
+                         double current_score,
+                         double margin = 0) {
+    return score.local_score_bound(model, variable, parents, current_score - margin).value - current_score;
+}
+
+double local_score_delta(const BayesianNetworkBase& model,
+                         const Score& score,
+                         const std::shared_ptr<FactorType>& node_type,
+                         const std::string& variable,
+                         const std::vector<std::string>& parents,
+                         double current_score) {
+    return score.local_score_bound(model, node_type, variable, parents, current_score).value - current_score;
+}
+
 double cache_score_operation(const BayesianNetworkBase& model,
                              const Score& score,
                              const std::string& source,
@@ -77,7 +155,7 @@ double cache_score_operation(const BayesianNetworkBase& model,
                              double target_cached_score) {
     if (model.has_arc(source, target)) {
         util::swap_remove_v(parents_target, source);
-        auto d = score.local_score(model, target, parents_target) - target_cached_score;
+        auto d = local_score_delta(model, score, target, parents_target, target_cached_score);
         parents_target.push_back(source);
         return d;
     } else if (model.has_arc(target, source)) {
@@ -85,13 +163,14 @@ double cache_score_operation(const BayesianNetworkBase& model,
         util::swap_remove_v(new_parents_source, target);
 
         parents_target.push_back(source);
-        double d = score.local_score(model, source, new_parents_source) +
-                   score.local_score(model, target, parents_target) - source_cached_score - target_cached_score;
+        double source_delta = score.local_score(model, source, new_parents_source) - source_cached_score;
+        double d = source_delta +
+                   local_score_delta(model, score, target, parents_target, target_cached_score, source_delta);
         parents_target.pop_back();
         return d;
     } else {
         parents_target.push_back(source);
-        double d = score.local_score(model, target, parents_target) - target_cached_score;
+        double d = local_score_delta(model, score, target, parents_target, target_cached_score);
         parents_target.pop_back();
         return d;
     }
@@ -111,10 +190,13 @@ void ArcOperatorSet::cache_scores(const BayesianNetworkBase& model, const Score&
     update_valid_ops(model);
 
     auto bn_type = model.type();
-    for (const auto& target_node : model.nodes()) {
+    const auto& nodes = model.nodes();
+    // Each column of delta (a target node) is computed by a single thread.
+    util::parallel_for(0, static_cast<int>(nodes.size()), score_num_threads(m_num_threads, model, score), [&](int t) {
+        const auto& target_node = nodes[t];
         std::vector<std::string> new_parents_target = model.parents(target_node);
         int target_collapsed = model.collapsed_index(target_node);
-        for (const auto& source_node : model.nodes()) {
+        for (const auto& source_node : nodes) {
             int source_collapsed = model.collapsed_index(source_node);
             if (valid_op(source_collapsed, target_collapsed) &&
                 bn_type->can_have_arc(model, source_node, target_node)) {
@@ -128,7 +210,9 @@ void ArcOperatorSet::cache_scores(const BayesianNetworkBase& model, const Score&
                                           m_local_cache->local_score(model, target_node));
             }
         }
-    }
+    });
+
+    delta_heap.build(valid_idx, delta.data(), delta.size());
 }
 
 double cache_score_interface(const ConditionalBayesianNetworkBase& model,
@@ -139,12 +223,12 @@ double cache_score_interface(const ConditionalBayesianNetworkBase& model,
                              double target_cached_score) {
     if (model.has_arc(source, target)) {
         util::swap_remove_v(parents_target, source);
-        double d = score.local_score(model, target, parents_target) - target_cached_score;
+        double d = local_score_delta(model, score, target, parents_target, target_cached_score);
         parents_target.push_back(source);
         return d;
     } else {
         parents_target.push_back(source);
-        double d = score.local_score(model, target, parents_target) - target_cached_score;
+        double d = local_score_delta(model, score, target, parents_target, target_cached_score);
         parents_target.pop_back();
         return d;
     }
@@ -198,13 +282,13 @@ void ArcOperatorSet::update_valid_ops(const ConditionalBayesianNetworkBase& mode
         delta(joint_collapsed, i) = std::numeric_limits<double>::lowest();
     }
 
-    sorted_idx.clear();
-    sorted_idx.reserve(valid_ops);
+    valid_idx.clear();
+    valid_idx.reserve(valid_ops);
 
     for (int i = 0; i < total_nodes; ++i) {
         for (int j = 0; j < num_nodes; ++j) {
             if (valid_op(i, j)) {
-                sorted_idx.push_back(i + j * total_nodes);
+                valid_idx.push_back(i + j * total_nodes);
             }
         }
     }
@@ -224,7 +308,10 @@ void ArcOperatorSet::cache_scores(const ConditionalBayesianNetworkBase& model, c
     update_valid_ops(model);
 
     auto bn_type = model.type();
-    for (const auto& target_node : model.nodes()) {
+    const auto& nodes = model.nodes();
+    // Each column of delta (a target node) is computed by a single thread.
+    util::parallel_for(0, static_cast<int>(nodes.size()), score_num_threads(m_num_threads, model, score), [&](int t) {
+        const auto& target_node = nodes[t];
         auto target_collapsed = model.collapsed_index(target_node);
         auto new_parents_target = model.parents(target_node);
 
@@ -252,7 +339,9 @@ void ArcOperatorSet::cache_scores(const ConditionalBayesianNetworkBase& model, c
                 }
             }
         }
-    }
+    });
+
+    delta_heap.build(valid_idx, delta.data(), delta.size());
 }
 
 std::shared_ptr<Operator> ArcOperatorSet::find_max(const BayesianNetworkBase& model) const {
@@ -293,34 +382,103 @@ std::shared_ptr<Operator> ArcOperatorSet::find_max(const ConditionalBayesianNetw
         return find_max_indegree<false>(model, tabu_set);
 }
 
+template <bool limited_indegree, typename M>
+std::vector<std::shared_ptr<Operator>> ArcOperatorSet::find_max_batch_indegree(const M& model,
+                                                                               const OperatorTabuSet* tabu_set,
+                                                                               int max_operators) const {
+    auto num_sources = static_cast<int>(delta.rows());
+
+    OperatorBatch batch(max_operators);
+    for (auto it = delta_heap.descending(); !it.end() && !batch.full(); ++it) {
+        auto idx = *it;
+        auto source_collapsed = idx % num_sources;
+        auto target_collapsed = idx / num_sources;
+
+        auto d = delta(source_collapsed, target_collapsed);
+        if (!batch.empty() && d <= 0) break;
+        if (batch.changes(model.collapsed_name(target_collapsed))) continue;
+
+        auto source_index = [&model, source_collapsed]() {
+            if constexpr (util::is_conditionalbn_v<M>)
+                return model.index_from_joint_collapsed(source_collapsed);
+            else
+                return model.index_from_collapsed(source_collapsed);
+        }();
+        auto target_index = model.index_from_collapsed(target_collapsed);
+
+        auto op = valid_arc_operator<limited_indegree>(model, source_index, target_index, d, max_indegree, tabu_set);
+        if (op) batch.insert(model, std::move(op));
+    }
+
+    return std::move(batch.operators());
+}
+
+std::vector<std::shared_ptr<Operator>> ArcOperatorSet::find_max_batch(const BayesianNetworkBase& model,
+                                                                      const OperatorTabuSet& tabu_set,
+                                                                      int max_operators) const {
+    raise_uninitialized();
+
+    auto tabu = tabu_set.empty() ? nullptr : &tabu_set;
+    if (max_indegree > 0)
+        return find_max_batch_indegree<true>(model, tabu, max_operators);
+    else
+        return find_max_batch_indegree<false>(model, tabu, max_operators);
+}
+
+std::vector<std::shared_ptr<Operator>> ArcOperatorSet::find_max_batch(const ConditionalBayesianNetworkBase& model,
+                                                                      const OperatorTabuSet& tabu_set,
+                                                                      int max_operators) const {
+    raise_uninitialized();
+
+    auto tabu = tabu_set.empty() ? nullptr : &tabu_set;
+    if (max_indegree > 0)
+        return find_max_batch_indegree<true>(model, tabu, max_operators);
+    else
+        return find_max_batch_indegree<false>(model, tabu, max_operators);
+}
+
 void ArcOperatorSet::update_incoming_arcs_scores(const BayesianNetworkBase& model,
                                                  const Score& score,
-                                                 const std::string& target_node) {
+                                                 const std::string& target_node,
+                                                 int num_threads) {
     auto target_collapsed = model.collapsed_index(target_node);
-    auto parents = model.parents(target_node);
 
     auto bn_type = model.type();
-    for (const auto& source_node : model.nodes()) {
+    const auto& nodes = model.nodes();
+    // Each source only writes delta(source, target) and delta(target, source), so the sources can be processed by
+    // different threads.
+    util::parallel_for(0, static_cast<int>(nodes.size()), num_threads, [&](int s) {
+        const auto& source_node = nodes[s];
         auto source_collapsed = model.collapsed_index(source_node);
 
         if (valid_op(source_collapsed, target_collapsed)) {
+            auto parents = model.parents(target_node);
             if (model.has_arc(source_node, target_node)) {
+                // The flip arc also changes the local score of source_node, so the local score of target_node can only
+                // be abandoned if neither the remove arc nor the flip arc improve the score.
+                bool valid_flip = valid_op(target_collapsed, source_collapsed) &&
+                                  bn_type->can_have_arc(model, target_node, source_node);
+                double source_delta = 0;
+                if (valid_flip) {
+                    auto parents_source = model.parents(source_node);
+                    parents_source.push_back(target_node);
+                    source_delta = score.local_score(model, source_node, parents_source) -
+                                   this->m_local_cache->local_score(model, source_node);
+                }
+
                 // Update remove arc: source_node -> target_node
                 util::swap_remove_v(parents, source_node);
-                double d = score.local_score(model, target_node, parents) -
-                           this->m_local_cache->local_score(model, target_node);
+                double d = local_score_delta(model,
+                                             score,
+                                             target_node,
+                                             parents,
+                                             this->m_local_cache->local_score(model, target_node),
+                                             std::max(0., source_delta));
                 parents.push_back(source_node);
                 delta(source_collapsed, target_collapsed) = d;
 
                 // Update flip arc: source_node -> target_node
-                if (valid_op(target_collapsed, source_collapsed) &&
-                    bn_type->can_have_arc(model, target_node, source_node)) {
-                    auto parents_source = model.parents(source_node);
-                    parents_source.push_back(target_node);
-                    delta(target_collapsed, source_collapsed) = d +
-                                                                score.local_score(model, source_node, parents_source) -
-                                                                this->m_local_cache->local_score(model, source_node);
-                }
+                if (valid_flip) delta(target_collapsed, source_collapsed) = d + source_delta;
             } else if (model.has_arc(target_node, source_node) &&
                        bn_type->can_have_arc(model, source_node, target_node)) {
                 // Update flip arc: target_node -> source_node
@@ -328,22 +486,26 @@ void ArcOperatorSet::update_incoming_arcs_scores(const BayesianNetworkBase& mode
                 util::swap_remove_v(parents_source, target_node);
 
                 parents.push_back(source_node);
-                double d = score.local_score(model, source_node, parents_source) +
-                           score.local_score(model, target_node, parents) -
-                           this->m_local_cache->local_score(model, source_node) -
-                           this->m_local_cache->local_score(model, target_node);
+                double source_delta = score.local_score(model, source_node, parents_source) -
+                                      this->m_local_cache->local_score(model, source_node);
+                double d = source_delta + local_score_delta(model,
+                                                            score,
+                                                            target_node,
+                                                            parents,
+                                                            this->m_local_cache->local_score(model, target_node),
+                                                            source_delta);
                 parents.pop_back();
                 delta(source_collapsed, target_collapsed) = d;
             } else if (bn_type->can_have_arc(model, source_node, target_node)) {
                 // Update add arc: source_node -> target_node
                 parents.push_back(source_node);
-                double d = score.local_score(model, target_node, parents) -
-                           this->m_local_cache->local_score(model, target_node);
+                double d = local_score_delta(
+                    model, score, target_node, parents, this->m_local_cache->local_score(model, target_node));
                 parents.pop_back();
                 delta(source_collapsed, target_collapsed) = d;
             }
         }
-    }
+    });
 }
 
 void ArcOperatorSet::update_scores(const BayesianNetworkBase& model,
@@ -351,50 +513,75 @@ void ArcOperatorSet::update_scores(const BayesianNetworkBase& model,
                                    const std::vector<std::string>& variables) {
     raise_uninitialized();
 
+    auto num_threads = score_num_threads(m_num_threads, model, score);
+
     if (owns_local_cache()) {
-        for (const auto& n : variables) {
-            m_local_cache->update_local_score(model, score, n);
-        }
+        util::parallel_for(0, static_cast<int>(variables.size()), num_threads, [&](int i) {
+            m_local_cache->update_local_score(model, score, variables[i]);
+        });
     }
 
+    int num_nodes = model.num_nodes();
     for (const auto& n : variables) {
-        update_incoming_arcs_scores(model, score, n);
+        update_incoming_arcs_scores(model, score, n, num_threads);
+
+        // Only the column and the row of n can change.
+        int collapsed = model.collapsed_index(n);
+        for (int i = 0; i < num_nodes; ++i) {
+            delta_heap.update(i + collapsed * num_nodes);
+            delta_heap.update(collapsed + i * num_nodes);
+        }
     }
 }
 
 void ArcOperatorSet::update_incoming_arcs_scores(const ConditionalBayesianNetworkBase& model,
                                                  const Score& score,
-                                                 const std::string& target_node) {
+                                                 const std::string& target_node,
+                                                 int num_threads) {
     auto target_collapsed = model.collapsed_index(target_node);
-    auto parents = model.parents(target_node);
 
     auto bn_type = model.type();
-    for (const auto& source_node : model.joint_nodes()) {
+    const auto& joint_nodes = model.joint_nodes();
+    // Each source only writes delta(source, target) and delta(target, source), so the sources can be processed by
+    // different threads.
+    util::parallel_for(0, static_cast<int>(joint_nodes.size()), num_threads, [&](int s) {
+        const auto& source_node = joint_nodes[s];
         auto source_joint_collapsed = model.joint_collapsed_index(source_node);
 
         if (valid_op(source_joint_collapsed, target_collapsed)) {
+            auto parents = model.parents(target_node);
             if (model.has_arc(source_node, target_node)) {
+                // The flip arc also changes the local score of source_node, so the local score of target_node can only
+                // be abandoned if neither the remove arc nor the flip arc improve the score.
+                int target_joint_collapsed = model.joint_collapsed_index(target_node);
+                int source_collapsed = -1;
+                bool valid_flip = false;
+                double source_delta = 0;
+                if (!model.is_interface(source_node) && bn_type->can_have_arc(model, target_node, source_node)) {
+                    source_collapsed = model.collapsed_index(source_node);
+                    valid_flip = valid_op(target_joint_collapsed, source_collapsed);
+                }
+
+                if (valid_flip) {
+                    auto parents_source = model.parents(source_node);
+                    parents_source.push_back(target_node);
+                    source_delta = score.local_score(model, source_node, parents_source) -
+                                   this->m_local_cache->local_score(model, source_node);
+                }
+
                 // Update remove arc: source_node -> target_node
                 util::swap_remove_v(parents, source_node);
-                double d = score.local_score(model, target_node, parents) -
-                           this->m_local_cache->local_score(model, target_node);
+                double d = local_score_delta(model,
+                                             score,
+                                             target_node,
+                                             parents,
+                                             this->m_local_cache->local_score(model, target_node),
+                                             std::max(0., source_delta));
                 parents.push_back(source_node);
                 delta(source_joint_collapsed, target_collapsed) = d;
 
-                if (!model.is_interface(source_node) && bn_type->can_have_arc(model, target_node, source_node)) {
-                    // Update flip arc: source_node -> target_node
-                    int target_joint_collapsed = model.joint_collapsed_index(target_node);
-                    int source_collapsed = model.collapsed_index(source_node);
-
-                    if (valid_op(target_joint_collapsed, source_collapsed)) {
-                        auto parents_source = model.parents(source_node);
-                        parents_source.push_back(target_node);
-
-                        delta(target_joint_collapsed, source_collapsed) =
-                            d + score.local_score(model, source_node, parents_source) -
-                            this->m_local_cache->local_score(model, source_node);
-                    }
-                }
+                // Update flip arc: source_node -> target_node
+                if (valid_flip) delta(target_joint_collapsed, source_collapsed) = d + source_delta;
             } else if (!model.is_interface(source_node) && model.has_arc(target_node, source_node) &&
                        bn_type->can_have_arc(model, source_node, target_node)) {
                 // Update flip arc: target_node -> source_node
@@ -402,22 +589,26 @@ void ArcOperatorSet::update_incoming_arcs_scores(const ConditionalBayesianNetwor
                 util::swap_remove_v(parents_source, target_node);
 
                 parents.push_back(source_node);
-                double d = score.local_score(model, source_node, parents_source) +
-                           score.local_score(model, target_node, parents) -
-                           this->m_local_cache->local_score(model, source_node) -
-                           this->m_local_cache->local_score(model, target_node);
+                double source_delta = score.local_score(model, source_node, parents_source) -
+                                      this->m_local_cache->local_score(model, source_node);
+                double d = source_delta + local_score_delta(model,
+                                                            score,
+                                                            target_node,
+                                                            parents,
+                                                            this->m_local_cache->local_score(model, target_node),
+                                                            source_delta);
                 parents.pop_back();
                 delta(source_joint_collapsed, target_collapsed) = d;
             } else if (bn_type->can_have_arc(model, source_node, target_node)) {
                 // Update add arc: source_node -> target_node
                 parents.push_back(source_node);
-                double d = score.local_score(model, target_node, parents) -
-                           this->m_local_cache->local_score(model, target_node);
+                double d = local_score_delta(
+                    model, score, target_node, parents, this->m_local_cache->local_score(model, target_node));
                 parents.pop_back();
                 delta(source_joint_collapsed, target_collapsed) = d;
             }
         }
-    }
+    });
 }
 
 void ArcOperatorSet::update_scores(const ConditionalBayesianNetworkBase& model,
@@ -425,15 +616,327 @@ void ArcOperatorSet::update_scores(const ConditionalBayesianNetworkBase& model,
                                    const std::vector<std::string>& variables) {
     raise_uninitialized();
 
+    auto num_threads = score_num_threads(m_num_threads, model, score);
+
     if (owns_local_cache()) {
-        for (const auto& n : variables) {
-            m_local_cache->update_local_score(model, score, n);
+        util::parallel_for(0, static_cast<int>(variables.size()), num_threads, [&](int i) {
+            m_local_cache->update_local_score(model, score, variables[i]);
+        });
+    }
+
+    int num_nodes = model.num_nodes();
+    int total_nodes = model.num_joint_nodes();
+    for (const auto& n : variables) {
+        update_incoming_arcs_scores(model, score, n, num_threads);
+
+        // Only the column and the row of n can change.
+        int collapsed = model.collapsed_index(n);
+        int joint_collapsed = model.joint_collapsed_index(n);
+        for (int i = 0; i < total_nodes; ++i) {
+            delta_heap.update(i + collapsed * total_nodes);
+        }
+
+        for (int i = 0; i < num_nodes; ++i) {
+            delta_heap.update(joint_collapsed + i * total_nodes);
+        }
+    }
+}
+
+template <typename M>
+void CandidateArcOperatorSet::update_valid_ops(const M& model) {
+    auto restrictions = util::validate_restrictions(model, m_blacklist, m_whitelist);
+
+    for (const auto& candidates : m_candidates) {
+        if (!model.contains_node(candidates.first))
+            throw std::invalid_argument("Node " + candidates.first + " not present in the graph.");
+
+        for (const auto& source : candidates.second) {
+            bool contains_source = [&model, &source]() {
+                if constexpr (util::is_conditionalbn_v<M>)
+                    return model.contains_joint_node(source);
+                else
+                    return model.contains_node(source);
+            }();
+
+            if (!contains_source) throw std::invalid_argument("Node " + source + " not present in the graph.");
         }
     }
 
+    int num_nodes = model.num_nodes();
+    m_source.clear();
+    m_target.clear();
+    m_column.assign(num_nodes + 1, 0);
+    m_row.assign(num_nodes, std::vector<int>());
+
+    std::vector<int> sources;
+    for (int t = 0; t < num_nodes; ++t) {
+        const auto& target = model.collapsed_name(t);
+        int target_index = model.index(target);
+
+        sources.clear();
+        auto it = m_candidates.find(target);
+        if (it != m_candidates.end()) {
+            for (const auto& source : it->second) {
+                sources.push_back(model.index(source));
+            }
+        }
+
+        for (const auto& parent : model.parents(target)) {
+            sources.push_back(model.index(parent));
+        }
+
+        for (const auto& child : model.children(target)) {
+            sources.push_back(model.index(child));
+        }
+
+        std::sort(sources.begin(), sources.end());
+        sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+
+        for (auto source_index : sources) {
+            if (source_index == target_index ||
+                restrictions.arc_blacklist.count(std::make_pair(source_index, target_index)) > 0 ||
+                restrictions.arc_whitelist.count(std::make_pair(source_index, target_index)) > 0 ||
+                restrictions.arc_whitelist.count(std::make_pair(target_index, source_index)) > 0)
+                continue;
+
+            const auto& source = model.name(source_index);
+            bool is_interface = [&model, &source]() {
+                if constexpr (util::is_conditionalbn_v<M>)
+                    return model.is_interface(source);
+                else
+                    return false;
+            }();
+
+            if (!is_interface) {
+                m_row[model.collapsed_index(source)].push_back(m_source.size());
+            }
+
+            m_source.push_back(source_index);
+            m_target.push_back(target_index);
+        }
+
+        m_column[t + 1] = m_source.size();
+    }
+
+    delta = VectorXd(m_source.size());
+    m_is_flip.assign(m_source.size(), false);
+}
+
+template <typename M>
+void CandidateArcOperatorSet::update_delta(const M& model,
+                                           const Score& score,
+                                           int slot,
+                                           std::vector<std::string>& parents_target) {
+    const auto& source = model.name(m_source[slot]);
+    const auto& target = model.name(m_target[slot]);
+
+    m_is_flip[slot] = false;
+    if (!model.type_ref().can_have_arc(model, source, target)) {
+        delta(slot) = std::numeric_limits<double>::lowest();
+        return;
+    }
+
+    if constexpr (util::is_conditionalbn_v<M>) {
+        if (model.is_interface(source)) {
+            delta(slot) = cache_score_interface(
+                model, score, source, target, parents_target, m_local_cache->local_score(model, target));
+            return;
+        }
+    }
+
+    m_is_flip[slot] = model.has_arc(target, source);
+    delta(slot) = cache_score_operation(model,
+                                        score,
+                                        source,
+                                        target,
+                                        parents_target,
+                                        m_local_cache->local_score(model, source),
+                                        m_local_cache->local_score(model, target));
+}
+
+template <typename M>
+void CandidateArcOperatorSet::cache_scores_impl(const M& model, const Score& score) {
+    if (!score.compatible_bn(model)) {
+        throw std::invalid_argument("BayesianNetwork is not compatible with the score.");
+    }
+
+    initialize_local_cache(model);
+
+    if (owns_local_cache()) {
+        this->m_local_cache->cache_local_scores(model, score);
+    }
+
+    update_valid_ops(model);
+
+    // Each target node is computed by a single thread.
+    util::parallel_for(0, model.num_nodes(), score_num_threads(m_num_threads, model, score), [&](int t) {
+        auto parents = model.parents(model.collapsed_name(t));
+        for (int slot = m_column[t]; slot < m_column[t + 1]; ++slot) {
+            update_delta(model, score, slot, parents);
+        }
+    });
+
+    std::vector<int> slots(m_source.size());
+    std::iota(slots.begin(), slots.end(), 0);
+    delta_heap.build(slots, delta.data(), delta.size());
+}
+
+void CandidateArcOperatorSet::cache_scores(const BayesianNetworkBase& model, const Score& score) {
+    cache_scores_impl(model, score);
+}
+
+void CandidateArcOperatorSet::cache_scores(const ConditionalBayesianNetworkBase& model, const Score& score) {
+    cache_scores_impl(model, score);
+}
+
+template <typename M>
+void CandidateArcOperatorSet::update_scores_impl(const M& model,
+                                                 const Score& score,
+                                                 const std::vector<std::string>& variables) {
+    raise_uninitialized();
+
+    auto num_threads = score_num_threads(m_num_threads, model, score);
+
+    if (owns_local_cache()) {
+        util::parallel_for(0, static_cast<int>(variables.size()), num_threads, [&](int i) {
+            m_local_cache->update_local_score(model, score, variables[i]);
+        });
+    }
+
     for (const auto& n : variables) {
-        update_incoming_arcs_scores(model, score, n);
+        int collapsed = model.collapsed_index(n);
+        int begin = m_column[collapsed];
+
+        // Arcs towards n.
+        util::parallel_for(begin, m_column[collapsed + 1], num_threads, [&](int slot) {
+            auto parents = model.parents(n);
+            update_delta(model, score, slot, parents);
+        });
+
+        // Arcs from n only depend on the parents of n if they flip an arc child -> n. A slot that was a flip can
+        // become an arc addition if that arc has been removed.
+        const auto& row = m_row[collapsed];
+        util::parallel_for(0, static_cast<int>(row.size()), num_threads, [&](int i) {
+            auto slot = row[i];
+            const auto& target = model.name(m_target[slot]);
+            if (m_is_flip[slot] || model.has_arc(target, n)) {
+                auto parents = model.parents(target);
+                update_delta(model, score, slot, parents);
+            }
+        });
+
+        for (int slot = begin; slot < m_column[collapsed + 1]; ++slot) {
+            delta_heap.update(slot);
+        }
+
+        for (auto slot : row) {
+            delta_heap.update(slot);
+        }
+    }
+}
+
+void CandidateArcOperatorSet::update_scores(const BayesianNetworkBase& model,
+                                            const Score& score,
+                                            const std::vector<std::string>& variables) {
+    update_scores_impl(model, score, variables);
+}
+
+void CandidateArcOperatorSet::update_scores(const ConditionalBayesianNetworkBase& model,
+                                            const Score& score,
+                                            const std::vector<std::string>& variables) {
+    update_scores_impl(model, score, variables);
+}
+
+template <bool limited_indegree, typename M>
+std::shared_ptr<Operator> CandidateArcOperatorSet::find_max_indegree(const M& model,
+                                                                     const OperatorTabuSet* tabu_set) const {
+    for (auto it = delta_heap.descending(); !it.end(); ++it) {
+        auto slot = *it;
+        auto op = valid_arc_operator<limited_indegree>(
+            model, m_source[slot], m_target[slot], delta(slot), max_indegree, tabu_set);
+        if (op) return op;
     }
+
+    return nullptr;
+}
+
+template <bool limited_indegree, typename M>
+std::vector<std::shared_ptr<Operator>> CandidateArcOperatorSet::find_max_batch_indegree(
+    const M& model, const OperatorTabuSet* tabu_set, int max_operators) const {
+    OperatorBatch batch(max_operators);
+    for (auto it = delta_heap.descending(); !it.end() && !batch.full(); ++it) {
+        auto slot = *it;
+        auto d = delta(slot);
+        if (!batch.empty() && d <= 0) break;
+        if (batch.changes(model.name(m_target[slot]))) continue;
+
+        auto op =
+            valid_arc_operator<limited_indegree>(model, m_source[slot], m_target[slot], d, max_indegree, tabu_set);
+        if (op) batch.insert(model, std::move(op));
+    }
+
+    return std::move(batch.operators());
+}
+
+std::shared_ptr<Operator> CandidateArcOperatorSet::find_max(const BayesianNetworkBase& model) const {
+    raise_uninitialized();
+
+    if (max_indegree > 0)
+        return find_max_indegree<true>(model, nullptr);
+    else
+        return find_max_indegree<false>(model, nullptr);
+}
+
+std::shared_ptr<Operator> CandidateArcOperatorSet::find_max(const BayesianNetworkBase& model,
+                                                            const OperatorTabuSet& tabu_set) const {
+    raise_uninitialized();
+
+    if (max_indegree > 0)
+        return find_max_indegree<true>(model, &tabu_set);
+    else
+        return find_max_indegree<false>(model, &tabu_set);
+}
+
+std::shared_ptr<Operator> CandidateArcOperatorSet::find_max(const ConditionalBayesianNetworkBase& model) const {
+    raise_uninitialized();
+
+    if (max_indegree > 0)
+        return find_max_indegree<true>(model, nullptr);
+    else
+        return find_max_indegree<false>(model, nullptr);
+}
+
+std::shared_ptr<Operator> CandidateArcOperatorSet::find_max(const ConditionalBayesianNetworkBase& model,
+                                                            const OperatorTabuSet& tabu_set) const {
+    raise_uninitialized();
+
+    if (max_indegree > 0)
+        return find_max_indegree<true>(model, &tabu_set);
+    else
+        return find_max_indegree<false>(model, &tabu_set);
+}
+
+std::vector<std::shared_ptr<Operator>> CandidateArcOperatorSet::find_max_batch(const BayesianNetworkBase& model,
+                                                                              const OperatorTabuSet& tabu_set,
+                                                                              int max_operators) const {
+    raise_uninitialized();
+
+    auto tabu = tabu_set.empty() ? nullptr : &tabu_set;
+    if (max_indegree > 0)
+        return find_max_batch_indegree<true>(model, tabu, max_operators);
+    else
+        return find_max_batch_indegree<false>(model, tabu, max_operators);
+}
+
+std::vector<std::shared_ptr<Operator>> CandidateArcOperatorSet::find_max_batch(
+    const ConditionalBayesianNetworkBase& model, const OperatorTabuSet& tabu_set, int max_operators) const {
+    raise_uninitialized();
+
+    auto tabu = tabu_set.empty() ? nullptr : &tabu_set;
+    if (max_indegree > 0)
+        return find_max_batch_indegree<true>(model, tabu, max_operators);
+    else
+        return find_max_batch_indegree<false>(model, tabu, max_operators);
 }
 
 void ChangeNodeTypeSet::cache_scores(const BayesianNetworkBase& model, const Score& score) {
@@ -455,8 +958,12 @@ void ChangeNodeTypeSet::cache_scores(const BayesianNetworkBase& model, const Sco
     update_whitelisted(model);
 
     auto bn_type = model.type();
+    std::vector<std::vector<std::shared_ptr<FactorType>>> alt_node_types(model.num_nodes());
     for (int i = 0; i < model.num_nodes(); ++i) {
-        if (m_is_whitelisted(i)) continue;
+        if (m_is_whitelisted(i)) {
+            delta.emplace_back();
+            continue;
+        }
 
         const auto& collapsed_name = model.collapsed_name(i);
 
@@ -466,28 +973,29 @@ void ChangeNodeTypeSet::cache_scores(const BayesianNetworkBase& model, const Sco
                                         ". Set appropiate node types for the model");
         }
 
-        auto alt_node_types = bn_type->alternative_node_type(model, collapsed_name);
+        alt_node_types[i] = bn_type->alternative_node_type(model, collapsed_name);
+        delta.emplace_back(alt_node_types[i].size());
+    }
 
-        if (alt_node_types.empty()) {
-            delta.emplace_back();
-        } else {
-            delta.emplace_back(alt_node_types.size());
-
-            double current_score = this->m_local_cache->local_score(model, collapsed_name);
-            for (auto k = 0, k_end = static_cast<int>(alt_node_types.size()); k < k_end; ++k) {
-                bool not_blacklisted =
-                    m_type_blacklist.find(std::make_pair(collapsed_name, alt_node_types[k])) == m_type_blacklist.end();
-
-                if (not_blacklisted && bn_type->compatible_node_type(model, collapsed_name, alt_node_types[k])) {
-                    auto parents = model.parents(collapsed_name);
-                    delta.back()(k) =
-                        score.local_score(model, alt_node_types[k], collapsed_name, parents) - current_score;
-                } else {
-                    delta.back()(k) = std::numeric_limits<double>::lowest();
-                }
+    // The alternative node types are found serially, so only the local scores are computed in parallel.
+    util::parallel_for(0, model.num_nodes(), score_num_threads(m_num_threads, model, score), [&](int i) {
+        if (m_is_whitelisted(i)) return;
+
+        const auto& collapsed_name = model.collapsed_name(i);
+        double current_score = this->m_local_cache->local_score(model, collapsed_name);
+        for (auto k = 0, k_end = static_cast<int>(alt_node_types[i].size()); k < k_end; ++k) {
+            const auto& alt_type = alt_node_types[i][k];
+            bool not_blacklisted =
+                m_type_blacklist.find(std::make_pair(collapsed_name, alt_type)) == m_type_blacklist.end();
+
+            if (not_blacklisted && bn_type->compatible_node_type(model, collapsed_name, alt_type)) {
+                auto parents = model.parents(collapsed_name);
+                delta[i](k) = local_score_delta(model, score, alt_type, collapsed_name, parents, current_score);
+            } else {
+                delta[i](k) = std::numeric_limits<double>::lowest();
             }
         }
-    }
+    });
 }
 
 std::shared_ptr<Operator> ChangeNodeTypeSet::find_max(const BayesianNetworkBase& model) const {
@@ -530,11 +1038,16 @@ std::shared_ptr<Operator> ChangeNodeTypeSet::find_max(const BayesianNetworkBase&
     for (auto i = 0, i_end = static_cast<int>(delta.size()); i < i_end; ++i) {
         if (!m_is_whitelisted(i) && delta[i].rows() > 0) {
             const auto& collapsed_name = model.collapsed_name(i);
+            auto index = model.index_from_collapsed(i);
             auto alt_node_types = model.type()->alternative_node_type(model, collapsed_name);
             for (auto k = 0; k < delta[i].rows(); ++k) {
                 if (delta[i](k) > max_score) {
-                    auto op = std::make_shared<ChangeNodeType>(collapsed_name, alt_node_types[k], delta[i](k));
-                    if (!tabu_set.contains(op)) {
+                    OperatorKey key{OperatorKind::ChangeNodeType, index, -1, alt_node_types[k].get()};
+                    auto make_operator = [&]() -> std::shared_ptr<Operator> {
+                        return std::make_shared<ChangeNodeType>(collapsed_name, alt_node_types[k], delta[i](k));
+                    };
+
+                    if (!tabu_set.contains(key, make_operator)) {
                         max_score = delta[i](k);
                         max_node = i;
                         max_type = k;
@@ -554,25 +1067,74 @@ std::shared_ptr<Operator> ChangeNodeTypeSet::find_max(const BayesianNetworkBase&
     }
 }
 
+std::vector<std::shared_ptr<Operator>> ChangeNodeTypeSet::find_max_batch(const BayesianNetworkBase& model,
+                                                                        const OperatorTabuSet& tabu_set,
+                                                                        int max_operators) const {
+    raise_uninitialized();
+
+    // The best node type of each node.
+    std::vector<std::shared_ptr<Operator>> res;
+    for (auto i = 0, i_end = static_cast<int>(delta.size()); i < i_end; ++i) {
+        if (m_is_whitelisted(i) || delta[i].rows() == 0) continue;
+
+        const auto& collapsed_name = model.collapsed_name(i);
+        auto index = model.index_from_collapsed(i);
+        auto alt_node_types = model.type()->alternative_node_type(model, collapsed_name);
+
+        int best_type = -1;
+        for (auto k = 0; k < delta[i].rows(); ++k) {
+            if (delta[i](k) > std::numeric_limits<double>::lowest() &&
+                (best_type == -1 || delta[i](k) > delta[i](best_type))) {
+                OperatorKey key{OperatorKind::ChangeNodeType, index, -1, alt_node_types[k].get()};
+                auto make_operator = [&]() -> std::shared_ptr<Operator> {
+                    return std::make_shared<ChangeNodeType>(collapsed_name, alt_node_types[k], delta[i](k));
+                };
+
+                if (tabu_set.empty() || !tabu_set.contains(key, make_operator)) best_type = k;
+            }
+        }
+
+        if (best_type != -1) {
+            res.push_back(
+                std::make_shared<ChangeNodeType>(collapsed_name, alt_node_types[best_type], delta[i](best_type)));
+        }
+    }
+
+    std::stable_sort(res.begin(), res.end(), [](const auto& a, const auto& b) { return a->delta() > b->delta(); });
+
+    // Only the best operator can have a non-positive delta.
+    auto last = std::find_if(
+        res.begin() + std::min<std::size_t>(1, res.size()), res.end(), [](const auto& op) { return op->delta() <= 0; });
+    res.erase(last, res.end());
+    if (static_cast<int>(res.size()) > max_operators) res.resize(max_operators);
+
+    return res;
+}
+
 void ChangeNodeTypeSet::update_scores(const BayesianNetworkBase& model,
                                       const Score& score,
                                       const std::vector<std::string>& variables) {
     raise_uninitialized();
 
+    auto num_threads = score_num_threads(m_num_threads, model, score);
+
     if (owns_local_cache()) {
-        for (const auto& n : variables) {
-            m_local_cache->update_local_score(model, score, n);
-        }
+        util::parallel_for(0, static_cast<int>(variables.size()), num_threads, [&](int i) {
+            m_local_cache->update_local_score(model, score, variables[i]);
+        });
     }
 
     auto bn_type = model.type();
+    // (collapsed index, alternative node type index) of the local scores to compute.
+    std::vector<std::pair<int, int>> jobs;
+    std::unordered_map<int, std::vector<std::shared_ptr<FactorType>>> alt_types;
     for (const auto& n : variables) {
         auto collapsed_index = model.collapsed_index(n);
 
         if (m_is_whitelisted(collapsed_index)) continue;
 
-        double current_score = this->m_local_cache->local_score(model, n);
-        auto alt_node_types = model.type()->alternative_node_type(model, n);
+        auto& alt_node_types = alt_types[collapsed_index];
+        alt_node_types = model.type()->alternative_node_type(model, n);
 
         if (static_cast<size_t>(delta[collapsed_index].rows()) < alt_node_types.size()) {
             delta[collapsed_index] = VectorXd(alt_node_types.size());
@@ -589,13 +1151,20 @@ void ChangeNodeTypeSet::update_scores(const BayesianNetworkBase& model,
                 m_type_blacklist.find(std::make_pair(n, alt_node_types[k])) == m_type_blacklist.end();
 
             if (bn_type->compatible_node_type(model, n, alt_node_types[k]) && not_blacklisted) {
-                auto parents = model.parents(n);
-                delta[collapsed_index](k) = score.local_score(model, alt_node_types[k], n, parents) - current_score;
+                jobs.emplace_back(collapsed_index, k);
             } else {
                 delta[collapsed_index](k) = std::numeric_limits<double>::lowest();
             }
         }
     }
+
+    util::parallel_for(0, static_cast<int>(jobs.size()), num_threads, [&](int j) {
+        auto [collapsed_index, k] = jobs[j];
+        const auto& n = model.collapsed_name(collapsed_index);
+        auto parents = model.parents(n);
+        delta[collapsed_index](k) = local_score_delta(
+            model, score, alt_types.at(collapsed_index)[k], n, parents, this->m_local_cache->local_score(model, n));
+    });
 }
 
 }  // namespace learning::operators
@@ -1,9 +1,11 @@
 #ifndef PYBNESIAN_LEARNING_OPERATORS_OPERATORS_HPP
 #define PYBNESIAN_LEARNING_OPERATORS_OPERATORS_HPP
 
+#include <optional>
 #include <Eigen/Dense>
 #include <models/BayesianNetwork.hpp>
 #include <learning/scores/scores.hpp>
+#include <util/indexed_max_heap.hpp>
 #include <util/vector.hpp>
 
 using Eigen::MatrixXd, Eigen::VectorXd, Eigen::Matrix, Eigen::Dynamic;
@@ -18,6 +20,34 @@ using util::ArcStringVector, util::FactorTypeVector;
 
 namespace learning::operators {
 
+enum class OperatorKind : std::uint8_t { AddArc, RemoveArc, FlipArc, ChangeNodeType };
+
+// Compact identity of an operator: its kind, the indices of its nodes and the new node type (for ChangeNodeType). It
+// is used to search operators in an OperatorTabuSet without creating them. The node types are compared by value, as
+// equal FactorTypes can be different objects (e.g. Python FactorTypes).
+struct OperatorKey {
+    OperatorKind kind;
+    int source;
+    int target;
+    const FactorType* node_type;
+
+    bool operator==(const OperatorKey& other) const {
+        if (kind != other.kind || source != other.source || target != other.target) return false;
+        if (node_type == other.node_type) return true;
+        return node_type && other.node_type && *node_type == *other.node_type;
+    }
+};
+
+struct OperatorKeyHash {
+    std::size_t operator()(const OperatorKey& key) const {
+        std::size_t seed = static_cast<std::size_t>(key.kind);
+        util::hash_combine(seed, key.source);
+        util::hash_combine(seed, key.target);
+        util::hash_combine(seed, key.node_type ? key.node_type->hash() : 0);
+        return seed;
+    }
+};
+
 class Operator {
 public:
     Operator(double delta) : m_delta(delta) {}
@@ -34,6 +64,10 @@ public:
 
     virtual std::string ToString() const = 0;
 
+    // Returns the OperatorKey of the operator in the model m. Operators without a compact representation (e.g.
+    // Python-derived operators) return std::nullopt.
+    virtual std::optional<OperatorKey> key(const BayesianNetworkBase&) const { return std::nullopt; }
+
     virtual std::size_t hash() const = 0;
     virtual bool operator==(const Operator& a) const = 0;
     bool operator!=(const Operator& a) const { return !(*this == a); }
@@ -90,6 +124,8 @@ class AddArc : public ArcOperator {
 public:
     AddArc(std::string source, std::string target, double delta) : ArcOperator(source, target, delta) {}
 
+    static constexpr OperatorKind kind = OperatorKind::AddArc;
+
     void apply(BayesianNetworkBase& m) const override { m.add_arc_unsafe(this->source(), this->target()); }
 
     std::vector<std::string> nodes_changed(const BayesianNetworkBase&) const override { return {this->target()}; }
@@ -112,6 +148,10 @@ public:
         return seed;
     }
 
+    std::optional<OperatorKey> key(const BayesianNetworkBase& m) const override {
+        return OperatorKey{kind, m.index(this->source()), m.index(this->target()), nullptr};
+    }
+
     bool operator==(const Operator& op) const override { return equal_operator<AddArc>(*this, op); }
 
     bool operator==(const AddArc& other) const {
@@ -123,6 +163,8 @@ class RemoveArc : public ArcOperator {
 public:
     RemoveArc(std::string source, std::string target, double delta) : ArcOperator(source, target, delta) {}
 
+    static constexpr OperatorKind kind = OperatorKind::RemoveArc;
+
     void apply(BayesianNetworkBase& m) const override { m.remove_arc(this->source(), this->target()); }
 
     std::vector<std::string> nodes_changed(const BayesianNetworkBase&) const override { return {this->target()}; }
@@ -151,6 +193,10 @@ public:
         return seed;
     }
 
+    std::optional<OperatorKey> key(const BayesianNetworkBase& m) const override {
+        return OperatorKey{kind, m.index(this->source()), m.index(this->target()), nullptr};
+    }
+
     bool operator==(const Operator& op) const override { return equal_operator<RemoveArc>(*this, op); }
 
     bool operator==(const RemoveArc& other) const {
@@ -162,6 +208,8 @@ class FlipArc : public ArcOperator {
 public:
     FlipArc(std::string source, std::string target, double delta) : ArcOperator(source, target, delta) {}
 
+    static constexpr OperatorKind kind = OperatorKind::FlipArc;
+
     void apply(BayesianNetworkBase& m) const override { m.flip_arc_unsafe(this->source(), this->target()); }
 
     std::vector<std::string> nodes_changed(const BayesianNetworkBase&) const override {
@@ -192,6 +240,10 @@ public:
         return seed;
     }
 
+    std::optional<OperatorKey> key(const BayesianNetworkBase& m) const override {
+        return OperatorKey{kind, m.index(this->source()), m.index(this->target()), nullptr};
+    }
+
     bool operator==(const Operator& op) const override { return equal_operator<FlipArc>(*this, op); }
 
     bool operator==(const FlipArc& other) const {
@@ -232,6 +284,10 @@ public:
         return seed;
     }
 
+    std::optional<OperatorKey> key(const BayesianNetworkBase& m) const override {
+        return OperatorKey{OperatorKind::ChangeNodeType, m.index(m_node), -1, m_new_node_type.get()};
+    }
+
     bool operator==(const Operator& op) const override { return equal_operator<ChangeNodeType>(*this, op); }
 
     bool operator==(const ChangeNodeType& other) const {
@@ -257,39 +313,107 @@ public:
 
 class OperatorTabuSet {
 public:
-    OperatorTabuSet() : m_set() {}
+    OperatorTabuSet() : m_set(), m_keys(), m_num_unkeyed(0) {}
 
-    OperatorTabuSet(const OperatorTabuSet& other) : m_set() {
-        for (const auto& op : other.m_set) {
-            m_set.insert(op);
-        }
+    void insert(const std::shared_ptr<Operator>& op) {
+        if (m_set.insert(op).second) ++m_num_unkeyed;
     }
 
-    OperatorTabuSet& operator=(const OperatorTabuSet& other) {
-        clear();
-        for (const auto& op : other.m_set) {
-            m_set.insert(op);
+    // Inserts op and indexes it with its OperatorKey in the model, so it can be found with contains(key, ...).
+    void insert(const std::shared_ptr<Operator>& op, const BayesianNetworkBase& model) {
+        auto key = op->key(model);
+        if (!key) {
+            insert(op);
+            return;
         }
 
-        return *this;
+        m_set.insert(op);
+        m_keys.insert(*key);
     }
 
-    OperatorTabuSet(OperatorTabuSet&& other) : m_set(std::move(other.m_set)) {}
-    OperatorTabuSet& operator=(OperatorTabuSet&& other) {
-        m_set = std::move(other.m_set);
-        return *this;
+    bool contains(const std::shared_ptr<Operator>& op) const { return m_set.count(op) > 0; }
+
+    // Checks if the operator with the given key is in the set. make_operator() is only called (to create the operator)
+    // if some operators were inserted without a key.
+    template <typename MakeOperator>
+    bool contains(const OperatorKey& key, MakeOperator&& make_operator) const {
+        if (m_keys.count(key) > 0) return true;
+        return m_num_unkeyed > 0 && m_set.count(make_operator()) > 0;
     }
 
-    void insert(const std::shared_ptr<Operator>& op) { m_set.insert(op); }
+    void clear() {
+        m_set.clear();
+        m_keys.clear();
+        m_num_unkeyed = 0;
+    }
 
-    bool contains(const std::shared_ptr<Operator>& op) const { return m_set.count(op) > 0; }
-    void clear() { m_set.clear(); }
     bool empty() const { return m_set.empty(); }
 
 private:
     using SetType = std::unordered_set<std::shared_ptr<Operator>, HashOperator, OperatorPtrEqual>;
 
     SetType m_set;
+    std::unordered_set<OperatorKey, OperatorKeyHash> m_keys;
+    int m_num_unkeyed;
+};
+
+// Creates the arc operator Op(source, target, delta) if it is not in the tabu set (or tabu_set is null). Returns
+// nullptr otherwise. The node indices are used to check the tabu set, so the rejected operators are never created.
+template <typename Op>
+std::shared_ptr<Operator> arc_operator_not_tabu(const OperatorTabuSet* tabu_set,
+                                                int source_index,
+                                                int target_index,
+                                                const std::string& source,
+                                                const std::string& target,
+                                                double delta) {
+    auto make_operator = [&]() -> std::shared_ptr<Operator> { return std::make_shared<Op>(source, target, delta); };
+
+    if (tabu_set && tabu_set->contains(OperatorKey{Op::kind, source_index, target_index, nullptr}, make_operator))
+        return nullptr;
+
+    return make_operator();
+}
+
+// Collects the operators returned by OperatorSet::find_max_batch(). An operator is accepted only if it does not change
+// the local score of the nodes changed by the accepted operators, so the delta of each accepted operator is still exact
+// after applying the rest. The node type of the source of an accepted arc operator cannot be changed either.
+class OperatorBatch {
+public:
+    OperatorBatch(int max_operators)
+        : m_operators(), m_changed(), m_sources(), m_type_changed(), m_max_operators(max_operators) {}
+
+    bool empty() const { return m_operators.empty(); }
+    bool full() const { return static_cast<int>(m_operators.size()) >= m_max_operators; }
+    bool changes(const std::string& node) const { return m_changed.count(node) > 0; }
+
+    template <typename M>
+    bool insert(const M& model, std::shared_ptr<Operator> op) {
+        auto nodes = op->nodes_changed(model);
+        for (const auto& n : nodes) {
+            if (changes(n)) return false;
+        }
+
+        auto arc_op = dynamic_cast<const ArcOperator*>(op.get());
+        if (arc_op && m_type_changed.count(arc_op->source()) > 0) return false;
+        auto type_op = dynamic_cast<const ChangeNodeType*>(op.get());
+        if (type_op && m_sources.count(type_op->node()) > 0) return false;
+
+        m_changed.insert(nodes.begin(), nodes.end());
+        if (arc_op) m_sources.insert(arc_op->source());
+        if (type_op) m_type_changed.insert(type_op->node());
+
+        m_operators.push_back(std::move(op));
+        return true;
+    }
+
+    std::vector<std::shared_ptr<Operator>>& operators() { return m_operators; }
+
+private:
+    std::vector<std::shared_ptr<Operator>> m_operators;
+    std::unordered_set<std::string> m_changed;
+    std::unordered_set<std::string> m_sources;
+    std::unordered_set<std::string> m_type_changed;
+    int m_max_operators;
 };
 
 class LocalScoreCache {
@@ -354,6 +478,25 @@ public:
                                const Score&,
                                const std::vector<std::string>&) = 0;
 
+    // Returns up to max_operators operators sorted by decreasing delta. The first one is the best operator not in the
+    // tabu set (as find_max()). The rest have positive delta and can be applied together with the previous ones (see
+    // OperatorBatch), although the caller must check that they do not create cycles together. The default
+    // implementation only returns the best operator.
+    virtual std::vector<std::shared_ptr<Operator>> find_max_batch(const BayesianNetworkBase& model,
+                                                                  const OperatorTabuSet& tabu_set,
+                                                                  int) const {
+        auto op = tabu_set.empty() ? find_max(model) : find_max(model, tabu_set);
+        if (op) return {op};
+        return {};
+    }
+    virtual std::vector<std::shared_ptr<Operator>> find_max_batch(const ConditionalBayesianNetworkBase& model,
+                                                                  const OperatorTabuSet& tabu_set,
+                                                                  int) const {
+        auto op = tabu_set.empty() ? find_max(model) : find_max(model, tabu_set);
+        if (op) return {op};
+        return {};
+    }
+
     void set_local_score_cache(std::shared_ptr<LocalScoreCache> score_cache) {
         m_local_cache = score_cache;
         m_owns_local_cache = false;
@@ -366,6 +509,7 @@ public:
     virtual void set_max_indegree(int){};
     virtual void set_type_blacklist(const FactorTypeVector&){};
     virtual void set_type_whitelist(const FactorTypeVector&){};
+    virtual void set_num_threads(int){};
     virtual void finished() { m_local_cache = nullptr; }
 
     static std::shared_ptr<OperatorSet>& keep_python_alive(std::shared_ptr<OperatorSet>& op_set) {
@@ -432,12 +576,23 @@ protected:
     bool m_owns_local_cache;
 };
 
+// Returns how many of the num_threads can evaluate local scores of the model concurrently. Python-derived models, node
+// types and scores need the GIL, so they always use a single thread.
+int score_num_threads(int num_threads, const BayesianNetworkBase& model, const Score& score);
+
 class ArcOperatorSet : public OperatorSet {
 public:
     ArcOperatorSet(ArcStringVector blacklist = ArcStringVector(),
                    ArcStringVector whitelist = ArcStringVector(),
                    int indegree = 0)
-        : delta(), valid_op(), sorted_idx(), m_blacklist(blacklist), m_whitelist(whitelist), max_indegree(indegree) {}
+        : delta(),
+          valid_op(),
+          valid_idx(),
+          delta_heap(),
+          m_blacklist(blacklist),
+          m_whitelist(whitelist),
+          max_indegree(indegree),
+          m_num_threads(1) {}
 
     void cache_scores(const BayesianNetworkBase& model, const Score& score) override;
     std::shared_ptr<Operator> find_max(const BayesianNetworkBase& model) const override;
@@ -448,12 +603,18 @@ public:
     template <bool limited_indigree>
     std::shared_ptr<Operator> find_max_indegree(const BayesianNetworkBase& model,
                                                 const OperatorTabuSet& tabu_set) const;
+    std::vector<std::shared_ptr<Operator>> find_max_batch(const BayesianNetworkBase& model,
+                                                          const OperatorTabuSet& tabu_set,
+                                                          int max_operators) const override;
     void update_scores(const BayesianNetworkBase&, const Score&, const std::vector<std::string>&) override;
 
     void cache_scores(const ConditionalBayesianNetworkBase& model, const Score& score) override;
     std::shared_ptr<Operator> find_max(const ConditionalBayesianNetworkBase& model) const override;
     std::shared_ptr<Operator> find_max(const ConditionalBayesianNetworkBase& model,
                                        const OperatorTabuSet& tabu_set) const override;
+    std::vector<std::shared_ptr<Operator>> find_max_batch(const ConditionalBayesianNetworkBase& model,
+                                                          const OperatorTabuSet& tabu_set,
+                                                          int max_operators) const override;
     template <bool limited_indigree>
     std::shared_ptr<Operator> find_max_indegree(const ConditionalBayesianNetworkBase& model) const;
     template <bool limited_indigree>
@@ -463,10 +624,12 @@ public:
 
     void update_incoming_arcs_scores(const BayesianNetworkBase& model,
                                      const Score& score,
-                                     const std::string& target_node);
+                                     const std::string& target_node,
+                                     int num_threads);
     void update_incoming_arcs_scores(const ConditionalBayesianNetworkBase& model,
                                      const Score& score,
-                                     const std::string& target_node);
+                                     const std::string& target_node,
+                                     int num_threads);
 
     void update_valid_ops(const BayesianNetworkBase& bn);
     void update_valid_ops(const ConditionalBayesianNetworkBase& bn);
@@ -477,24 +640,27 @@ public:
 
     void set_max_indegree(int indegree) override { max_indegree = indegree; }
 
+    void set_num_threads(int num_threads) override { m_num_threads = num_threads; }
+
 private:
+    template <bool limited_indegree, typename M>
+    std::vector<std::shared_ptr<Operator>> find_max_batch_indegree(const M& model,
+                                                                   const OperatorTabuSet* tabu_set,
+                                                                   int max_operators) const;
+
     MatrixXd delta;
     MatrixXb valid_op;
-    mutable std::vector<int> sorted_idx;
+    std::vector<int> valid_idx;
+    util::IndexedMaxHeap delta_heap;
     ArcStringVector m_blacklist;
     ArcStringVector m_whitelist;
     int max_indegree;
+    int m_num_threads;
 };
 
 template <bool limited_indegree>
 std::shared_ptr<Operator> ArcOperatorSet::find_max_indegree(const BayesianNetworkBase& model) const {
-    auto delta_ptr = delta.data();
-
-    // TODO: Not checking sorted_idx empty
-    std::sort(
-        sorted_idx.begin(), sorted_idx.end(), [&delta_ptr](auto i1, auto i2) { return delta_ptr[i1] > delta_ptr[i2]; });
-
-    for (auto it = sorted_idx.begin(), end = sorted_idx.end(); it != end; ++it) {
+    for (auto it = delta_heap.descending(); !it.end(); ++it) {
         auto idx = *it;
         auto source_collapsed = idx % model.num_nodes();
         auto target_collapsed = idx / model.num_nodes();
@@ -526,13 +692,7 @@ std::shared_ptr<Operator> ArcOperatorSet::find_max_indegree(const BayesianNetwor
 
 template <bool limited_indegree>
 std::shared_ptr<Operator> ArcOperatorSet::find_max_indegree(const ConditionalBayesianNetworkBase& model) const {
-    auto delta_ptr = delta.data();
-
-    // TODO: Not checking sorted_idx empty
-    std::sort(
-        sorted_idx.begin(), sorted_idx.end(), [&delta_ptr](auto i1, auto i2) { return delta_ptr[i1] > delta_ptr[i2]; });
-
-    for (auto it = sorted_idx.begin(), end = sorted_idx.end(); it != end; ++it) {
+    for (auto it = delta_heap.descending(); !it.end(); ++it) {
         auto idx = *it;
         auto source_joint_collapsed = idx % model.num_joint_nodes();
         auto target_collapsed = idx / model.num_joint_nodes();
@@ -580,42 +740,36 @@ std::shared_ptr<Operator> ArcOperatorSet::find_max_indegree(const ConditionalBay
 template <bool limited_indegree>
 std::shared_ptr<Operator> ArcOperatorSet::find_max_indegree(const BayesianNetworkBase& model,
                                                             const OperatorTabuSet& tabu_set) const {
-    auto delta_ptr = delta.data();
-
-    // TODO: Not checking sorted_idx empty
-    std::sort(
-        sorted_idx.begin(), sorted_idx.end(), [&delta_ptr](auto i1, auto i2) { return delta_ptr[i1] > delta_ptr[i2]; });
-
-    for (auto it = sorted_idx.begin(), end = sorted_idx.end(); it != end; ++it) {
+    for (auto it = delta_heap.descending(); !it.end(); ++it) {
         auto idx = *it;
         auto source_collapsed = idx % model.num_nodes();
         auto target_collapsed = idx / model.num_nodes();
 
         const auto& source = model.collapsed_name(source_collapsed);
         const auto& target = model.collapsed_name(target_collapsed);
+        auto source_index = model.index_from_collapsed(source_collapsed);
+        auto target_index = model.index_from_collapsed(target_collapsed);
 
+        auto d = delta(source_collapsed, target_collapsed);
         if (model.has_arc(source, target)) {
-            std::shared_ptr<Operator> op =
-                std::make_shared<RemoveArc>(source, target, delta(source_collapsed, target_collapsed));
-            if (!tabu_set.contains(op)) return op;
+            auto op = arc_operator_not_tabu<RemoveArc>(&tabu_set, source_index, target_index, source, target, d);
+            if (op) return op;
         } else if (model.has_arc(target, source) && model.can_flip_arc(target, source)) {
             if constexpr (limited_indegree) {
                 if (model.num_parents(target) >= max_indegree) {
                     continue;
                 }
             }
-            std::shared_ptr<Operator> op =
-                std::make_shared<FlipArc>(target, source, delta(source_collapsed, target_collapsed));
-            if (!tabu_set.contains(op)) return op;
+            auto op = arc_operator_not_tabu<FlipArc>(&tabu_set, target_index, source_index, target, source, d);
+            if (op) return op;
         } else if (model.can_add_arc(source, target)) {
             if constexpr (limited_indegree) {
                 if (model.num_parents(target) >= max_indegree) {
                     continue;
                 }
             }
-            std::shared_ptr<Operator> op =
-                std::make_shared<AddArc>(source, target, delta(source_collapsed, target_collapsed));
-            if (!tabu_set.contains(op)) return op;
+            auto op = arc_operator_not_tabu<AddArc>(&tabu_set, source_index, target_index, source, target, d);
+            if (op) return op;
         }
     }
 
@@ -625,29 +779,22 @@ std::shared_ptr<Operator> ArcOperatorSet::find_max_indegree(const BayesianNetwor
 template <bool limited_indegree>
 std::shared_ptr<Operator> ArcOperatorSet::find_max_indegree(const ConditionalBayesianNetworkBase& model,
                                                             const OperatorTabuSet& tabu_set) const {
-    auto delta_ptr = delta.data();
-
-    // TODO: Not checking sorted_idx empty
-    std::sort(
-        sorted_idx.begin(), sorted_idx.end(), [&delta_ptr](auto i1, auto i2) { return delta_ptr[i1] > delta_ptr[i2]; });
-
-    for (auto it = sorted_idx.begin(), end = sorted_idx.end(); it != end; ++it) {
+    for (auto it = delta_heap.descending(); !it.end(); ++it) {
         auto idx = *it;
         auto source_joint_collapsed = idx % model.num_joint_nodes();
         auto target_collapsed = idx / model.num_joint_nodes();
 
         const auto& source = model.joint_collapsed_name(source_joint_collapsed);
         const auto& target = model.collapsed_name(target_collapsed);
+        auto source_index = model.index_from_joint_collapsed(source_joint_collapsed);
+        auto target_index = model.index_from_collapsed(target_collapsed);
 
         auto d = delta(source_joint_collapsed, target_collapsed);
 
         if (model.has_arc(source, target)) {
-            std::shared_ptr<Operator> op = std::make_shared<RemoveArc>(source, target, d);
-
-            if (!tabu_set.contains(op))
-                return op;
-            else
-                continue;
+            auto op = arc_operator_not_tabu<RemoveArc>(&tabu_set, source_index, target_index, source, target, d);
+            if (op) return op;
+            continue;
         }
 
         if (model.is_interface(source)) {
@@ -659,8 +806,8 @@ std::shared_ptr<Operator> ArcOperatorSet::find_max_indegree(const ConditionalBay
             // If source is interface, the arc has a unique direction, and cannot produce cycles as source cannot have
             // parents.
             if (model.type_ref().can_have_arc(model, source, target)) {
-                std::shared_ptr<Operator> op = std::make_shared<AddArc>(source, target, d);
-                if (!tabu_set.contains(op)) return op;
+                auto op = arc_operator_not_tabu<AddArc>(&tabu_set, source_index, target_index, source, target, d);
+                if (op) return op;
             }
         } else {
             if (model.has_arc(target, source) && model.can_flip_arc(target, source)) {
@@ -669,16 +816,16 @@ std::shared_ptr<Operator> ArcOperatorSet::find_max_indegree(const ConditionalBay
                         continue;
                     }
                 }
-                std::shared_ptr<Operator> op = std::make_shared<FlipArc>(target, source, d);
-                if (!tabu_set.contains(op)) return op;
+                auto op = arc_operator_not_tabu<FlipArc>(&tabu_set, target_index, source_index, target, source, d);
+                if (op) return op;
             } else if (model.can_add_arc(source, target)) {
                 if constexpr (limited_indegree) {
                     if (model.num_parents(target) >= max_indegree) {
                         continue;
                     }
                 }
-                std::shared_ptr<Operator> op = std::make_shared<AddArc>(source, target, d);
-                if (!tabu_set.contains(op)) return op;
+                auto op = arc_operator_not_tabu<AddArc>(&tabu_set, source_index, target_index, source, target, d);
+                if (op) return op;
             }
         }
     }
@@ -686,10 +833,102 @@ std::shared_ptr<Operator> ArcOperatorSet::find_max_indegree(const ConditionalBay
     return nullptr;
 }
 
+// Candidate parents of each node.
+using ArcCandidates = std::unordered_map<std::string, std::vector<std::string>>;
+
+// Sparse version of ArcOperatorSet: only the arcs source -> target where source is a candidate parent of target are
+// scored. The arcs of the model when cache_scores() is called are always included in both directions, so they can be
+// removed or flipped. The memory and the number of local scores evaluated are O(n·k) instead of O(n²), where k is the
+// mean number of candidates.
+class CandidateArcOperatorSet : public OperatorSet {
+public:
+    CandidateArcOperatorSet(ArcCandidates candidates,
+                            ArcStringVector blacklist = ArcStringVector(),
+                            ArcStringVector whitelist = ArcStringVector(),
+                            int indegree = 0)
+        : m_candidates(std::move(candidates)),
+          m_source(),
+          m_target(),
+          m_column(),
+          m_row(),
+          delta(),
+          m_is_flip(),
+          delta_heap(),
+          m_blacklist(blacklist),
+          m_whitelist(whitelist),
+          max_indegree(indegree),
+          m_num_threads(1) {}
+
+    void cache_scores(const BayesianNetworkBase& model, const Score& score) override;
+    std::shared_ptr<Operator> find_max(const BayesianNetworkBase& model) const override;
+    std::shared_ptr<Operator> find_max(const BayesianNetworkBase& model,
+                                       const OperatorTabuSet& tabu_set) const override;
+    std::vector<std::shared_ptr<Operator>> find_max_batch(const BayesianNetworkBase& model,
+                                                          const OperatorTabuSet& tabu_set,
+                                                          int max_operators) const override;
+    void update_scores(const BayesianNetworkBase&, const Score&, const std::vector<std::string>&) override;
+
+    void cache_scores(const ConditionalBayesianNetworkBase& model, const Score& score) override;
+    std::shared_ptr<Operator> find_max(const ConditionalBayesianNetworkBase& model) const override;
+    std::shared_ptr<Operator> find_max(const ConditionalBayesianNetworkBase& model,
+                                       const OperatorTabuSet& tabu_set) const override;
+    std::vector<std::shared_ptr<Operator>> find_max_batch(const ConditionalBayesianNetworkBase& model,
+                                                          const OperatorTabuSet& tabu_set,
+                                                          int max_operators) const override;
+    void update_scores(const ConditionalBayesianNetworkBase&, const Score&, const std::vector<std::string>&) override;
+
+    const ArcCandidates& arc_candidates() const { return m_candidates; }
+    void set_arc_candidates(ArcCandidates candidates) { m_candidates = std::move(candidates); }
+
+    // Number of scored arcs in the last call to cache_scores().
+    int num_candidate_arcs() const { return static_cast<int>(m_source.size()); }
+
+    void set_arc_blacklist(const ArcStringVector& blacklist) override { m_blacklist = blacklist; }
+
+    void set_arc_whitelist(const ArcStringVector& whitelist) override { m_whitelist = whitelist; }
+
+    void set_max_indegree(int indegree) override { max_indegree = indegree; }
+
+    void set_num_threads(int num_threads) override { m_num_threads = num_threads; }
+
+private:
+    template <typename M>
+    void update_valid_ops(const M& model);
+    template <typename M>
+    void cache_scores_impl(const M& model, const Score& score);
+    template <typename M>
+    void update_scores_impl(const M& model, const Score& score, const std::vector<std::string>& variables);
+    template <typename M>
+    void update_delta(const M& model, const Score& score, int slot, std::vector<std::string>& parents_target);
+    template <bool limited_indegree, typename M>
+    std::shared_ptr<Operator> find_max_indegree(const M& model, const OperatorTabuSet* tabu_set) const;
+    template <bool limited_indegree, typename M>
+    std::vector<std::shared_ptr<Operator>> find_max_batch_indegree(const M& model,
+                                                                   const OperatorTabuSet* tabu_set,
+                                                                   int max_operators) const;
+
+    ArcCandidates m_candidates;
+    // Each scored arc (a slot) is m_source[slot] -> m_target[slot] (model indices). The slots of each target are
+    // contiguous: [m_column[t], m_column[t + 1]) for the collapsed index t, sorted by the source index.
+    std::vector<int> m_source;
+    std::vector<int> m_target;
+    std::vector<int> m_column;
+    // Slots where each node (collapsed index) is the source.
+    std::vector<std::vector<int>> m_row;
+    VectorXd delta;
+    // True if the delta of the slot was computed as an arc flip. Stored as char so threads can write different slots.
+    std::vector<char> m_is_flip;
+    util::IndexedMaxHeap delta_heap;
+    ArcStringVector m_blacklist;
+    ArcStringVector m_whitelist;
+    int max_indegree;
+    int m_num_threads;
+};
+
 class ChangeNodeTypeSet : public OperatorSet {
 public:
     ChangeNodeTypeSet(FactorTypeVector blacklist = FactorTypeVector(), FactorTypeVector whitelist = FactorTypeVector())
-        : delta(), m_is_whitelisted(), m_type_blacklist(), m_type_whitelist(whitelist) {
+        : delta(), m_is_whitelisted(), m_type_blacklist(), m_type_whitelist(whitelist), m_num_threads(1) {
         for (const auto& bl : blacklist) {
             m_type_blacklist.insert(bl);
         }
@@ -699,6 +938,9 @@ public:
     std::shared_ptr<Operator> find_max(const BayesianNetworkBase& model) const override;
     std::shared_ptr<Operator> find_max(const BayesianNetworkBase& model,
                                        const OperatorTabuSet& tabu_set) const override;
+    std::vector<std::shared_ptr<Operator>> find_max_batch(const BayesianNetworkBase& model,
+                                                          const OperatorTabuSet& tabu_set,
+                                                          int max_operators) const override;
     void update_scores(const BayesianNetworkBase& model,
                        const Score& score,
                        const std::vector<std::string>& variables) override;
@@ -713,6 +955,11 @@ public:
                                        const OperatorTabuSet& tabu_set) const override {
         return find_max(static_cast<const BayesianNetworkBase&>(model), tabu_set);
     }
+    std::vector<std::shared_ptr<Operator>> find_max_batch(const ConditionalBayesianNetworkBase& model,
+                                                          const OperatorTabuSet& tabu_set,
+                                                          int max_operators) const override {
+        return find_max_batch(static_cast<const BayesianNetworkBase&>(model), tabu_set, max_operators);
+    }
     void update_scores(const ConditionalBayesianNetworkBase& model,
                        const Score& score,
                        const std::vector<std::string>& variables) override {
@@ -741,11 +988,14 @@ public:
 
     void set_type_whitelist(const FactorTypeVector& whitelist) override { m_type_whitelist = whitelist; }
 
+    void set_num_threads(int num_threads) override { m_num_threads = num_threads; }
+
 private:
     std::vector<VectorXd> delta;
     VectorXb m_is_whitelisted;
     util::FactorTypeSet m_type_blacklist;
     FactorTypeVector m_type_whitelist;
+    int m_num_threads;
 };
 
 class OperatorPool : public OperatorSet {
@@ -766,6 +1016,11 @@ public:
                                        const OperatorTabuSet& tabu_set) const override {
         return find_max<BayesianNetworkBase>(model, tabu_set);
     }
+    std::vector<std::shared_ptr<Operator>> find_max_batch(const BayesianNetworkBase& model,
+                                                          const OperatorTabuSet& tabu_set,
+                                                          int max_operators) const override {
+        return find_max_batch<BayesianNetworkBase>(model, tabu_set, max_operators);
+    }
     void update_scores(const BayesianNetworkBase& model,
                        const Score& score,
                        const std::vector<std::string>& variables) override {
@@ -782,6 +1037,11 @@ public:
                                        const OperatorTabuSet& tabu_set) const override {
         return find_max<ConditionalBayesianNetworkBase>(model, tabu_set);
     }
+    std::vector<std::shared_ptr<Operator>> find_max_batch(const ConditionalBayesianNetworkBase& model,
+                                                          const OperatorTabuSet& tabu_set,
+                                                          int max_operators) const override {
+        return find_max_batch<ConditionalBayesianNetworkBase>(model, tabu_set, max_operators);
+    }
     void update_scores(const ConditionalBayesianNetworkBase& model,
                        const Score& score,
                        const std::vector<std::string>& variables) override {
@@ -795,6 +1055,10 @@ public:
     template <typename M>
     std::shared_ptr<Operator> find_max(const M& model, const OperatorTabuSet& tabu_set) const;
     template <typename M>
+    std::vector<std::shared_ptr<Operator>> find_max_batch(const M& model,
+                                                          const OperatorTabuSet& tabu_set,
+                                                          int max_operators) const;
+    template <typename M>
     void update_scores(const M& model, const Score& score, const std::vector<std::string>& variables);
 
     void set_arc_blacklist(const ArcStringVector& blacklist) override {
@@ -821,6 +1085,12 @@ public:
         }
     }
 
+    void set_num_threads(int num_threads) override {
+        for (auto& opset : m_op_sets) {
+            opset->set_num_threads(num_threads);
+        }
+    }
+
     virtual void finished() override {
         for (auto& opset : m_op_sets) {
             opset->finished();
@@ -888,6 +1158,31 @@ std::shared_ptr<Operator> OperatorPool::find_max(const M& model, const OperatorT
     return max_op;
 }
 
+template <typename M>
+std::vector<std::shared_ptr<Operator>> OperatorPool::find_max_batch(const M& model,
+                                                                    const OperatorTabuSet& tabu_set,
+                                                                    int max_operators) const {
+    raise_uninitialized();
+
+    std::vector<std::shared_ptr<Operator>> candidates;
+    for (auto& op_set : m_op_sets) {
+        auto ops = op_set->find_max_batch(model, tabu_set, max_operators);
+        candidates.insert(candidates.end(), ops.begin(), ops.end());
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        return a->delta() > b->delta();
+    });
+
+    OperatorBatch batch(max_operators);
+    for (auto& op : candidates) {
+        if (batch.full() || (!batch.empty() && op->delta() <= 0)) break;
+        batch.insert(model, std::move(op));
+    }
+
+    return std::move(batch.operators());
+}
+
 template <typename M>
 void OperatorPool::update_scores(const M& model, const Score& score, const std::vector<std::string>& variables) {
     raise_uninitialized();
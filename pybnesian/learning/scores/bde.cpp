@@ -4,7 +4,7 @@ namespace learning::scores {
 
 double BDe::bde_impl_noparents(const std::string& variable) const {
     auto [cardinality, strides] = factors::discrete::create_cardinality_strides(m_df, variable, {});
-    auto joint_counts = factors::discrete::joint_counts(m_df, variable, {}, cardinality, strides);
+    auto joint_counts = this->joint_counts(variable, {}, cardinality, strides);
 
     double alpha = m_iss / cardinality(0);
 
@@ -22,7 +22,7 @@ double BDe::bde_impl_noparents(const std::string& variable) const {
 
 double BDe::bde_impl_parents(const std::string& variable, const std::vector<std::string>& parents) const {
     auto [cardinality, strides] = factors::discrete::create_cardinality_strides(m_df, variable, parents);
-    auto joint_counts = factors::discrete::joint_counts(m_df, variable, parents, cardinality, strides);
+    auto joint_counts = this->joint_counts(variable, parents, cardinality, strides);
 
     auto cardinality_prod = cardinality.prod();
     double alpha = m_iss / cardinality_prod;
@@ -2,7 +2,9 @@
 #define PYBNESIAN_LEARNING_SCORES_BDE_HPP
 
 #include <factors/discrete/DiscreteFactor.hpp>
+#include <factors/discrete/contingency_cache.hpp>
 #include <learning/scores/scores.hpp>
+#include <learning/scores/sufficient_statistics.hpp>
 
 using factors::discrete::DiscreteFactorType;
 
@@ -10,7 +12,15 @@ namespace learning::scores {
 
 class BDe : public Score {
 public:
-    BDe(const DataFrame& df, double iss = 1) : m_df(df), m_iss(iss) {}
+    // The discrete counts are computed using num_threads threads.
+    BDe(const DataFrame& df, double iss = 1, int num_threads = 1)
+        : m_df(df),
+          m_iss(iss),
+          m_counts(std::make_shared<factors::discrete::ContingencyTableCache>(df, num_threads)),
+          m_statistics(nullptr) {}
+    // Computes the score from the sufficient statistics of a dataset, without reading the data.
+    BDe(const std::shared_ptr<SufficientStatistics>& statistics, double iss = 1)
+        : m_df(statistics->data()), m_iss(iss), m_counts(nullptr), m_statistics(statistics) {}
 
     double local_score(const BayesianNetworkBase& model,
                        const std::string& variable,
@@ -41,12 +51,23 @@ public:
 
     DataFrame data() const override { return m_df; }
 
+    bool is_thread_safe() const override { return true; }
+
 private:
     double bde_impl_noparents(const std::string& variable) const;
     double bde_impl_parents(const std::string& variable, const std::vector<std::string>& parents) const;
+    VectorXi joint_counts(const std::string& variable,
+                          const std::vector<std::string>& parents,
+                          const VectorXi& cardinality,
+                          const VectorXi& strides) const {
+        if (m_statistics) return m_statistics->joint_counts(variable, parents, cardinality, strides);
+        return m_counts->joint_counts(variable, parents, cardinality, strides);
+    }
 
     const DataFrame m_df;
     double m_iss;
+    std::shared_ptr<factors::discrete::ContingencyTableCache> m_counts;
+    std::shared_ptr<SufficientStatistics> m_statistics;
 };
 
 using DynamicBDe = DynamicScoreAdaptator<BDe>;
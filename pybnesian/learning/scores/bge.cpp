@@ -103,6 +103,60 @@ void BGe::generate_means(VectorXd& means, const std::string& variable, const std
     }
 }
 
+// Returns the local score computing the determinants of the r matrix with the Cholesky factor of the current parents
+// of the variable in the model. The factor of a parent set that adds or removes one parent is updated in O(p²). Returns
+// std::nullopt if the variables are not cached or the r matrix is not positive definite.
+std::optional<double> BGe::bge_parents_cholesky(const BayesianNetworkBase& model,
+                                                const std::string& variable,
+                                                const std::vector<std::string>& parents) const {
+    if (m_cached_nu.rows() == 0) return std::nullopt;
+
+    auto to_cached = [this](const std::vector<std::string>& names) -> std::optional<std::vector<int>> {
+        std::vector<int> indices;
+        indices.reserve(names.size());
+        for (const auto& name : names) {
+            auto it = m_cached_indices.find(name);
+            if (it == m_cached_indices.end()) return std::nullopt;
+            indices.push_back(it->second);
+        }
+        return indices;
+    };
+
+    auto it = m_cached_indices.find(variable);
+    if (it == m_cached_indices.end()) return std::nullopt;
+    auto var_index = it->second;
+
+    auto parents_indices = to_cached(parents);
+    auto current_indices = to_cached(model.parents(variable));
+    if (!parents_indices || !current_indices) return std::nullopt;
+
+    int total_nodes = model.num_nodes();
+    double N = m_statistics ? m_statistics->gaussian_statistics().rows() : m_df->num_rows();
+    double p = parents.size();
+
+    double t = m_iss_mu * (m_iss_w - total_nodes - 1) / (m_iss_mu + 1);
+    double cte_r = (N * m_iss_mu) / (N + m_iss_mu);
+
+    auto r = [this, t, cte_r](int i, int j) {
+        double res = m_cached_sse(i, j) + cte_r * (m_cached_means(i) - m_cached_nu(i)) *
+                                              (m_cached_means(j) - m_cached_nu(j));
+        return (i == j) ? res + t : res;
+    };
+
+    // The r matrix depends on the number of nodes of the model, so it is used as tag of the cached factors.
+    auto logdets = m_cholesky->logdets(var_index, *current_indices, *parents_indices, total_nodes, r);
+    if (!logdets) return std::nullopt;
+
+    double logprob = 0.5 * (log(m_iss_mu) - log(N + m_iss_mu));
+    logprob += lgamma(0.5 * (N + m_iss_w - total_nodes + p + 1)) - lgamma(0.5 * (m_iss_w - total_nodes + p + 1));
+    logprob -= 0.5 * N * log(util::pi<double>);
+    logprob += 0.5 * (m_iss_w - total_nodes + 2 * p + 1) * log(t);
+
+    logprob -= 0.5 * (N + m_iss_w - total_nodes + p + 1) * logdets->second;
+    logprob += 0.5 * (N + m_iss_w - total_nodes + p) * logdets->first;
+    return logprob;
+}
+
 double BGe::bge_impl(const BayesianNetworkBase& model,
                      const std::string& variable,
                      const std::vector<std::string>& parents) const {
@@ -110,6 +164,8 @@ double BGe::bge_impl(const BayesianNetworkBase& model,
         double nu = [this, &variable]() {
             if (m_nu) {
                 return (*m_nu)(m_df.index(variable));
+            } else if (m_statistics) {
+                return m_cached_means(cached_index(variable));
             } else {
                 return m_df.mean(variable);
             }
@@ -119,6 +175,10 @@ double BGe::bge_impl(const BayesianNetworkBase& model,
 
         return bge_no_parents(variable, model.num_nodes(), nu);
     } else {
+        if (m_is_cached) {
+            if (auto logprob = bge_parents_cholesky(model, variable, parents)) return *logprob;
+        }
+
         VectorXd nu = [this, &variable, &parents]() {
             if (m_nu) {
                 VectorXd res(parents.size() + 1);
@@ -128,6 +188,10 @@ double BGe::bge_impl(const BayesianNetworkBase& model,
                     res(++i) = (*m_nu)(m_df.index(e));
                 }
 
+                return res;
+            } else if (m_statistics) {
+                VectorXd res(parents.size() + 1);
+                generate_cached_means(res, variable, parents);
                 return res;
             } else {
                 auto combined_bitmap = m_df.combined_bitmap(variable, parents);
@@ -4,6 +4,8 @@
 #include <dataset/dataset.hpp>
 #include <models/BayesianNetwork.hpp>
 #include <learning/scores/scores.hpp>
+#include <learning/scores/cholesky_cache.hpp>
+#include <learning/scores/sufficient_statistics.hpp>
 
 using dataset::DataFrame;
 using learning::scores::Score;
@@ -24,30 +26,11 @@ public:
           m_cached_sse(),
           m_cached_means(),
           m_is_cached(false),
-          m_cached_indices() {
-        if (iss_w) {
-            if (*iss_w <= df->num_columns() - 1) {
-                throw std::invalid_argument(
-                    "Imaginary sample size for Wishart prior must be greater than "
-                    " num_columns - 1 (" +
-                    std::to_string(df->num_columns() - 1) + ").");
-            }
-
-            m_iss_w = *iss_w;
-        } else {
-            m_iss_w = df->num_columns() + 2;
-        }
-
-        if (nu) {
-            if (nu->rows() != df->num_columns()) {
-                throw std::invalid_argument("\"nu\" argument contains " + std::to_string(nu->rows()) +
-                                            " elements, "
-                                            "but DataFrame \"df\" contains " +
-                                            std::to_string(df->num_columns()) + " columns.");
-            }
-        }
-
-        m_nu = nu;
+          m_cached_indices(),
+          m_cached_nu(),
+          m_statistics(nullptr),
+          m_cholesky(std::make_shared<ParentsCholeskyCache>()) {
+        initialize_priors(iss_w, nu);
 
         auto continuous_indices = df.continuous_columns();
 
@@ -69,9 +52,31 @@ public:
                 default:
                     break;
             }
+
+            initialize_cached_nu();
         }
     }
 
+    // Computes the score from the sufficient statistics of a dataset, without reading the data.
+    BGe(const std::shared_ptr<SufficientStatistics>& statistics,
+        double iss_mu = 1,
+        std::optional<double> iss_w = std::nullopt,
+        std::optional<VectorXd> nu = std::nullopt)
+        : m_df(statistics->data()),
+          m_iss_mu(iss_mu),
+          m_iss_w(),
+          m_nu(),
+          m_cached_sse(statistics->gaussian_statistics().sse()),
+          m_cached_means(statistics->gaussian_statistics().means()),
+          m_is_cached(true),
+          m_cached_indices(statistics->continuous_indices()),
+          m_cached_nu(),
+          m_statistics(statistics),
+          m_cholesky(std::make_shared<ParentsCholeskyCache>()) {
+        initialize_priors(iss_w, nu);
+        initialize_cached_nu();
+    }
+
     double local_score(const BayesianNetworkBase& model,
                        const std::string& variable,
                        const std::vector<std::string>& parents) const override;
@@ -101,7 +106,45 @@ public:
 
     DataFrame data() const override { return m_df; }
 
+    bool is_thread_safe() const override { return true; }
+
 private:
+    void initialize_priors(std::optional<double> iss_w, std::optional<VectorXd> nu) {
+        if (iss_w) {
+            if (*iss_w <= m_df->num_columns() - 1) {
+                throw std::invalid_argument(
+                    "Imaginary sample size for Wishart prior must be greater than "
+                    " num_columns - 1 (" +
+                    std::to_string(m_df->num_columns() - 1) + ").");
+            }
+
+            m_iss_w = *iss_w;
+        } else {
+            m_iss_w = m_df->num_columns() + 2;
+        }
+
+        if (nu) {
+            if (nu->rows() != m_df->num_columns()) {
+                throw std::invalid_argument("\"nu\" argument contains " + std::to_string(nu->rows()) +
+                                            " elements, "
+                                            "but DataFrame \"df\" contains " +
+                                            std::to_string(m_df->num_columns()) + " columns.");
+            }
+        }
+
+        m_nu = nu;
+    }
+
+    // Mean of the normal-Wishart prior for each cached variable.
+    void initialize_cached_nu() {
+        if (m_cached_means.rows() != static_cast<int>(m_cached_indices.size())) return;
+
+        m_cached_nu = VectorXd(m_cached_means.rows());
+        for (const auto& it : m_cached_indices) {
+            m_cached_nu(it.second) = m_nu ? (*m_nu)(m_df.index(it.first)) : m_cached_means(it.second);
+        }
+    }
+
     int cached_index(int v) const {
         auto it = m_cached_indices.find(m_df->column_name(v));
         if (it == m_cached_indices.end())
@@ -123,6 +166,10 @@ private:
     double bge_no_parents(const std::string& variable, int total_nodes, double nu) const;
     double bge_no_parents(const std::string& variable, int total_nodes, double nu) const;
 
+    std::optional<double> bge_parents_cholesky(const BayesianNetworkBase& model,
+                                               const std::string& variable,
+                                               const std::vector<std::string>& parents) const;
+
     template <typename ArrowType>
     double bge_parents(const std::string& variable,
                        const std::vector<std::string>& parents,
@@ -149,11 +196,14 @@ private:
     VectorXd m_cached_means;
     bool m_is_cached;
     std::unordered_map<std::string, int> m_cached_indices;
+    VectorXd m_cached_nu;
+    std::shared_ptr<SufficientStatistics> m_statistics;
+    std::shared_ptr<ParentsCholeskyCache> m_cholesky;
 };
 
 template <typename ArrowType>
 double BGe::bge_no_parents(const std::string& variable, int total_nodes, double nu) const {
-    double N = m_df.valid_rows(variable);
+    double N = m_statistics ? m_statistics->gaussian_statistics().rows() : m_df.valid_rows(variable);
 
     double logprob = 0.5 * (log(m_iss_mu) - log(N + m_iss_mu));
     logprob += lgamma(0.5 * (N + m_iss_w - total_nodes + 1)) - lgamma(0.5 * (m_iss_w - total_nodes + 1));
@@ -162,11 +212,14 @@ double BGe::bge_no_parents(const std::string& variable, int total_nodes, double
     double t = m_iss_mu * (m_iss_w - total_nodes - 1) / (m_iss_mu + 1);
     logprob += 0.5 * (m_iss_w - total_nodes + 1) * log(t);
 
-    double mean = m_df.mean(variable);
+    double mean = m_statistics ? m_cached_means(cached_index(variable)) : m_df.mean(variable);
     double nu_diff = mean - nu;
 
     double sse = [this, &variable, mean]() {
-        if (m_df.null_count(variable) == 0) {
+        if (m_statistics) {
+            auto index = cached_index(variable);
+            return m_cached_sse(index, index);
+        } else if (m_df.null_count(variable) == 0) {
             auto column = m_df.to_eigen<false, ArrowType, false>(variable);
             return (column->array() - mean).matrix().squaredNorm();
         } else {
@@ -186,7 +239,7 @@ double BGe::bge_parents(const std::string& variable,
                         const std::vector<std::string>& evidence,
                         int total_nodes,
                         VectorXd& nu) const {
-    double N = m_df.valid_rows(variable, evidence);
+    double N = m_statistics ? m_statistics->gaussian_statistics().rows() : m_df.valid_rows(variable, evidence);
     double p = evidence.size();
 
     double logprob = 0.5 * (log(m_iss_mu) - log(N + m_iss_mu));
@@ -9,19 +9,135 @@ using models::GaussianNetworkType;
 
 namespace learning::scores {
 
-double BIC::bic_lineargaussian(const std::string& variable, const std::vector<std::string>& parents) const {
-    MLE<LinearGaussianCPD> mle;
+BIC::BIC(const DataFrame& df, int num_threads)
+    : m_df(df),
+      m_cached_sse(),
+      m_cached_means(),
+      m_is_cached(false),
+      m_cached_columns(),
+      m_cached_flag(std::make_shared<std::once_flag>()),
+      m_cached_indices(),
+      m_cached_rows(df->num_rows()),
+      m_counts(std::make_shared<factors::discrete::ContingencyTableCache>(df, num_threads)),
+      m_statistics(nullptr) {
+    auto continuous_indices = df.continuous_columns();
+
+    if (continuous_indices.empty() || static_cast<int>(continuous_indices.size()) > MAX_CACHED_COLUMNS ||
+        m_df.null_count(continuous_indices) > 0)
+        return;
+
+    auto type_id = m_df.col(continuous_indices[0])->type_id();
+    if (type_id != Type::DOUBLE && type_id != Type::FLOAT) return;
+    for (auto index : continuous_indices) {
+        if (m_df.col(index)->type_id() != type_id) return;
+    }
+
+    m_is_cached = true;
+    m_cached_columns = continuous_indices;
+    for (int i = 0, size = continuous_indices.size(); i < size; ++i) {
+        m_cached_indices.insert(std::make_pair(m_df->column_name(continuous_indices[i]), i));
+    }
+}
+
+BIC::BIC(const std::shared_ptr<SufficientStatistics>& statistics)
+    : m_df(statistics->data()),
+      m_cached_sse(statistics->gaussian_statistics().sse()),
+      m_cached_means(statistics->gaussian_statistics().means()),
+      m_is_cached(statistics->gaussian_statistics().rows() > 0),
+      m_cached_columns(),
+      m_cached_flag(std::make_shared<std::once_flag>()),
+      m_cached_indices(statistics->continuous_indices()),
+      m_cached_rows(statistics->gaussian_statistics().rows()),
+      m_counts(nullptr),
+      m_statistics(statistics) {}
+
+void BIC::compute_cached_sse() const {
+    // The statistics of a SufficientStatistics are already computed.
+    if (m_statistics) return;
+
+    std::call_once(*m_cached_flag, [this]() {
+        switch (m_df.col(m_cached_columns[0])->type_id()) {
+            case Type::DOUBLE:
+                m_cached_means = m_df.means<arrow::DoubleType>(m_cached_columns);
+                m_cached_sse = std::move(*m_df.sse<arrow::DoubleType, false>(m_cached_columns));
+                break;
+            case Type::FLOAT:
+                m_cached_means = m_df.means<arrow::FloatType>(m_cached_columns).template cast<double>();
+                m_cached_sse = m_df.sse<arrow::FloatType, false>(m_cached_columns)->template cast<double>();
+                break;
+            default:
+                throw std::invalid_argument("Wrong data type to compute the SSE matrix.");
+        }
+    });
+}
+
+// Returns the variance of the linear regression of variable on parents computed from the cached SSE matrix. The
+// residual sum of squares is SSE_yy - SSE_yX·SSE_XX⁻¹·SSE_Xy, and it is divided by N - |parents| - 1 as in
+// MLE<LinearGaussianCPD>. Returns std::nullopt if some variable is not cached.
+std::optional<double> BIC::cached_lineargaussian_variance(const std::string& variable,
+                                                          const std::vector<std::string>& parents) const {
+    if (!m_is_cached) return std::nullopt;
+
+    auto it = m_cached_indices.find(variable);
+    if (it == m_cached_indices.end()) return std::nullopt;
+    auto var_index = it->second;
+
+    std::vector<int> parent_indices;
+    parent_indices.reserve(parents.size());
+    for (const auto& p : parents) {
+        auto it_parent = m_cached_indices.find(p);
+        if (it_parent == m_cached_indices.end()) return std::nullopt;
+        parent_indices.push_back(it_parent->second);
+    }
+
+    auto rows = m_cached_rows;
+    auto k = static_cast<int>(parents.size());
+    if (rows <= k + 1) return std::numeric_limits<double>::infinity();
+
+    compute_cached_sse();
 
-    auto mle_params = mle.estimate(m_df, variable, parents);
+    double rss = m_cached_sse(var_index, var_index);
 
-    if (mle_params.variance < util::machine_tol || std::isinf(mle_params.variance)) {
+    if (k > 0) {
+        MatrixXd sse_xx(k, k);
+        VectorXd sse_xy(k);
+        for (auto i = 0; i < k; ++i) {
+            sse_xy(i) = m_cached_sse(parent_indices[i], var_index);
+            for (auto j = 0; j < k; ++j) {
+                sse_xx(i, j) = m_cached_sse(parent_indices[i], parent_indices[j]);
+            }
+        }
+
+        // LDLT uses the pseudo-inverse of singular matrices, so collinear parents are handled as MLE does.
+        VectorXd beta = sse_xx.ldlt().solve(sse_xy);
+        rss -= sse_xy.dot(beta);
+    }
+
+    return std::max(rss, 0.) / (rows - k - 1);
+}
+
+double BIC::bic_lineargaussian(const std::string& variable, const std::vector<std::string>& parents) const {
+    double variance;
+    int64_t rows;
+    if (auto cached_variance = cached_lineargaussian_variance(variable, parents)) {
+        variance = *cached_variance;
+        rows = m_cached_rows;
+    } else if (m_statistics) {
+        throw std::invalid_argument("The sufficient statistics do not contain the continuous variables " + variable +
+                                    " and its parents.");
+    } else {
+        MLE<LinearGaussianCPD> mle;
+        variance = mle.estimate(m_df, variable, parents).variance;
+        rows = m_df.valid_rows(variable, parents);
+    }
+
+    if (variance < util::machine_tol || std::isinf(variance)) {
         return -std::numeric_limits<double>::infinity();
     }
 
-    auto rows = m_df.valid_rows(variable, parents);
     auto num_parents = parents.size();
     auto loglik = 0.5 * (1 + static_cast<double>(num_parents) - static_cast<double>(rows)) -
-                  0.5 * rows * std::log(2 * util::pi<double>) - rows * 0.5 * std::log(mle_params.variance);
+                  0.5 * rows * std::log(2 * util::pi<double>) - rows * 0.5 * std::log(variance);
 
     return loglik - std::log(rows) * 0.5 * (num_parents + 2);
 }
@@ -29,6 +145,11 @@ double BIC::bic_lineargaussian(const std::string& variable, const std::vector<st
 double BIC::bic_clg(const std::string& variable,
                     const std::vector<std::string>& discrete_parents,
                     const std::vector<std::string>& continuous_parents) const {
+    if (m_statistics) {
+        throw std::invalid_argument("The local score of the conditional linear Gaussian variable " + variable +
+                                    " cannot be computed from the sufficient statistics.");
+    }
+
     auto [cardinality, strides] = factors::discrete::create_cardinality_strides(m_df, discrete_parents);
 
     auto num_configs = cardinality.prod();
@@ -65,7 +186,8 @@ double BIC::bic_clg(const std::string& variable,
 
 double BIC::bic_discrete(const std::string& variable, const std::vector<std::string>& parents) const {
     auto [cardinality, strides] = factors::discrete::create_cardinality_strides(m_df, variable, parents);
-    auto joint_counts = factors::discrete::joint_counts(m_df, variable, parents, cardinality, strides);
+    auto joint_counts = m_statistics ? m_statistics->joint_counts(variable, parents, cardinality, strides)
+                                     : m_counts->joint_counts(variable, parents, cardinality, strides);
 
     auto parent_configurations = cardinality.tail(parents.size()).prod();
 
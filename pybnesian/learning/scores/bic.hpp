@@ -1,7 +1,10 @@
 #ifndef PYBNESIAN_LEARNING_SCORES_BIC_HPP
 #define PYBNESIAN_LEARNING_SCORES_BIC_HPP
 
+#include <mutex>
+#include <factors/discrete/contingency_cache.hpp>
 #include <learning/scores/scores.hpp>
+#include <learning/scores/sufficient_statistics.hpp>
 #include <learning/parameters/mle_LinearGaussianCPD.hpp>
 
 using learning::scores::Score;
@@ -13,7 +16,10 @@ namespace learning::scores {
 
 class BIC : public Score {
 public:
-    BIC(const DataFrame& df) : m_df(df) {}
+    // The discrete counts are computed using num_threads threads.
+    BIC(const DataFrame& df, int num_threads = 1);
+    // Computes the score from the sufficient statistics of a dataset, without reading the data.
+    BIC(const std::shared_ptr<SufficientStatistics>& statistics);
 
     double local_score(const BayesianNetworkBase& model,
                        const std::string& variable,
@@ -38,7 +44,11 @@ public:
 
     DataFrame data() const override { return m_df; }
 
+    bool is_thread_safe() const override { return true; }
+
 private:
+    std::optional<double> cached_lineargaussian_variance(const std::string& variable,
+                                                         const std::vector<std::string>& parents) const;
     double bic_lineargaussian(const std::string& variable, const std::vector<std::string>& parents) const;
     double bic_discrete(const std::string& variable, const std::vector<std::string>& parents) const;
     double bic_clg(const std::string& variable,
@@ -46,8 +56,25 @@ private:
                    const std::vector<std::string>& continuous_parents) const;
 
     bool are_all_discrete(const BayesianNetworkBase& model, const std::vector<std::string>& vars) const;
+    void compute_cached_sse() const;
+
+    // Maximum number of continuous columns of a cached SSE matrix. The matrix costs O(N·p²) time and O(p²) memory, so
+    // the local scores of wider DataFrames are computed from the data of each family.
+    static constexpr int MAX_CACHED_COLUMNS = 256;
 
     const DataFrame m_df;
+    // If the continuous columns have no nulls, their means and SSE matrix are cached, so the local score of a Gaussian
+    // node does not depend on the number of rows. The matrix is computed the first time a Gaussian local score is
+    // requested.
+    mutable MatrixXd m_cached_sse;
+    mutable VectorXd m_cached_means;
+    bool m_is_cached;
+    std::vector<int> m_cached_columns;
+    std::shared_ptr<std::once_flag> m_cached_flag;
+    std::unordered_map<std::string, int> m_cached_indices;
+    int64_t m_cached_rows;
+    std::shared_ptr<factors::discrete::ContingencyTableCache> m_counts;
+    std::shared_ptr<SufficientStatistics> m_statistics;
 };
 
 using DynamicBIC = DynamicScoreAdaptator<BIC>;
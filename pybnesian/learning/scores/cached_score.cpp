@@ -0,0 +1,78 @@
+#include <learning/scores/cached_score.hpp>
+#include <util/hash_utils.hpp>
+
+namespace learning::scores {
+
+std::size_t LocalScoreKeyHash::operator()(const LocalScoreKey& key) const {
+    std::size_t seed = std::hash<std::string>{}(key.variable);
+    util::hash_combine(seed, key.node_type);
+    util::hash_combine(seed, key.explicit_type);
+    util::hash_combine(seed, key.validation);
+
+    for (const auto& p : key.parents) {
+        util::hash_combine(seed, p);
+    }
+
+    for (auto t : key.parent_types) {
+        util::hash_combine(seed, t);
+    }
+
+    return seed;
+}
+
+std::optional<double> LocalScoreMemo::find(const LocalScoreKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_map.find(key);
+    if (it == m_map.end()) {
+        ++m_misses;
+        return std::nullopt;
+    }
+
+    ++m_hits;
+    m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+    return it->second.first;
+}
+
+void LocalScoreMemo::insert(LocalScoreKey&& key, double value) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto [it, inserted] = m_map.try_emplace(std::move(key), value, m_lru.end());
+    if (!inserted) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+        return;
+    }
+
+    m_lru.push_front(&it->first);
+    it->second.second = m_lru.begin();
+
+    if (static_cast<int>(m_map.size()) > m_max_size) {
+        m_map.erase(*m_lru.back());
+        m_lru.pop_back();
+    }
+}
+
+int LocalScoreMemo::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<int>(m_map.size());
+}
+
+long long LocalScoreMemo::hits() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+long long LocalScoreMemo::misses() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+void LocalScoreMemo::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_map.clear();
+    m_lru.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+}  // namespace learning::scores
@@ -0,0 +1,209 @@
+#ifndef PYBNESIAN_LEARNING_SCORES_CACHED_SCORE_HPP
+#define PYBNESIAN_LEARNING_SCORES_CACHED_SCORE_HPP
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <learning/scores/scores.hpp>
+
+using learning::scores::Score, learning::scores::ValidatedScore;
+
+namespace learning::scores {
+
+// Identifies a local score: the variable, its node type, its (sorted) parent set and the node types of the parents. The
+// node types of the parents select the factor (e.g. a LinearGaussianCPD node with discrete parents is a
+// CLinearGaussianCPD), so they are part of the key. A local score computed with an explicit node type can be different
+// from the local score computed with the node type of the model (e.g. BIC computes a CLG score for a LinearGaussianCPD
+// node with discrete parents only if the node type is deduced from the model), so both kinds of calls are kept apart.
+// The same is done for training and validation local scores.
+struct LocalScoreKey {
+    std::string variable;
+    std::size_t node_type;
+    bool explicit_type;
+    bool validation;
+    std::vector<std::string> parents;
+    // Hash of the node type of each parent, in the order of parents.
+    std::vector<std::size_t> parent_types;
+
+    bool operator==(const LocalScoreKey& other) const {
+        return node_type == other.node_type && explicit_type == other.explicit_type &&
+               validation == other.validation && variable == other.variable && parents == other.parents &&
+               parent_types == other.parent_types;
+    }
+};
+
+struct LocalScoreKeyHash {
+    std::size_t operator()(const LocalScoreKey& key) const;
+};
+
+// Least recently used memo of local scores. All the methods can be called concurrently.
+class LocalScoreMemo {
+public:
+    LocalScoreMemo(int max_size) : m_max_size(max_size), m_map(), m_lru(), m_hits(0), m_misses(0), m_mutex() {
+        if (max_size <= 0) {
+            throw std::invalid_argument("The maximum size of the local score cache must be positive.");
+        }
+    }
+
+    std::optional<double> find(const LocalScoreKey& key);
+    void insert(LocalScoreKey&& key, double value);
+
+    int max_size() const { return m_max_size; }
+    int size() const;
+    long long hits() const;
+    long long misses() const;
+    void clear();
+
+private:
+    using MapType = std::unordered_map<LocalScoreKey, std::pair<double, std::list<const LocalScoreKey*>::iterator>,
+                                       LocalScoreKeyHash>;
+
+    int m_max_size;
+    MapType m_map;
+    // Keys of m_map from the most recently used to the least recently used.
+    std::list<const LocalScoreKey*> m_lru;
+    long long m_hits;
+    long long m_misses;
+    mutable std::mutex m_mutex;
+};
+
+// Implements the Score interface on top of another score, memoizing its local scores. The wrapped score must be
+// decomposable: the local score can only depend on the variable, its node type and its parent set. The memo is kept
+// between calls, so the same object can be reused in many structure learning runs over the same data.
+template <typename BaseScore>
+class CachedScoreAdaptator : public BaseScore {
+public:
+    CachedScoreAdaptator(std::shared_ptr<BaseScore> score, int max_size) : m_score(score), m_memo(max_size) {
+        if (!m_score) {
+            throw std::invalid_argument("The cached score cannot be null.");
+        }
+    }
+
+    using BaseScore::local_score;
+
+    double local_score(const BayesianNetworkBase& model,
+                       const std::string& variable,
+                       const std::vector<std::string>& parents) const override {
+        return cached(make_key(model, model.node_type(variable), false, false, variable, parents),
+                      [&]() { return m_score->local_score(model, variable, parents); });
+    }
+
+    double local_score(const BayesianNetworkBase& model,
+                       const std::shared_ptr<FactorType>& node_type,
+                       const std::string& variable,
+                       const std::vector<std::string>& parents) const override {
+        return cached(make_key(model, node_type, true, false, variable, parents),
+                      [&]() { return m_score->local_score(model, node_type, variable, parents); });
+    }
+
+    LocalScoreBound local_score_bound(const BayesianNetworkBase& model,
+                                      const std::string& variable,
+                                      const std::vector<std::string>& parents,
+                                      double threshold) const override {
+        return cached_bound(make_key(model, model.node_type(variable), false, false, variable, parents),
+                            [&]() { return m_score->local_score_bound(model, variable, parents, threshold); });
+    }
+
+    LocalScoreBound local_score_bound(const BayesianNetworkBase& model,
+                                      const std::shared_ptr<FactorType>& node_type,
+                                      const std::string& variable,
+                                      const std::vector<std::string>& parents,
+                                      double threshold) const override {
+        return cached_bound(make_key(model, node_type, true, false, variable, parents), [&]() {
+            return m_score->local_score_bound(model, node_type, variable, parents, threshold);
+        });
+    }
+
+    std::string ToString() const override { return "CachedScore(" + m_score->ToString() + ")"; }
+    bool has_variables(const std::string& name) const override { return m_score->has_variables(name); }
+    bool has_variables(const std::vector<std::string>& cols) const override { return m_score->has_variables(cols); }
+    bool compatible_bn(const BayesianNetworkBase& model) const override { return m_score->compatible_bn(model); }
+    bool compatible_bn(const ConditionalBayesianNetworkBase& model) const override {
+        return m_score->compatible_bn(model);
+    }
+    DataFrame data() const override { return m_score->data(); }
+    bool is_thread_safe() const override { return m_score->is_thread_safe(); }
+
+    const std::shared_ptr<BaseScore>& base_score() const { return m_score; }
+    LocalScoreMemo& memo() { return m_memo; }
+    const LocalScoreMemo& memo() const { return m_memo; }
+
+protected:
+    static LocalScoreKey make_key(const BayesianNetworkBase& model,
+                                  const std::shared_ptr<FactorType>& node_type,
+                                  bool explicit_type,
+                                  bool validation,
+                                  const std::string& variable,
+                                  const std::vector<std::string>& parents) {
+        LocalScoreKey key{variable, node_type->hash(), explicit_type, validation, parents, {}};
+        std::sort(key.parents.begin(), key.parents.end());
+
+        key.parent_types.reserve(key.parents.size());
+        for (const auto& p : key.parents) {
+            key.parent_types.push_back(model.node_type(p)->hash());
+        }
+
+        return key;
+    }
+
+    // The local score is computed without holding the lock, so different threads can compute local scores
+    // concurrently. If two threads compute the same local score, both store the same value.
+    template <typename F>
+    double cached(LocalScoreKey&& key, F&& compute) const {
+        if (auto value = m_memo.find(key)) {
+            return *value;
+        }
+
+        double value = compute();
+        m_memo.insert(std::move(key), value);
+        return value;
+    }
+
+    // As cached(), but the bounds of the abandoned local scores are not stored.
+    template <typename F>
+    LocalScoreBound cached_bound(LocalScoreKey&& key, F&& compute) const {
+        if (auto value = m_memo.find(key)) {
+            return LocalScoreBound{*value, true};
+        }
+
+        auto bound = compute();
+        if (bound.exact) m_memo.insert(std::move(key), bound.value);
+        return bound;
+    }
+
+    std::shared_ptr<BaseScore> m_score;
+    mutable LocalScoreMemo m_memo;
+};
+
+class CachedScore : public CachedScoreAdaptator<Score> {
+public:
+    CachedScore(std::shared_ptr<Score> score, int max_size = 100000) : CachedScoreAdaptator<Score>(score, max_size) {}
+};
+
+class CachedValidatedScore : public CachedScoreAdaptator<ValidatedScore> {
+public:
+    CachedValidatedScore(std::shared_ptr<ValidatedScore> score, int max_size = 100000)
+        : CachedScoreAdaptator<ValidatedScore>(score, max_size) {}
+
+    using ValidatedScore::vlocal_score;
+
+    double vlocal_score(const BayesianNetworkBase& model,
+                        const std::string& variable,
+                        const std::vector<std::string>& parents) const override {
+        return cached(make_key(model, model.node_type(variable), false, true, variable, parents),
+                      [&]() { return m_score->vlocal_score(model, variable, parents); });
+    }
+
+    double vlocal_score(const BayesianNetworkBase& model,
+                        const std::shared_ptr<FactorType>& node_type,
+                        const std::string& variable,
+                        const std::vector<std::string>& parents) const override {
+        return cached(make_key(model, node_type, true, true, variable, parents),
+                      [&]() { return m_score->vlocal_score(model, node_type, variable, parents); });
+    }
+};
+
+}  // namespace learning::scores
+
+#endif  // PYBNESIAN_LEARNING_SCORES_CACHED_SCORE_HPP
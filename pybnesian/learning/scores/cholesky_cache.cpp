@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <learning/scores/cholesky_cache.hpp>
+
+using Eigen::VectorXd;
+
+namespace learning::scores {
+
+std::optional<CholeskyFactor> CholeskyFactor::compute(const std::vector<int>& indices, const MatrixEntry& entry) {
+    auto p = static_cast<int>(indices.size());
+    if (p == 0) return CholeskyFactor(indices, MatrixXd(0, 0));
+
+    MatrixXd block(p, p);
+    for (auto i = 0; i < p; ++i) {
+        for (auto j = 0; j <= i; ++j) {
+            block(i, j) = block(j, i) = entry(indices[i], indices[j]);
+        }
+    }
+
+    Eigen::LLT<MatrixXd> llt(block);
+    if (llt.info() != Eigen::Success) return std::nullopt;
+
+    MatrixXd L = llt.matrixL();
+    if ((L.diagonal().array() <= 0).any()) return std::nullopt;
+
+    return CholeskyFactor(indices, std::move(L));
+}
+
+std::optional<CholeskyFactor> CholeskyFactor::add(int index, const MatrixEntry& entry) const {
+    auto p = static_cast<int>(m_indices.size());
+
+    VectorXd b(p);
+    for (auto i = 0; i < p; ++i) {
+        b(i) = entry(m_indices[i], index);
+    }
+
+    VectorXd l = m_L.triangularView<Eigen::Lower>().solve(b);
+    // Schur complement of the new index.
+    double d2 = entry(index, index) - l.squaredNorm();
+    if (!(d2 > 0)) return std::nullopt;
+
+    MatrixXd L = MatrixXd::Zero(p + 1, p + 1);
+    L.topLeftCorner(p, p) = m_L;
+    L.row(p).head(p) = l.transpose();
+    L(p, p) = std::sqrt(d2);
+
+    auto indices = m_indices;
+    indices.push_back(index);
+    return CholeskyFactor(std::move(indices), std::move(L));
+}
+
+CholeskyFactor CholeskyFactor::remove(int position) const {
+    auto p = static_cast<int>(m_indices.size());
+    auto k = position;
+    auto m = p - k - 1;
+
+    // Removing the row and column k leaves the leading and trailing blocks. The trailing block L33 satisfies
+    // L33'·L33'^T = L33·L33^T + x·x^T, with x the column k of L below the diagonal.
+    MatrixXd L = MatrixXd::Zero(p - 1, p - 1);
+    L.topLeftCorner(k, k) = m_L.topLeftCorner(k, k);
+    L.bottomLeftCorner(m, k) = m_L.bottomLeftCorner(m, k);
+
+    MatrixXd L33 = m_L.bottomRightCorner(m, m);
+    VectorXd x = m_L.col(k).tail(m);
+    for (auto j = 0; j < m; ++j) {
+        double r = std::hypot(L33(j, j), x(j));
+        double c = r / L33(j, j);
+        double s = x(j) / L33(j, j);
+        L33(j, j) = r;
+
+        for (auto i = j + 1; i < m; ++i) {
+            L33(i, j) = (L33(i, j) + s * x(i)) / c;
+            x(i) = c * x(i) - s * L33(i, j);
+        }
+    }
+
+    L.bottomRightCorner(m, m) = L33;
+
+    auto indices = m_indices;
+    indices.erase(indices.begin() + k);
+    return CholeskyFactor(std::move(indices), std::move(L));
+}
+
+std::optional<std::pair<double, double>> ParentsCholeskyCache::logdets(int variable,
+                                                                       const std::vector<int>& current_parents,
+                                                                       const std::vector<int>& parents,
+                                                                       int tag,
+                                                                       const MatrixEntry& entry) {
+    auto sorted_current = current_parents;
+    std::sort(sorted_current.begin(), sorted_current.end());
+
+    std::shared_ptr<const CholeskyFactor> current;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_factors.find(variable);
+        if (it != m_factors.end() && it->second.tag == tag) {
+            auto cached_indices = it->second.factor->indices();
+            std::sort(cached_indices.begin(), cached_indices.end());
+            if (cached_indices == sorted_current) current = it->second.factor;
+        }
+    }
+
+    if (!current) {
+        auto factor = CholeskyFactor::compute(current_parents, entry);
+        if (!factor) return std::nullopt;
+
+        current = std::make_shared<const CholeskyFactor>(std::move(*factor));
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_factors[variable] = CachedFactor{tag, current};
+    }
+
+    auto sorted_parents = parents;
+    std::sort(sorted_parents.begin(), sorted_parents.end());
+
+    std::vector<int> added, removed;
+    std::set_difference(sorted_parents.begin(),
+                        sorted_parents.end(),
+                        sorted_current.begin(),
+                        sorted_current.end(),
+                        std::back_inserter(added));
+    std::set_difference(sorted_current.begin(),
+                        sorted_current.end(),
+                        sorted_parents.begin(),
+                        sorted_parents.end(),
+                        std::back_inserter(removed));
+
+    auto parents_factor = [&]() -> std::optional<CholeskyFactor> {
+        if (added.empty() && removed.empty()) {
+            return *current;
+        } else if (added.size() == 1 && removed.empty()) {
+            return current->add(added[0], entry);
+        } else if (added.empty() && removed.size() == 1) {
+            const auto& indices = current->indices();
+            auto position = std::find(indices.begin(), indices.end(), removed[0]) - indices.begin();
+            return current->remove(position);
+        } else {
+            return CholeskyFactor::compute(parents, entry);
+        }
+    }();
+
+    if (!parents_factor) return std::nullopt;
+
+    auto full_factor = parents_factor->add(variable, entry);
+    if (!full_factor) return std::nullopt;
+
+    return std::make_pair(parents_factor->logdet(), full_factor->logdet());
+}
+
+}  // namespace learning::scores
@@ -0,0 +1,73 @@
+#ifndef PYBNESIAN_LEARNING_SCORES_CHOLESKY_CACHE_HPP
+#define PYBNESIAN_LEARNING_SCORES_CHOLESKY_CACHE_HPP
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <Eigen/Dense>
+
+using Eigen::MatrixXd;
+
+namespace learning::scores {
+
+// Returns the entry (i, j) of a symmetric matrix M.
+using MatrixEntry = std::function<double(int, int)>;
+
+// Cholesky factor L of the block M[indices, indices] of a symmetric positive definite matrix M.
+class CholeskyFactor {
+public:
+    CholeskyFactor() : m_indices(), m_L() {}
+
+    // Returns the factor of M[indices, indices], or std::nullopt if the block is not positive definite. O(p³).
+    static std::optional<CholeskyFactor> compute(const std::vector<int>& indices, const MatrixEntry& entry);
+
+    // Returns the factor of the block with the index appended, or std::nullopt if it is not positive definite. O(p²).
+    std::optional<CholeskyFactor> add(int index, const MatrixEntry& entry) const;
+    // Returns the factor of the block without the index in the given position, using a rank-one update. O(p²).
+    CholeskyFactor remove(int position) const;
+
+    const std::vector<int>& indices() const { return m_indices; }
+    // log(det(M[indices, indices])).
+    double logdet() const { return 2 * m_L.diagonal().array().log().sum(); }
+
+private:
+    CholeskyFactor(std::vector<int> indices, MatrixXd L) : m_indices(std::move(indices)), m_L(std::move(L)) {}
+
+    std::vector<int> m_indices;
+    MatrixXd m_L;
+};
+
+// Keeps the Cholesky factor of the block of the current parents of each variable, so the log-determinants of the parent
+// sets that add or remove one parent (the parent sets evaluated by the arc operators) are computed in O(p²) instead of
+// O(p³).
+//
+// The cache is thread safe.
+class ParentsCholeskyCache {
+public:
+    ParentsCholeskyCache() : m_factors(), m_mutex() {}
+
+    // Returns log(det(M[parents, parents])) and log(det(M[parents + variable, parents + variable])), or std::nullopt if
+    // a block is not positive definite. The factors cached with a different tag are discarded, so the tag must identify
+    // the matrix M.
+    std::optional<std::pair<double, double>> logdets(int variable,
+                                                     const std::vector<int>& current_parents,
+                                                     const std::vector<int>& parents,
+                                                     int tag,
+                                                     const MatrixEntry& entry);
+
+private:
+    struct CachedFactor {
+        int tag;
+        std::shared_ptr<const CholeskyFactor> factor;
+    };
+
+    std::unordered_map<int, CachedFactor> m_factors;
+    std::mutex m_mutex;
+};
+
+}  // namespace learning::scores
+
+#endif  // PYBNESIAN_LEARNING_SCORES_CHOLESKY_CACHE_HPP
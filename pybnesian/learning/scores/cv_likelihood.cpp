@@ -1,7 +1,174 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <boost/math/distributions/normal.hpp>
+#include <factors/continuous/LinearGaussianCPD.hpp>
+#include <factors/discrete/DiscreteFactor.hpp>
+#include <factors/discrete/discrete_indices.hpp>
 #include <learning/scores/cv_likelihood.hpp>
+#include <util/parallel.hpp>
+
+using factors::continuous::LinearGaussianCPDType;
+using factors::discrete::DiscreteFactorType;
 
 namespace learning::scores {
 
+CVLikelihood::CVLikelihood(const DataFrame& df,
+                           int k,
+                           unsigned int seed,
+                           Arguments construction_args,
+                           int num_threads,
+                           std::optional<double> abandon_confidence)
+    : m_cv(df, k, seed),
+      m_arguments(construction_args),
+      m_num_threads(num_threads),
+      m_abandon_confidence(abandon_confidence),
+      m_abandon_zscore(0),
+      m_is_cached(false),
+      m_continuous_indices(),
+      m_statistics_indices(),
+      m_memo(std::make_shared<StatisticsMemo>()) {
+    if (abandon_confidence) {
+        if (*abandon_confidence <= 0 || *abandon_confidence >= 1) {
+            throw std::invalid_argument("abandon_confidence must be in the interval (0, 1).");
+        }
+
+        m_abandon_zscore = boost::math::quantile(boost::math::normal(), *abandon_confidence);
+    }
+
+    auto continuous_indices = df.continuous_columns();
+    if (continuous_indices.empty() || static_cast<int>(continuous_indices.size()) > MAX_CACHED_COLUMNS) return;
+
+    // The folds do not contain the rows with nulls, so only the data types are checked.
+    auto type_id = df.col(continuous_indices[0])->type_id();
+    if (type_id != Type::DOUBLE && type_id != Type::FLOAT) return;
+    for (auto index : continuous_indices) {
+        if (df.col(index)->type_id() != type_id) return;
+    }
+
+    m_is_cached = true;
+    m_continuous_indices = continuous_indices;
+    for (int i = 0, size = continuous_indices.size(); i < size; ++i) {
+        m_statistics_indices.insert(std::make_pair(df->column_name(continuous_indices[i]), i));
+    }
+}
+
+// Returns the fold statistics for the sorted discrete_parents, or nullptr if they would exceed MAX_CACHED_CELLS.
+std::shared_ptr<const CVLikelihood::ConfigurationStatistics> CVLikelihood::configuration_statistics(
+    const std::vector<std::string>& discrete_parents) const {
+    auto memo = m_memo;
+    {
+        std::lock_guard<std::mutex> lock(memo->mutex);
+        auto it = memo->statistics.find(discrete_parents);
+        if (it != memo->statistics.end()) return it->second;
+    }
+
+    const auto& df = m_cv.data();
+    VectorXi strides;
+    int64_t num_configurations = 1;
+    if (!discrete_parents.empty()) {
+        VectorXi cardinality;
+        std::tie(cardinality, strides) = factors::discrete::create_cardinality_strides(df, discrete_parents);
+        for (auto i = 0; i < cardinality.rows(); ++i) {
+            num_configurations *= cardinality(i);
+            if (num_configurations > MAX_CACHED_CELLS) return nullptr;
+        }
+    }
+
+    auto p = static_cast<int64_t>(m_continuous_indices.size());
+    auto cells = num_configurations * (m_cv.num_folds() + 1) * p * (p + 1);
+    {
+        std::lock_guard<std::mutex> lock(memo->mutex);
+        if (memo->cells + cells > MAX_CACHED_CELLS) return nullptr;
+    }
+
+    std::vector<int> columns(p);
+    std::iota(columns.begin(), columns.end(), 0);
+
+    std::vector<std::string> names;
+    names.reserve(p + discrete_parents.size());
+    for (auto index : m_continuous_indices) {
+        names.push_back(df->column_name(index));
+    }
+    names.insert(names.end(), discrete_parents.begin(), discrete_parents.end());
+
+    auto cv = m_cv.loc(names);
+    auto statistics = std::make_shared<ConfigurationStatistics>();
+    statistics->total.resize(num_configurations);
+    for (auto i = 0; i < cv.num_folds(); ++i) {
+        auto test_df = cv.fold(i).second;
+        statistics->folds.push_back(learning::scores::configuration_statistics(
+            test_df, columns, discrete_parents, strides, num_configurations));
+
+        for (auto j = 0; j < num_configurations; ++j) {
+            statistics->total[j] = statistics->total[j].merge(statistics->folds.back()[j]);
+        }
+    }
+
+    // The statistics are computed without holding the lock, so another thread may have stored them.
+    std::lock_guard<std::mutex> lock(memo->mutex);
+    auto [it, inserted] = memo->statistics.insert(std::make_pair(discrete_parents, statistics));
+    if (inserted) memo->cells += cells;
+    return it->second;
+}
+
+// Returns the score of a LinearGaussianCPD (a CLinearGaussianCPD if some parent is discrete) computed from the cached
+// fold statistics, or std::nullopt if some variable is not cached.
+std::optional<double> CVLikelihood::cached_lineargaussian_score(const std::string& variable,
+                                                                const std::vector<std::string>& evidence) const {
+    if (!m_is_cached) return std::nullopt;
+
+    auto it = m_statistics_indices.find(variable);
+    if (it == m_statistics_indices.end()) return std::nullopt;
+
+    // The statistics are indexed by the position of the columns in the family: the variable and then its continuous
+    // parents.
+    std::vector<int> family{it->second};
+    std::vector<std::string> discrete_parents;
+    for (const auto& e : evidence) {
+        auto it_evidence = m_statistics_indices.find(e);
+        if (it_evidence != m_statistics_indices.end()) {
+            family.push_back(it_evidence->second);
+        } else if (m_cv.data().col(e)->type_id() == Type::DICTIONARY) {
+            discrete_parents.push_back(e);
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    std::sort(discrete_parents.begin(), discrete_parents.end());
+    auto statistics = configuration_statistics(discrete_parents);
+    if (!statistics) return std::nullopt;
+
+    std::vector<int> parents(family.size() - 1);
+    std::iota(parents.begin(), parents.end(), 1);
+
+    // Only the family block of the statistics is downdated.
+    auto num_configurations = statistics->total.size();
+    std::vector<GaussianStatistics> total(num_configurations);
+    for (size_t j = 0; j < num_configurations; ++j) {
+        total[j] = statistics->total[j].block(family);
+    }
+
+    double loglik = 0;
+    std::vector<GaussianStatistics> train(num_configurations), test(num_configurations);
+    for (const auto& fold : statistics->folds) {
+        for (size_t j = 0; j < num_configurations; ++j) {
+            test[j] = fold[j].block(family);
+            train[j] = total[j].downdate(test[j]);
+        }
+
+        if (discrete_parents.empty()) {
+            auto [beta, variance] = train[0].fit_lineargaussian(0, parents);
+            loglik += test[0].slogl_lineargaussian(beta, variance, 0, parents);
+        } else {
+            loglik += clg_slogl(train, test, 0, parents);
+        }
+    }
+
+    return loglik;
+}
+
 double CVLikelihood::local_score(const BayesianNetworkBase& model,
                                  const std::string& variable,
                                  const std::vector<std::string>& evidence) const {
@@ -12,16 +179,91 @@ double CVLikelihood::local_score(const BayesianNetworkBase& model,
                                  const std::shared_ptr<FactorType>& variable_type,
                                  const std::string& variable,
                                  const std::vector<std::string>& evidence) const {
+    return fold_score(model, variable_type, variable, evidence, std::nullopt).value;
+}
+
+LocalScoreBound CVLikelihood::local_score_bound(const BayesianNetworkBase& model,
+                                                const std::string& variable,
+                                                const std::vector<std::string>& evidence,
+                                                double threshold) const {
+    return local_score_bound(model, model.underlying_node_type(m_cv.data(), variable), variable, evidence, threshold);
+}
+
+LocalScoreBound CVLikelihood::local_score_bound(const BayesianNetworkBase& model,
+                                                const std::shared_ptr<FactorType>& variable_type,
+                                                const std::string& variable,
+                                                const std::vector<std::string>& evidence,
+                                                double threshold) const {
+    return fold_score(model, variable_type, variable, evidence, threshold);
+}
+
+LocalScoreBound CVLikelihood::fold_score(const BayesianNetworkBase& model,
+                                         const std::shared_ptr<FactorType>& variable_type,
+                                         const std::string& variable,
+                                         const std::vector<std::string>& evidence,
+                                         std::optional<double> threshold) const {
+    if (*variable_type == LinearGaussianCPDType::get_ref()) {
+        if (auto loglik = cached_lineargaussian_score(variable, evidence)) return LocalScoreBound{*loglik, true};
+    }
+
     auto [args, kwargs] = m_arguments.args(variable, variable_type);
-    auto cpd = variable_type->new_factor(model, variable, evidence, args, kwargs);
+    auto cv = m_cv.loc(variable, evidence);
+    auto k = cv.num_folds();
 
-    double loglik = 0;
-    for (auto [train_df, test_df] : m_cv.loc(variable, evidence)) {
-        cpd->fit(train_df);
-        loglik += cpd->slogl(test_df);
+    // The factors are created in the calling thread, because the construction arguments are Python objects.
+    std::vector<std::shared_ptr<Factor>> cpds;
+    cpds.reserve(k);
+    for (auto i = 0; i < k; ++i) {
+        cpds.push_back(variable_type->new_factor(model, variable, evidence, args, kwargs));
     }
 
-    return loglik;
+    // Only the factors fitted on the CPU are evaluated concurrently: the KDE factors share the OpenCL kernels, and the
+    // Python factors need the GIL.
+    auto num_threads = m_num_threads;
+    if ((*variable_type != LinearGaussianCPDType::get_ref() && *variable_type != DiscreteFactorType::get_ref()) ||
+        cpds.front()->is_python_derived()) {
+        num_threads = 1;
+    }
+
+    bool nonpositive_loglik = *variable_type == DiscreteFactorType::get_ref();
+    bool can_abandon = threshold && (nonpositive_loglik || m_abandon_confidence);
+    // Without a threshold, all the folds are evaluated at once.
+    auto group_size = can_abandon ? util::resolve_num_threads(num_threads) : k;
+
+    std::vector<double> fold_loglik(k);
+    for (auto begin = 0; begin < k; begin += group_size) {
+        auto end = std::min(begin + group_size, k);
+        util::parallel_for(begin, end, num_threads, [&](int i) {
+            auto [train_df, test_df] = cv.fold(i);
+            cpds[i]->fit(train_df);
+            fold_loglik[i] = cpds[i]->slogl(test_df);
+        });
+
+        if (!can_abandon || end == k) continue;
+
+        auto partial = std::accumulate(fold_loglik.begin(), fold_loglik.begin() + end, 0.);
+        auto upper_bound = std::numeric_limits<double>::infinity();
+        if (nonpositive_loglik) upper_bound = partial;
+
+        if (m_abandon_confidence && end > 1) {
+            // The log-likelihood of each fold left is estimated with the mean and variance of the evaluated folds.
+            auto mean = partial / end;
+            double variance = 0;
+            for (auto i = 0; i < end; ++i) {
+                variance += (fold_loglik[i] - mean) * (fold_loglik[i] - mean);
+            }
+            variance /= (end - 1);
+
+            auto left = k - end;
+            upper_bound =
+                std::min(upper_bound, partial + left * mean + m_abandon_zscore * std::sqrt(variance * left));
+        }
+
+        if (upper_bound < *threshold) return LocalScoreBound{upper_bound, false};
+    }
+
+    // The folds are added in order, so the score does not depend on the number of threads.
+    return LocalScoreBound{std::accumulate(fold_loglik.begin(), fold_loglik.end(), 0.), true};
 }
 
 }  // namespace learning::scores
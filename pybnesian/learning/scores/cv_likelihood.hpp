@@ -1,7 +1,10 @@
 #ifndef PYBNESIAN_LEARNING_SCORES_CV_LIKELIHOOD_HPP
 #define PYBNESIAN_LEARNING_SCORES_CV_LIKELIHOOD_HPP
 
+#include <map>
+#include <mutex>
 #include <dataset/crossvalidation_adaptator.hpp>
+#include <learning/scores/gaussian_statistics.hpp>
 #include <learning/scores/scores.hpp>
 
 using dataset::CrossValidation;
@@ -16,8 +19,9 @@ public:
     CVLikelihood(const DataFrame& df,
                  int k = 10,
                  unsigned int seed = std::random_device{}(),
-                 Arguments construction_args = Arguments())
-        : m_cv(df, k, seed), m_arguments(construction_args) {}
+                 Arguments construction_args = Arguments(),
+                 int num_threads = 1,
+                 std::optional<double> abandon_confidence = std::nullopt);
 
     double local_score(const BayesianNetworkBase& model,
                        const std::string& variable,
@@ -28,7 +32,24 @@ public:
                        const std::string& variable,
                        const std::vector<std::string>& evidence) const override;
 
+    // The folds are evaluated in order (in groups of num_threads folds if they are evaluated concurrently), and the
+    // evaluation is abandoned when the folds left cannot lift the score above threshold. A DiscreteFactor score is
+    // abandoned when the score of the evaluated folds is lower than threshold, because the log-likelihood of discrete
+    // data is never positive. If abandon_confidence is set, any score is also abandoned when the normal upper
+    // confidence bound of the score is lower than threshold.
+    LocalScoreBound local_score_bound(const BayesianNetworkBase& model,
+                                      const std::string& variable,
+                                      const std::vector<std::string>& evidence,
+                                      double threshold) const override;
+
+    LocalScoreBound local_score_bound(const BayesianNetworkBase& model,
+                                      const std::shared_ptr<FactorType>& variable_type,
+                                      const std::string& variable,
+                                      const std::vector<std::string>& evidence,
+                                      double threshold) const override;
+
     const CrossValidation& cv() { return m_cv; }
+    std::optional<double> abandon_confidence() const { return m_abandon_confidence; }
 
     std::string ToString() const override { return "CVLikelihood"; }
 
@@ -50,8 +71,52 @@ private:
     template <typename FactorType>
     double factor_score(const std::string& variable, const std::vector<std::string>& evidence) const;
 
+    // Statistics of the continuous columns for each configuration of a set of discrete parents (a single configuration
+    // if there are no discrete parents), in each test fold and in all the folds.
+    struct ConfigurationStatistics {
+        // Indexed by fold and configuration.
+        std::vector<std::vector<GaussianStatistics>> folds;
+        std::vector<GaussianStatistics> total;
+    };
+
+    // Statistics computed by configuration_statistics(), keyed by the sorted discrete parents. The memo is shared by
+    // the copies of the score.
+    struct StatisticsMemo {
+        std::map<std::vector<std::string>, std::shared_ptr<const ConfigurationStatistics>> statistics;
+        int64_t cells = 0;
+        std::mutex mutex;
+    };
+
+    // Maximum number of continuous columns and of stored statistics values. Wider DataFrames, and the discrete parents
+    // with too many configurations, are scored by fitting the factors on the data.
+    static constexpr int MAX_CACHED_COLUMNS = 256;
+    static constexpr int64_t MAX_CACHED_CELLS = 10000000;
+
+    std::shared_ptr<const ConfigurationStatistics> configuration_statistics(
+        const std::vector<std::string>& discrete_parents) const;
+
+    std::optional<double> cached_lineargaussian_score(const std::string& variable,
+                                                      const std::vector<std::string>& evidence) const;
+
+    LocalScoreBound fold_score(const BayesianNetworkBase& model,
+                               const std::shared_ptr<FactorType>& variable_type,
+                               const std::string& variable,
+                               const std::vector<std::string>& evidence,
+                               std::optional<double> threshold) const;
+
     CrossValidation m_cv;
     Arguments m_arguments;
+    int m_num_threads;
+    std::optional<double> m_abandon_confidence;
+    // Normal quantile of m_abandon_confidence.
+    double m_abandon_zscore;
+    // If the continuous columns have no nulls, the statistics of each fold are computed the first time a
+    // LinearGaussianCPD with the same discrete parents is scored. The training statistics of a fold are the total
+    // statistics downdated with the test fold, so the score does not read the data.
+    bool m_is_cached;
+    std::vector<int> m_continuous_indices;
+    std::unordered_map<std::string, int> m_statistics_indices;
+    std::shared_ptr<StatisticsMemo> m_memo;
 };
 
 using DynamicCVLikelihood = DynamicScoreAdaptator<CVLikelihood>;
@@ -0,0 +1,259 @@
+#include <cmath>
+#include <map>
+#include <factors/discrete/discrete_indices.hpp>
+#include <learning/scores/gaussian_statistics.hpp>
+#include <util/arrow_macros.hpp>
+#include <util/math_constants.hpp>
+
+using util::pi;
+
+namespace learning::scores {
+
+GaussianStatistics::GaussianStatistics(const DataFrame& df, const std::vector<int>& columns)
+    : m_rows(df->num_rows()), m_means(), m_sse() {
+    if (!can_summarize(df, columns)) {
+        throw std::invalid_argument(
+            "Gaussian statistics can only be computed for double or float columns without nulls.");
+    }
+
+    switch (df.col(columns[0])->type_id()) {
+        case Type::DOUBLE:
+            m_means = df.means<arrow::DoubleType>(columns);
+            m_sse = std::move(*df.sse<arrow::DoubleType, false>(columns));
+            break;
+        case Type::FLOAT:
+            m_means = df.means<arrow::FloatType>(columns).template cast<double>();
+            m_sse = df.sse<arrow::FloatType, false>(columns)->template cast<double>();
+            break;
+        default:
+            throw std::invalid_argument("Wrong data type to compute Gaussian statistics.");
+    }
+}
+
+bool GaussianStatistics::can_summarize(const DataFrame& df, const std::vector<int>& columns) {
+    if (columns.empty() || df->num_rows() == 0 || df.null_count(columns) > 0) return false;
+
+    auto type_id = df.col(columns[0])->type_id();
+    if (type_id != Type::DOUBLE && type_id != Type::FLOAT) return false;
+
+    for (auto index : columns) {
+        if (df.col(index)->type_id() != type_id) return false;
+    }
+
+    return true;
+}
+
+GaussianStatistics GaussianStatistics::merge(const GaussianStatistics& other) const {
+    if (m_rows == 0) return other;
+    if (other.m_rows == 0) return *this;
+
+    auto rows = m_rows + other.m_rows;
+    VectorXd diff = m_means - other.m_means;
+
+    double n = m_rows, other_n = other.m_rows, total_n = rows;
+    VectorXd means = (n * m_means + other_n * other.m_means) / total_n;
+    MatrixXd sse = m_sse + other.m_sse + (n * other_n / total_n) * diff * diff.transpose();
+
+    return GaussianStatistics(rows, std::move(means), std::move(sse));
+}
+
+GaussianStatistics GaussianStatistics::downdate(const GaussianStatistics& subset) const {
+    auto rows = m_rows - subset.m_rows;
+    if (subset.m_rows == 0) return *this;
+    if (rows <= 0) return GaussianStatistics();
+
+    double n = m_rows, subset_n = subset.m_rows, rest_n = rows;
+    VectorXd means = (n * m_means - subset_n * subset.m_means) / rest_n;
+    VectorXd diff = means - subset.m_means;
+    MatrixXd sse = m_sse - subset.m_sse - (rest_n * subset_n / n) * diff * diff.transpose();
+
+    return GaussianStatistics(rows, std::move(means), std::move(sse));
+}
+
+GaussianStatistics GaussianStatistics::block(const std::vector<int>& columns) const {
+    if (m_rows == 0) return GaussianStatistics();
+
+    auto k = static_cast<int>(columns.size());
+    VectorXd means(k);
+    MatrixXd sse(k, k);
+    for (auto i = 0; i < k; ++i) {
+        means(i) = m_means(columns[i]);
+        for (auto j = 0; j < k; ++j) {
+            sse(i, j) = m_sse(columns[i], columns[j]);
+        }
+    }
+
+    return GaussianStatistics(m_rows, std::move(means), std::move(sse));
+}
+
+std::pair<VectorXd, double> GaussianStatistics::fit_lineargaussian(int variable,
+                                                                   const std::vector<int>& parents) const {
+    auto k = static_cast<int>(parents.size());
+
+    MatrixXd sse_xx(k, k);
+    VectorXd sse_xy(k);
+    VectorXd means_x(k);
+    for (auto i = 0; i < k; ++i) {
+        sse_xy(i) = m_sse(parents[i], variable);
+        means_x(i) = m_means(parents[i]);
+        for (auto j = 0; j < k; ++j) {
+            sse_xx(i, j) = m_sse(parents[i], parents[j]);
+        }
+    }
+
+    VectorXd beta(k + 1);
+    double rss = m_sse(variable, variable);
+
+    if (k > 0) {
+        // LDLT uses the pseudo-inverse of singular matrices, so collinear parents are handled as MLE does.
+        VectorXd b = sse_xx.ldlt().solve(sse_xy);
+        beta.tail(k) = b;
+        rss -= sse_xy.dot(b);
+    }
+
+    beta(0) = m_means(variable) - beta.tail(k).dot(means_x);
+
+    if (m_rows <= k + 1) return std::make_pair(beta, std::numeric_limits<double>::infinity());
+
+    return std::make_pair(beta, std::max(rss, 0.) / static_cast<double>(m_rows - k - 1));
+}
+
+double GaussianStatistics::slogl_lineargaussian(const VectorXd& beta,
+                                                double variance,
+                                                int variable,
+                                                const std::vector<int>& parents) const {
+    if (m_rows == 0) return 0;
+
+    auto k = static_cast<int>(parents.size());
+
+    // The residual y - beta0 - b·x equals e·(z - means_z) + c, with z = (y, x), e = (1, -b) and c the residual of the
+    // means. The centered term adds to zero over the rows, so the sum of squared residuals is e'·SSE_zz·e + rows·c².
+    std::vector<int> indices{variable};
+    indices.insert(indices.end(), parents.begin(), parents.end());
+
+    VectorXd e(k + 1);
+    e(0) = 1;
+    e.tail(k) = -beta.tail(k);
+
+    double c = m_means(variable) - beta(0);
+    double quad = 0;
+    for (auto i = 0; i <= k; ++i) {
+        if (i > 0) c -= beta(i) * m_means(indices[i]);
+        for (auto j = 0; j <= k; ++j) {
+            quad += e(i) * e(j) * m_sse(indices[i], indices[j]);
+        }
+    }
+
+    double n = m_rows;
+    quad += n * c * c;
+
+    return -0.5 * quad / variance - 0.5 * n * (std::log(variance) + std::log(2 * pi<double>));
+}
+
+std::vector<GaussianStatistics> configuration_statistics(const DataFrame& df,
+                                                         const std::vector<int>& columns,
+                                                         const std::vector<std::string>& discrete_vars,
+                                                         const VectorXi& strides,
+                                                         int num_configurations) {
+    if (discrete_vars.empty()) {
+        if (df->num_rows() == 0) return {GaussianStatistics()};
+        return {GaussianStatistics(df, columns)};
+    }
+
+    std::vector<GaussianStatistics> res(num_configurations);
+    auto slices = factors::discrete::discrete_slice_indices(df, discrete_vars, strides, num_configurations);
+    for (auto i = 0; i < num_configurations; ++i) {
+        if (slices[i]) res[i] = GaussianStatistics(df.take(slices[i]), columns);
+    }
+
+    return res;
+}
+
+double clg_slogl(const std::vector<GaussianStatistics>& train,
+                 const std::vector<GaussianStatistics>& test,
+                 int variable,
+                 const std::vector<int>& parents) {
+    double res = 0;
+    for (size_t i = 0, size = train.size(); i < size; ++i) {
+        if (train[i].rows() == 0 || test[i].rows() == 0) continue;
+
+        auto [beta, variance] = train[i].fit_lineargaussian(variable, parents);
+        if (variance < util::machine_tol || std::isinf(variance)) continue;
+
+        res += test[i].slogl_lineargaussian(beta, variance, variable, parents);
+    }
+
+    return res;
+}
+
+std::optional<MissingPatternStatistics> MissingPatternStatistics::compute(const DataFrame& df,
+                                                                         const std::vector<int>& columns,
+                                                                         int max_patterns) {
+    if (columns.empty()) return std::nullopt;
+
+    auto type_id = df.col(columns[0])->type_id();
+    if (type_id != Type::DOUBLE && type_id != Type::FLOAT) return std::nullopt;
+    for (auto index : columns) {
+        if (df.col(index)->type_id() != type_id) return std::nullopt;
+    }
+
+    auto arrays = df.indices_to_columns(columns);
+    auto num_rows = df->num_rows();
+    std::map<std::vector<bool>, std::vector<int64_t>> pattern_rows;
+    std::vector<bool> observed(columns.size());
+    for (int64_t i = 0; i < num_rows; ++i) {
+        for (int j = 0, size = columns.size(); j < size; ++j) {
+            observed[j] = arrays[j]->IsValid(i);
+        }
+
+        pattern_rows[observed].push_back(i);
+        if (static_cast<int>(pattern_rows.size()) > max_patterns) return std::nullopt;
+    }
+
+    std::vector<Pattern> patterns;
+    patterns.reserve(pattern_rows.size());
+    for (const auto& [pattern, rows] : pattern_rows) {
+        std::vector<int> positions(columns.size(), -1);
+        std::vector<int> observed_columns;
+        for (int j = 0, size = columns.size(); j < size; ++j) {
+            if (pattern[j]) {
+                positions[j] = observed_columns.size();
+                observed_columns.push_back(columns[j]);
+            }
+        }
+
+        // The rows where all the columns are null are not used by any test.
+        if (observed_columns.empty()) continue;
+
+        arrow::NumericBuilder<arrow::Int64Type> builder;
+        RAISE_STATUS_ERROR(builder.AppendValues(rows));
+        Array_ptr indices;
+        RAISE_STATUS_ERROR(builder.Finish(&indices));
+
+        patterns.push_back(Pattern{std::move(positions), GaussianStatistics(df.take(indices), observed_columns)});
+    }
+
+    return MissingPatternStatistics(std::move(patterns));
+}
+
+GaussianStatistics MissingPatternStatistics::complete_statistics(const std::vector<int>& columns) const {
+    auto k = static_cast<int>(columns.size());
+
+    GaussianStatistics res;
+    std::vector<int> positions(k);
+    for (const auto& pattern : m_patterns) {
+        bool complete = true;
+        for (auto i = 0; i < k && complete; ++i) {
+            positions[i] = pattern.positions[columns[i]];
+            complete = positions[i] != -1;
+        }
+
+        if (!complete) continue;
+
+        res = res.merge(pattern.statistics.block(positions));
+    }
+
+    return res;
+}
+
+}  // namespace learning::scores
@@ -0,0 +1,105 @@
+#ifndef PYBNESIAN_LEARNING_SCORES_GAUSSIAN_STATISTICS_HPP
+#define PYBNESIAN_LEARNING_SCORES_GAUSSIAN_STATISTICS_HPP
+
+#include <optional>
+#include <Eigen/Dense>
+#include <dataset/dataset.hpp>
+
+using dataset::DataFrame;
+using Eigen::MatrixXd, Eigen::VectorXd, Eigen::VectorXi;
+
+namespace learning::scores {
+
+// Number of rows, means and sum of squared errors (SSE) matrix of a set of continuous columns. These are the
+// sufficient statistics to fit and evaluate a LinearGaussianCPD, so the cost of both operations does not depend on the
+// number of rows.
+class GaussianStatistics {
+public:
+    GaussianStatistics() : m_rows(0), m_means(), m_sse() {}
+    GaussianStatistics(int64_t rows, VectorXd means, MatrixXd sse)
+        : m_rows(rows), m_means(std::move(means)), m_sse(std::move(sse)) {}
+    // Computes the statistics of the columns of df. The columns must not contain nulls and must have the same type,
+    // double or float (see can_summarize()).
+    GaussianStatistics(const DataFrame& df, const std::vector<int>& columns);
+
+    // Returns true if the statistics of the columns can be computed.
+    static bool can_summarize(const DataFrame& df, const std::vector<int>& columns);
+
+    int64_t rows() const { return m_rows; }
+    const VectorXd& means() const { return m_means; }
+    const MatrixXd& sse() const { return m_sse; }
+
+    // Statistics of the union of the rows summarized by *this and other.
+    GaussianStatistics merge(const GaussianStatistics& other) const;
+    // Statistics of the rows summarized by *this and not by subset, which must summarize a subset of the rows of *this.
+    GaussianStatistics downdate(const GaussianStatistics& subset) const;
+    // Statistics of the given columns, indexed by their position in columns.
+    GaussianStatistics block(const std::vector<int>& columns) const;
+
+    // Fits the regression of the column variable on the columns parents as MLE<LinearGaussianCPD> does. Returns the
+    // coefficients (with the intercept first) and the variance.
+    std::pair<VectorXd, double> fit_lineargaussian(int variable, const std::vector<int>& parents) const;
+    // Returns the log-likelihood of the summarized rows under a LinearGaussianCPD of variable given parents with the
+    // given parameters.
+    double slogl_lineargaussian(const VectorXd& beta,
+                                double variance,
+                                int variable,
+                                const std::vector<int>& parents) const;
+
+private:
+    int64_t m_rows;
+    VectorXd m_means;
+    MatrixXd m_sse;
+};
+
+// Gaussian statistics of the columns of df for the rows of each configuration of the discrete columns discrete_vars,
+// indexed with strides as in factors::discrete::discrete_slice_indices(). The configurations without rows have empty
+// statistics. If discrete_vars is empty, returns the statistics of all the rows.
+std::vector<GaussianStatistics> configuration_statistics(const DataFrame& df,
+                                                         const std::vector<int>& columns,
+                                                         const std::vector<std::string>& discrete_vars,
+                                                         const VectorXi& strides,
+                                                         int num_configurations);
+
+// Returns the log-likelihood of the rows summarized by test[i] under a CLinearGaussianCPD of variable given the
+// continuous parents fitted on the rows summarized by train[i], where i is a configuration of the discrete parents. As
+// CLinearGaussianCPD::fit() does, the configurations without training rows or whose variance is zero or infinite have
+// no factor, so their test rows are ignored.
+double clg_slogl(const std::vector<GaussianStatistics>& train,
+                 const std::vector<GaussianStatistics>& test,
+                 int variable,
+                 const std::vector<int>& parents);
+
+// Gaussian statistics of the rows of each missingness pattern (the set of columns that are not null in a row) of a set
+// of continuous columns. The rows where a subset of the columns are not null (the rows used by listwise deletion) are
+// the rows of the patterns that contain the subset, so their statistics are the merge of the statistics of these
+// patterns. Thus, the cost of computing them depends on the number of patterns instead of the number of rows.
+class MissingPatternStatistics {
+public:
+    // Computes the statistics of the columns of df, which must have the same type (double or float). Returns
+    // std::nullopt if the columns do not have the same type or the rows have more than max_patterns patterns.
+    static std::optional<MissingPatternStatistics> compute(const DataFrame& df,
+                                                           const std::vector<int>& columns,
+                                                           int max_patterns);
+
+    int num_patterns() const { return static_cast<int>(m_patterns.size()); }
+
+    // Statistics of the rows where all the given columns are not null. The columns are positions in the columns passed
+    // to compute(), and the returned statistics are indexed by the position in the columns argument.
+    GaussianStatistics complete_statistics(const std::vector<int>& columns) const;
+
+private:
+    struct Pattern {
+        // Position of each column in statistics, or -1 if the column is null in the pattern.
+        std::vector<int> positions;
+        GaussianStatistics statistics;
+    };
+
+    MissingPatternStatistics(std::vector<Pattern> patterns) : m_patterns(std::move(patterns)) {}
+
+    std::vector<Pattern> m_patterns;
+};
+
+}  // namespace learning::scores
+
+#endif  // PYBNESIAN_LEARNING_SCORES_GAUSSIAN_STATISTICS_HPP
@@ -1,10 +1,133 @@
+#include <algorithm>
+#include <numeric>
+#include <factors/continuous/LinearGaussianCPD.hpp>
+#include <factors/discrete/discrete_indices.hpp>
 #include <learning/scores/holdout_likelihood.hpp>
 #include <models/BayesianNetwork.hpp>
 
+using factors::continuous::LinearGaussianCPDType;
 using models::BayesianNetworkType;
 
 namespace learning::scores {
 
+HoldoutLikelihood::HoldoutLikelihood(const DataFrame& df,
+                                     double test_ratio,
+                                     unsigned int seed,
+                                     Arguments construction_args)
+    : m_holdout(df, test_ratio, seed),
+      m_arguments(construction_args),
+      m_is_cached(false),
+      m_continuous_indices(),
+      m_statistics_indices(),
+      m_memo(std::make_shared<StatisticsMemo>()) {
+    auto continuous_indices = df.continuous_columns();
+    if (continuous_indices.empty() || static_cast<int>(continuous_indices.size()) > MAX_CACHED_COLUMNS) return;
+
+    // The training and test data do not contain the rows with nulls, so only the data types are checked.
+    auto type_id = df.col(continuous_indices[0])->type_id();
+    if (type_id != Type::DOUBLE && type_id != Type::FLOAT) return;
+    for (auto index : continuous_indices) {
+        if (df.col(index)->type_id() != type_id) return;
+    }
+
+    m_is_cached = true;
+    m_continuous_indices = continuous_indices;
+    for (int i = 0, size = continuous_indices.size(); i < size; ++i) {
+        m_statistics_indices.insert(std::make_pair(df->column_name(continuous_indices[i]), i));
+    }
+}
+
+// Returns the training and test statistics for the sorted discrete_parents, or nullptr if they would exceed
+// MAX_CACHED_CELLS.
+std::shared_ptr<const HoldoutLikelihood::ConfigurationStatistics> HoldoutLikelihood::configuration_statistics(
+    const std::vector<std::string>& discrete_parents) const {
+    auto memo = m_memo;
+    {
+        std::lock_guard<std::mutex> lock(memo->mutex);
+        auto it = memo->statistics.find(discrete_parents);
+        if (it != memo->statistics.end()) return it->second;
+    }
+
+    const auto& train_df = training_data();
+    const auto& test_df = test_data();
+    if (train_df->num_rows() == 0) return nullptr;
+
+    VectorXi strides;
+    int64_t num_configurations = 1;
+    if (!discrete_parents.empty()) {
+        VectorXi cardinality;
+        std::tie(cardinality, strides) = factors::discrete::create_cardinality_strides(train_df, discrete_parents);
+        for (auto i = 0; i < cardinality.rows(); ++i) {
+            num_configurations *= cardinality(i);
+            if (num_configurations > MAX_CACHED_CELLS) return nullptr;
+        }
+    }
+
+    auto p = static_cast<int64_t>(m_continuous_indices.size());
+    auto cells = num_configurations * 2 * p * (p + 1);
+    {
+        std::lock_guard<std::mutex> lock(memo->mutex);
+        if (memo->cells + cells > MAX_CACHED_CELLS) return nullptr;
+    }
+
+    std::vector<int> columns(m_continuous_indices.size());
+    std::iota(columns.begin(), columns.end(), 0);
+
+    std::vector<std::string> names;
+    names.reserve(p + discrete_parents.size());
+    for (auto index : m_continuous_indices) {
+        names.push_back(train_df->column_name(index));
+    }
+    names.insert(names.end(), discrete_parents.begin(), discrete_parents.end());
+
+    auto statistics = std::make_shared<ConfigurationStatistics>();
+    statistics->train = learning::scores::configuration_statistics(
+        train_df.loc(names), columns, discrete_parents, strides, num_configurations);
+    statistics->test = learning::scores::configuration_statistics(
+        test_df.loc(names), columns, discrete_parents, strides, num_configurations);
+
+    // The statistics are computed without holding the lock, so another thread may have stored them.
+    std::lock_guard<std::mutex> lock(memo->mutex);
+    auto [it, inserted] = memo->statistics.insert(std::make_pair(discrete_parents, statistics));
+    if (inserted) memo->cells += cells;
+    return it->second;
+}
+
+// Returns the score of a LinearGaussianCPD (a CLinearGaussianCPD if some parent is discrete) computed from the cached
+// statistics, or std::nullopt if some variable is not cached.
+std::optional<double> HoldoutLikelihood::cached_lineargaussian_score(const std::string& variable,
+                                                                     const std::vector<std::string>& evidence) const {
+    if (!m_is_cached) return std::nullopt;
+
+    auto it = m_statistics_indices.find(variable);
+    if (it == m_statistics_indices.end()) return std::nullopt;
+    auto var_index = it->second;
+
+    std::vector<int> evidence_indices;
+    std::vector<std::string> discrete_parents;
+    for (const auto& e : evidence) {
+        auto it_evidence = m_statistics_indices.find(e);
+        if (it_evidence != m_statistics_indices.end()) {
+            evidence_indices.push_back(it_evidence->second);
+        } else if (training_data().col(e)->type_id() == Type::DICTIONARY) {
+            discrete_parents.push_back(e);
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    std::sort(discrete_parents.begin(), discrete_parents.end());
+    auto statistics = configuration_statistics(discrete_parents);
+    if (!statistics) return std::nullopt;
+
+    if (discrete_parents.empty()) {
+        auto [beta, variance] = statistics->train[0].fit_lineargaussian(var_index, evidence_indices);
+        return statistics->test[0].slogl_lineargaussian(beta, variance, var_index, evidence_indices);
+    }
+
+    return clg_slogl(statistics->train, statistics->test, var_index, evidence_indices);
+}
+
 double HoldoutLikelihood::local_score(const BayesianNetworkBase& model,
                                       const std::string& variable,
                                       const std::vector<std::string>& evidence) const {
@@ -15,6 +138,10 @@ double HoldoutLikelihood::local_score(const BayesianNetworkBase& model,
                                       const std::shared_ptr<FactorType>& variable_type,
                                       const std::string& variable,
                                       const std::vector<std::string>& evidence) const {
+    if (*variable_type == LinearGaussianCPDType::get_ref()) {
+        if (auto loglik = cached_lineargaussian_score(variable, evidence)) return *loglik;
+    }
+
     auto [args, kwargs] = m_arguments.args(variable, variable_type);
 
     auto cpd = variable_type->new_factor(model, variable, evidence, args, kwargs);
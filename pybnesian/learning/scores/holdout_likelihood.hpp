@@ -1,9 +1,12 @@
 #ifndef PYBNESIAN_LEARNING_SCORES_HOLDOUT_LIKELIHOOD_HPP
 #define PYBNESIAN_LEARNING_SCORES_HOLDOUT_LIKELIHOOD_HPP
 
+#include <map>
+#include <mutex>
 #include <dataset/holdout_adaptator.hpp>
 #include <models/GaussianNetwork.hpp>
 #include <models/SemiparametricBN.hpp>
+#include <learning/scores/gaussian_statistics.hpp>
 #include <learning/scores/scores.hpp>
 
 using dataset::HoldOut;
@@ -17,8 +20,7 @@ public:
     HoldoutLikelihood(const DataFrame& df,
                       double test_ratio = 0.2,
                       unsigned int seed = std::random_device{}(),
-                      Arguments construction_args = Arguments())
-        : m_holdout(df, test_ratio, seed), m_arguments(construction_args) {}
+                      Arguments construction_args = Arguments());
 
     double local_score(const BayesianNetworkBase& model,
                        const std::string& variable,
@@ -56,8 +58,40 @@ private:
     template <typename FactorType>
     double factor_score(const std::string& variable, const std::vector<std::string>& evidence) const;
 
+    // Statistics of the continuous columns in the training and test data for each configuration of a set of discrete
+    // parents (a single configuration if there are no discrete parents).
+    struct ConfigurationStatistics {
+        std::vector<GaussianStatistics> train;
+        std::vector<GaussianStatistics> test;
+    };
+
+    // Statistics computed by configuration_statistics(), keyed by the sorted discrete parents. The memo is shared by
+    // the copies of the score.
+    struct StatisticsMemo {
+        std::map<std::vector<std::string>, std::shared_ptr<const ConfigurationStatistics>> statistics;
+        int64_t cells = 0;
+        std::mutex mutex;
+    };
+
+    // Maximum number of continuous columns and of stored statistics values. Wider DataFrames, and the discrete parents
+    // with too many configurations, are scored by fitting the factors on the data.
+    static constexpr int MAX_CACHED_COLUMNS = 256;
+    static constexpr int64_t MAX_CACHED_CELLS = 10000000;
+
+    std::shared_ptr<const ConfigurationStatistics> configuration_statistics(
+        const std::vector<std::string>& discrete_parents) const;
+
+    std::optional<double> cached_lineargaussian_score(const std::string& variable,
+                                                      const std::vector<std::string>& evidence) const;
+
     HoldOut m_holdout;
     Arguments m_arguments;
+    // If the continuous columns have the same type, the statistics of the training and test data are computed the
+    // first time a LinearGaussianCPD with the same discrete parents is scored, so the score does not read the data.
+    bool m_is_cached;
+    std::vector<int> m_continuous_indices;
+    std::unordered_map<std::string, int> m_statistics_indices;
+    std::shared_ptr<StatisticsMemo> m_memo;
 };
 
 template <typename FactorType>
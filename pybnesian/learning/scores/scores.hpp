@@ -11,6 +11,13 @@ using models::ConditionalBayesianNetworkBase;
 
 namespace learning::scores {
 
+// Result of Score::local_score_bound(). If exact is false, the evaluation of the local score was abandoned and value is
+// an upper bound of the local score lower than the threshold.
+struct LocalScoreBound {
+    double value;
+    bool exact;
+};
+
 class Score {
 public:
     virtual ~Score() {}
@@ -36,12 +43,33 @@ public:
                                const std::string& variable,
                                const std::vector<std::string>& parents) const = 0;
 
+    // Returns the local score, or an upper bound of the local score if the score can determine that the local score is
+    // lower than threshold before it is completely computed. Then, the bound is also lower than threshold. The operator
+    // sets use it to abandon the candidates that cannot improve the current model. By default, the local score is
+    // always computed.
+    virtual LocalScoreBound local_score_bound(const BayesianNetworkBase& model,
+                                              const std::string& variable,
+                                              const std::vector<std::string>& parents,
+                                              double) const {
+        return LocalScoreBound{local_score(model, variable, parents), true};
+    }
+    virtual LocalScoreBound local_score_bound(const BayesianNetworkBase& model,
+                                              const std::shared_ptr<FactorType>& node_type,
+                                              const std::string& variable,
+                                              const std::vector<std::string>& parents,
+                                              double) const {
+        return LocalScoreBound{local_score(model, node_type, variable, parents), true};
+    }
+
     virtual std::string ToString() const = 0;
     virtual bool has_variables(const std::string& name) const = 0;
     virtual bool has_variables(const std::vector<std::string>& cols) const = 0;
     virtual bool compatible_bn(const BayesianNetworkBase& model) const = 0;
     virtual bool compatible_bn(const ConditionalBayesianNetworkBase& model) const = 0;
     virtual DataFrame data() const = 0;
+
+    // Returns true if local_score() can be called concurrently from many threads without holding the GIL.
+    virtual bool is_thread_safe() const { return false; }
 };
 
 class ValidatedScore : public Score {
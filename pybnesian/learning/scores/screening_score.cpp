@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <random>
+#include <learning/scores/screening_score.hpp>
+#include <util/arrow_macros.hpp>
+
+namespace learning::scores {
+
+DataFrame ScreeningScore::stratified_subsample(const DataFrame& df, int num_rows, unsigned int seed) {
+    if (num_rows <= 0) {
+        throw std::invalid_argument("The number of rows of the subsample must be positive.");
+    }
+
+    auto total_rows = df->num_rows();
+    if (num_rows >= total_rows) return df;
+
+    // The stratum of each row is the index of the configuration of the discrete columns, where a null value is one
+    // more category. The columns that would overflow the configuration index are not used to stratify.
+    std::vector<int64_t> strata(total_rows, 0);
+    int64_t stride = 1;
+    for (auto index : df.discrete_columns()) {
+        auto dict = std::static_pointer_cast<arrow::DictionaryArray>(df.col(index));
+        int64_t cardinality = dict->dictionary()->length() + 1;
+        if (stride > std::numeric_limits<int64_t>::max() / cardinality) break;
+
+        for (int64_t i = 0; i < total_rows; ++i) {
+            auto value = dict->IsNull(i) ? cardinality - 1 : dict->GetValueIndex(i);
+            strata[i] += value * stride;
+        }
+
+        stride *= cardinality;
+    }
+
+    std::map<int64_t, std::vector<int64_t>> stratum_rows;
+    for (int64_t i = 0; i < total_rows; ++i) {
+        stratum_rows[strata[i]].push_back(i);
+    }
+
+    // Largest remainder allocation: each stratum receives the integer part of its proportional share of num_rows, and
+    // the rows left are given to the strata with the largest fractional parts. The strata smaller than
+    // total_rows / num_rows can receive no rows.
+    std::vector<int64_t> sizes;
+    std::vector<std::pair<double, size_t>> remainders;
+    sizes.reserve(stratum_rows.size());
+    remainders.reserve(stratum_rows.size());
+    int64_t allocated = 0;
+    for (const auto& it : stratum_rows) {
+        auto share = static_cast<double>(num_rows) * it.second.size() / total_rows;
+        auto k = static_cast<int64_t>(std::floor(share));
+        sizes.push_back(k);
+        remainders.push_back(std::make_pair(share - k, sizes.size() - 1));
+        allocated += k;
+    }
+
+    // Ties are broken by the stratum order, so the allocation only depends on the data.
+    std::stable_sort(
+        remainders.begin(), remainders.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (size_t i = 0, end = remainders.size(); i < end && allocated < num_rows; ++i, ++allocated) {
+        ++sizes[remainders[i].second];
+    }
+
+    std::mt19937 rng{seed};
+    std::vector<int64_t> sample;
+    sample.reserve(num_rows);
+    size_t stratum = 0;
+    for (auto& it : stratum_rows) {
+        auto& rows = it.second;
+        auto size = static_cast<int64_t>(rows.size());
+        auto k = std::min(sizes[stratum++], size);
+
+        // Partial Fisher-Yates shuffle: the first k rows are a sample without replacement.
+        for (int64_t j = 0; j < k; ++j) {
+            std::uniform_int_distribution<int64_t> dist(j, size - 1);
+            std::swap(rows[j], rows[dist(rng)]);
+        }
+
+        sample.insert(sample.end(), rows.begin(), rows.begin() + k);
+    }
+
+    std::sort(sample.begin(), sample.end());
+
+    arrow::NumericBuilder<arrow::Int64Type> builder;
+    RAISE_STATUS_ERROR(builder.AppendValues(sample));
+    Array_ptr indices;
+    RAISE_STATUS_ERROR(builder.Finish(&indices));
+    return df.take(indices);
+}
+
+}  // namespace learning::scores
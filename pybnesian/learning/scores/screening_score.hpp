@@ -0,0 +1,91 @@
+#ifndef PYBNESIAN_LEARNING_SCORES_SCREENING_SCORE_HPP
+#define PYBNESIAN_LEARNING_SCORES_SCREENING_SCORE_HPP
+
+#include <learning/scores/scores.hpp>
+
+using learning::scores::Score;
+
+namespace learning::scores {
+
+// Score for very large datasets, evaluated in two stages. The local scores are computed with the screening score
+// (usually on a subsample of the data), so all the operators are ranked cheaply. Before an operator is applied, the
+// hill-climbing evaluates the num_confirmations operators with the best screening delta with the exact score (usually
+// on the full data), and applies the operator with the best exact delta.
+class ScreeningScore : public Score {
+public:
+    ScreeningScore(std::shared_ptr<Score> screening, std::shared_ptr<Score> exact, int num_confirmations = 5)
+        : m_screening(screening), m_exact(exact), m_num_confirmations(num_confirmations) {
+        if (!m_screening || !m_exact) {
+            throw std::invalid_argument("The screening and exact scores cannot be null.");
+        }
+
+        if (num_confirmations <= 0) {
+            throw std::invalid_argument("The number of confirmations must be positive.");
+        }
+    }
+
+    double local_score(const BayesianNetworkBase& model,
+                       const std::string& variable,
+                       const std::vector<std::string>& parents) const override {
+        return m_screening->local_score(model, variable, parents);
+    }
+
+    double local_score(const BayesianNetworkBase& model,
+                       const std::shared_ptr<FactorType>& node_type,
+                       const std::string& variable,
+                       const std::vector<std::string>& parents) const override {
+        return m_screening->local_score(model, node_type, variable, parents);
+    }
+
+    LocalScoreBound local_score_bound(const BayesianNetworkBase& model,
+                                      const std::string& variable,
+                                      const std::vector<std::string>& parents,
+                                      double threshold) const override {
+        return m_screening->local_score_bound(model, variable, parents, threshold);
+    }
+
+    LocalScoreBound local_score_bound(const BayesianNetworkBase& model,
+                                      const std::shared_ptr<FactorType>& node_type,
+                                      const std::string& variable,
+                                      const std::vector<std::string>& parents,
+                                      double threshold) const override {
+        return m_screening->local_score_bound(model, node_type, variable, parents, threshold);
+    }
+
+    std::string ToString() const override {
+        return "ScreeningScore(" + m_screening->ToString() + ", " + m_exact->ToString() + ")";
+    }
+    bool has_variables(const std::string& name) const override {
+        return m_screening->has_variables(name) && m_exact->has_variables(name);
+    }
+    bool has_variables(const std::vector<std::string>& cols) const override {
+        return m_screening->has_variables(cols) && m_exact->has_variables(cols);
+    }
+    bool compatible_bn(const BayesianNetworkBase& model) const override {
+        return m_screening->compatible_bn(model) && m_exact->compatible_bn(model);
+    }
+    bool compatible_bn(const ConditionalBayesianNetworkBase& model) const override {
+        return m_screening->compatible_bn(model) && m_exact->compatible_bn(model);
+    }
+    DataFrame data() const override { return m_exact->data(); }
+    // The exact score is only evaluated by the calling thread.
+    bool is_thread_safe() const override { return m_screening->is_thread_safe(); }
+
+    const std::shared_ptr<Score>& screening_score() const { return m_screening; }
+    const std::shared_ptr<Score>& exact_score() const { return m_exact; }
+    int num_confirmations() const { return m_num_confirmations; }
+
+    // Returns a sample of num_rows rows of df, stratified by the joint configuration of the discrete columns. Each
+    // configuration receives a number of rows proportional to its frequency, rounded with the largest remainder method,
+    // so the rare configurations can receive no rows. The rows keep the order of df.
+    static DataFrame stratified_subsample(const DataFrame& df, int num_rows, unsigned int seed);
+
+private:
+    std::shared_ptr<Score> m_screening;
+    std::shared_ptr<Score> m_exact;
+    int m_num_confirmations;
+};
+
+}  // namespace learning::scores
+
+#endif  // PYBNESIAN_LEARNING_SCORES_SCREENING_SCORE_HPP
@@ -0,0 +1,469 @@
+#include <algorithm>
+#include <numeric>
+#include <learning/scores/sufficient_statistics.hpp>
+#include <util/arrow_macros.hpp>
+
+namespace learning::scores {
+
+// Returns the rows of df without nulls.
+DataFrame drop_null_rows(const DataFrame& df) {
+    if (df.null_count() == 0) return df;
+
+    auto combined_bitmap = df.combined_bitmap();
+    auto bitmap_data = combined_bitmap->data();
+
+    arrow::NumericBuilder<arrow::Int32Type> builder;
+    RAISE_STATUS_ERROR(builder.Reserve(util::bit_util::non_null_count(combined_bitmap, df->num_rows())));
+    for (auto i = 0; i < df->num_rows(); ++i) {
+        if (util::bit_util::GetBit(bitmap_data, i)) builder.UnsafeAppend(i);
+    }
+
+    Array_ptr indices;
+    RAISE_STATUS_ERROR(builder.Finish(&indices));
+    return df.take(indices);
+}
+
+template <typename ArrowType>
+void sum_to_configurations(std::vector<int64_t>& configurations, const Array_ptr& indices, int64_t stride) {
+    using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+    const auto* raw_values = std::static_pointer_cast<ArrayType>(indices)->raw_values();
+
+    for (size_t i = 0, end = configurations.size(); i < end; ++i) {
+        configurations[i] += static_cast<int64_t>(raw_values[i]) * stride;
+    }
+}
+
+void sum_to_configurations(std::vector<int64_t>& configurations, const Array_ptr& indices, int64_t stride) {
+    switch (indices->type_id()) {
+        case Type::INT8:
+            sum_to_configurations<arrow::Int8Type>(configurations, indices, stride);
+            break;
+        case Type::INT16:
+            sum_to_configurations<arrow::Int16Type>(configurations, indices, stride);
+            break;
+        case Type::INT32:
+            sum_to_configurations<arrow::Int32Type>(configurations, indices, stride);
+            break;
+        case Type::INT64:
+            sum_to_configurations<arrow::Int64Type>(configurations, indices, stride);
+            break;
+        default:
+            throw std::invalid_argument("Wrong indices array type of DictionaryArray.");
+    }
+}
+
+template <typename ArrowType>
+int64_t add_weighted_counts(std::unordered_map<int64_t, int64_t>& counts,
+                            const std::vector<int64_t>& configurations,
+                            const Array_ptr& weights) {
+    using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+    const auto* raw_weights = std::static_pointer_cast<ArrayType>(weights)->raw_values();
+
+    int64_t total = 0;
+    for (size_t i = 0, end = configurations.size(); i < end; ++i) {
+        auto w = static_cast<int64_t>(raw_weights[i]);
+        if (w < 0) throw std::invalid_argument("The count table contains negative counts.");
+
+        if (w > 0) {
+            counts[configurations[i]] += w;
+            total += w;
+        }
+    }
+
+    return total;
+}
+
+int64_t add_weighted_counts(std::unordered_map<int64_t, int64_t>& counts,
+                            const std::vector<int64_t>& configurations,
+                            const Array_ptr& weights) {
+    switch (weights->type_id()) {
+        case Type::INT8:
+            return add_weighted_counts<arrow::Int8Type>(counts, configurations, weights);
+        case Type::INT16:
+            return add_weighted_counts<arrow::Int16Type>(counts, configurations, weights);
+        case Type::INT32:
+            return add_weighted_counts<arrow::Int32Type>(counts, configurations, weights);
+        case Type::INT64:
+            return add_weighted_counts<arrow::Int64Type>(counts, configurations, weights);
+        case Type::UINT8:
+            return add_weighted_counts<arrow::UInt8Type>(counts, configurations, weights);
+        case Type::UINT16:
+            return add_weighted_counts<arrow::UInt16Type>(counts, configurations, weights);
+        case Type::UINT32:
+            return add_weighted_counts<arrow::UInt32Type>(counts, configurations, weights);
+        case Type::UINT64:
+            return add_weighted_counts<arrow::UInt64Type>(counts, configurations, weights);
+        default:
+            throw std::invalid_argument("The count column must have an integer data type, but it has data type \"" +
+                                        weights->type()->ToString() + "\".");
+    }
+}
+
+SufficientStatistics SufficientStatistics::from_covariance(const std::vector<std::string>& names,
+                                                           int64_t rows,
+                                                           const VectorXd& means,
+                                                           const MatrixXd& covariance) {
+    auto n = static_cast<int>(names.size());
+    if (n == 0) throw std::invalid_argument("The sufficient statistics must contain at least one variable.");
+    if (means.rows() != n || covariance.rows() != n || covariance.cols() != n) {
+        throw std::invalid_argument("The means and covariance must have the dimension of the number of variables (" +
+                                    std::to_string(n) + ").");
+    }
+    // The sample covariance is only defined with 2 or more rows, so this also rejects non-positive counts.
+    if (rows < 2) throw std::invalid_argument("The number of rows must be at least 2.");
+    if (!covariance.isApprox(covariance.transpose())) {
+        throw std::invalid_argument("The covariance matrix must be symmetric.");
+    }
+
+    SufficientStatistics statistics;
+
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    Array_vector columns;
+    for (auto i = 0; i < n; ++i) {
+        if (!statistics.m_continuous_indices.insert(std::make_pair(names[i], i)).second) {
+            throw std::invalid_argument("Variable " + names[i] + " is repeated.");
+        }
+
+        arrow::DoubleBuilder builder;
+        Array_ptr column;
+        RAISE_STATUS_ERROR(builder.Finish(&column));
+
+        fields.push_back(arrow::field(names[i], arrow::float64()));
+        columns.push_back(column);
+    }
+
+    statistics.m_df = DataFrame(arrow::RecordBatch::Make(arrow::schema(fields), 0, columns));
+    statistics.m_gaussian = GaussianStatistics(rows, means, covariance * static_cast<double>(rows - 1));
+    statistics.m_initialized = true;
+    return statistics;
+}
+
+SufficientStatistics SufficientStatistics::from_counts(const DataFrame& df,
+                                                       const std::string& count_column,
+                                                       int64_t max_configurations) {
+    if (!df.has_columns(count_column)) {
+        throw std::invalid_argument("Count column " + count_column + " not present in the DataFrame.");
+    }
+
+    if (df.col(count_column)->null_count() > 0) {
+        throw std::invalid_argument("The count column " + count_column + " contains nulls.");
+    }
+
+    std::vector<std::string> variables;
+    for (const auto& name : df.column_names()) {
+        if (name != count_column) variables.push_back(name);
+    }
+
+    auto variables_df = df.loc(variables);
+    if (variables.empty() || variables_df.discrete_columns().size() != variables.size()) {
+        throw std::invalid_argument("All the columns of a count table, except the count column, must be categorical.");
+    }
+
+    SufficientStatistics statistics({}, max_configurations);
+    statistics.initialize(variables_df);
+
+    auto complete_df = drop_null_rows(df);
+    auto configurations = statistics.configurations(complete_df.loc(variables), statistics.m_strides);
+    statistics.m_discrete_rows =
+        add_weighted_counts(statistics.m_counts, configurations, complete_df.col(count_column));
+
+    if (statistics.num_configurations() > max_configurations) {
+        throw std::invalid_argument("The count table has more than " + std::to_string(max_configurations) +
+                                    " distinct configurations.");
+    }
+
+    return statistics;
+}
+
+void SufficientStatistics::initialize(const DataFrame& df) {
+    m_df = DataFrame(df->Slice(0, 0));
+
+    auto continuous_columns = df.continuous_columns();
+    if (!continuous_columns.empty()) {
+        auto type_id = df.col(continuous_columns[0])->type_id();
+        for (auto index : continuous_columns) {
+            if (df.col(index)->type_id() != type_id || (type_id != Type::DOUBLE && type_id != Type::FLOAT)) {
+                throw std::invalid_argument(
+                    "The continuous columns must be all of type double or all of type float to compute the "
+                    "sufficient statistics.");
+            }
+        }
+
+        for (int i = 0, size = continuous_columns.size(); i < size; ++i) {
+            m_continuous_indices.insert(std::make_pair(df->column_name(continuous_columns[i]), i));
+        }
+    }
+
+    auto discrete_columns = df.discrete_columns();
+    for (int i = 0, size = discrete_columns.size(); i < size; ++i) {
+        auto dict = std::static_pointer_cast<arrow::DictionaryArray>(df.col(discrete_columns[i]));
+        m_discrete_indices.insert(std::make_pair(df->column_name(discrete_columns[i]), i));
+        m_cardinality.push_back(std::max(dict->dictionary()->length(), int64_t{1}));
+    }
+
+    if (m_family_names.empty()) {
+        int64_t stride = 1;
+        for (auto cardinality : m_cardinality) {
+            m_strides.push_back(stride);
+
+            if (stride > std::numeric_limits<int64_t>::max() / cardinality) {
+                throw std::invalid_argument(
+                    "The number of joint configurations of the discrete columns is too large to store the joint "
+                    "counts. Request the families to count.");
+            }
+
+            stride *= cardinality;
+        }
+    } else {
+        int64_t cells = 0;
+        for (const auto& family : m_family_names) {
+            std::vector<int> positions;
+            for (const auto& name : family) {
+                auto it = m_discrete_indices.find(name);
+                if (it == m_discrete_indices.end()) {
+                    throw std::invalid_argument("The family variable " + name + " is not a discrete column.");
+                }
+                positions.push_back(it->second);
+            }
+
+            std::sort(positions.begin(), positions.end());
+            positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+            m_families.push_back(empty_family(std::move(positions)));
+            cells += m_families.back().counts.rows();
+            if (cells > m_max_configurations) {
+                throw std::invalid_argument("The count tables of the families have more than " +
+                                            std::to_string(m_max_configurations) + " configurations.");
+            }
+        }
+    }
+
+    m_initialized = true;
+}
+
+SufficientStatistics::FamilyCounts SufficientStatistics::empty_family(std::vector<int> positions) const {
+    FamilyCounts family;
+    family.strides.resize(m_cardinality.size(), 0);
+
+    int64_t stride = 1;
+    for (auto p : positions) {
+        family.strides[p] = stride;
+
+        if (stride > m_max_configurations / m_cardinality[p]) {
+            throw std::invalid_argument("The count table of a family has more than " +
+                                        std::to_string(m_max_configurations) + " configurations.");
+        }
+
+        stride *= m_cardinality[p];
+    }
+
+    family.positions = std::move(positions);
+    family.counts = VectorXl::Zero(stride);
+    return family;
+}
+
+int64_t SufficientStatistics::num_configurations() const {
+    if (m_families.empty()) return m_counts.size();
+
+    int64_t cells = 0;
+    for (const auto& family : m_families) {
+        cells += family.counts.rows();
+    }
+
+    return cells;
+}
+
+void SufficientStatistics::check_schema(const DataFrame& df) const {
+    if (!df->schema()->Equals(*m_df->schema())) {
+        throw std::invalid_argument("The schema of the batch " + df->schema()->ToString() +
+                                    " is different from the schema of the dataset " + m_df->schema()->ToString() + ".");
+    }
+
+    for (const auto& it : m_discrete_indices) {
+        const auto& name = it.first;
+        auto dict = std::static_pointer_cast<arrow::DictionaryArray>(df.col(name));
+        auto expected_dict = std::static_pointer_cast<arrow::DictionaryArray>(m_df.col(name));
+
+        if (!dict->dictionary()->Equals(expected_dict->dictionary())) {
+            throw std::invalid_argument("The categories of variable " + name +
+                                        " are different from the categories of the previous batches.");
+        }
+    }
+}
+
+void SufficientStatistics::update(const DataFrame& df) {
+    if (!m_initialized)
+        initialize(df);
+    else
+        check_schema(df);
+
+    if (!m_continuous_indices.empty()) {
+        auto continuous_df = drop_null_rows(df.loc(df.continuous_columns()));
+
+        if (continuous_df->num_rows() > 0) {
+            std::vector<int> columns(m_continuous_indices.size());
+            std::iota(columns.begin(), columns.end(), 0);
+            m_gaussian = m_gaussian.merge(GaussianStatistics(continuous_df, columns));
+        }
+    }
+
+    if (!m_discrete_indices.empty()) {
+        auto discrete_df = drop_null_rows(df.loc(df.discrete_columns()));
+
+        if (m_families.empty()) {
+            add_configurations(configurations(discrete_df, m_strides));
+        } else {
+            for (auto& family : m_families) {
+                for (auto c : configurations(discrete_df, family.strides)) {
+                    ++family.counts(c);
+                }
+            }
+        }
+
+        m_discrete_rows += discrete_df->num_rows();
+        m_memo = std::make_shared<FamilyCountsMemo>();
+    }
+}
+
+std::vector<int64_t> SufficientStatistics::configurations(const DataFrame& discrete_df,
+                                                          const std::vector<int64_t>& strides) const {
+    std::vector<int64_t> configurations(discrete_df->num_rows(), 0);
+    for (int i = 0, size = discrete_df->num_columns(); i < size; ++i) {
+        if (strides[i] == 0) continue;
+        auto dict = std::static_pointer_cast<arrow::DictionaryArray>(discrete_df.col(i));
+        sum_to_configurations(configurations, dict->indices(), strides[i]);
+    }
+
+    return configurations;
+}
+
+void SufficientStatistics::add_configurations(const std::vector<int64_t>& configurations) {
+    for (auto c : configurations) {
+        ++m_counts[c];
+    }
+
+    if (static_cast<int64_t>(m_counts.size()) > m_max_configurations) {
+        throw std::invalid_argument("The discrete columns have more than " + std::to_string(m_max_configurations) +
+                                    " distinct configurations. Request the families to count.");
+    }
+}
+
+SufficientStatistics::FamilyCounts SufficientStatistics::compute_family(const std::vector<int>& positions) const {
+    auto family = empty_family(positions);
+
+    if (m_families.empty()) {
+        for (const auto& [configuration, count] : m_counts) {
+            int64_t index = 0;
+            for (auto p : positions) {
+                index += ((configuration / m_strides[p]) % m_cardinality[p]) * family.strides[p];
+            }
+
+            family.counts(index) += count;
+        }
+
+        return family;
+    }
+
+    // The smallest requested family that contains the positions.
+    const FamilyCounts* superset = nullptr;
+    for (const auto& f : m_families) {
+        if (std::includes(f.positions.begin(), f.positions.end(), positions.begin(), positions.end()) &&
+            (!superset || f.counts.rows() < superset->counts.rows())) {
+            superset = &f;
+        }
+    }
+
+    if (!superset) {
+        std::string names;
+        for (const auto& [name, p] : m_discrete_indices) {
+            if (std::binary_search(positions.begin(), positions.end(), p)) names += (names.empty() ? "" : ", ") + name;
+        }
+        throw std::invalid_argument("The counts of the variables [" + names +
+                                    "] are not contained in the families of the sufficient statistics.");
+    }
+
+    for (int64_t i = 0, size = superset->counts.rows(); i < size; ++i) {
+        auto count = superset->counts(i);
+        if (count == 0) continue;
+
+        int64_t index = 0;
+        for (auto p : positions) {
+            index += ((i / superset->strides[p]) % m_cardinality[p]) * family.strides[p];
+        }
+
+        family.counts(index) += count;
+    }
+
+    return family;
+}
+
+VectorXi SufficientStatistics::joint_counts(const std::string& variable,
+                                            const std::vector<std::string>& evidence,
+                                            const VectorXi& cardinality,
+                                            const VectorXi& strides) const {
+    std::vector<int> positions;
+    positions.reserve(evidence.size() + 1);
+
+    auto add_position = [this, &positions](const std::string& name) {
+        auto it = m_discrete_indices.find(name);
+        if (it == m_discrete_indices.end()) {
+            throw std::invalid_argument("Discrete variable " + name + " not present in the sufficient statistics.");
+        }
+        positions.push_back(it->second);
+    };
+
+    add_position(variable);
+    for (const auto& e : evidence) {
+        add_position(e);
+    }
+
+    auto key = positions;
+    std::sort(key.begin(), key.end());
+    key.erase(std::unique(key.begin(), key.end()), key.end());
+
+    // The counts of the family are computed without holding the lock, and stored if the memo is not full.
+    auto memo = m_memo;
+    const FamilyCounts* family = nullptr;
+    FamilyCounts computed;
+    {
+        std::lock_guard<std::mutex> lock(memo->mutex);
+        auto it = memo->tables.find(key);
+        if (it != memo->tables.end()) family = &it->second;
+    }
+
+    if (!family) {
+        computed = compute_family(key);
+
+        std::lock_guard<std::mutex> lock(memo->mutex);
+        auto cells = computed.counts.rows();
+        if (memo->cells + cells <= m_max_configurations) {
+            auto [it, inserted] = memo->tables.insert(std::make_pair(key, std::move(computed)));
+            if (inserted) memo->cells += cells;
+            family = &it->second;
+        } else {
+            family = &computed;
+        }
+    }
+
+    VectorXl counts = VectorXl::Zero(cardinality.prod());
+    for (int64_t i = 0, size = family->counts.rows(); i < size; ++i) {
+        auto count = family->counts(i);
+        if (count == 0) continue;
+
+        int64_t index = 0;
+        for (size_t j = 0, end = positions.size(); j < end; ++j) {
+            auto p = positions[j];
+            index += ((i / family->strides[p]) % m_cardinality[p]) * strides(j);
+        }
+
+        counts(index) += count;
+    }
+
+    if (counts.size() > 0 && counts.maxCoeff() > std::numeric_limits<int>::max()) {
+        throw std::invalid_argument("The counts of variable " + variable + " are too large to compute the score.");
+    }
+
+    return counts.template cast<int>();
+}
+
+}  // namespace learning::scores
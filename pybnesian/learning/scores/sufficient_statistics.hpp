@@ -0,0 +1,133 @@
+#ifndef PYBNESIAN_LEARNING_SCORES_SUFFICIENT_STATISTICS_HPP
+#define PYBNESIAN_LEARNING_SCORES_SUFFICIENT_STATISTICS_HPP
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <dataset/dataset.hpp>
+#include <learning/scores/gaussian_statistics.hpp>
+
+using dataset::DataFrame;
+using Eigen::VectorXi;
+
+namespace learning::scores {
+
+// Sufficient statistics of a dataset that is read in batches, so the dataset does not need to fit in memory:
+//
+// - The GaussianStatistics of the continuous columns, using the rows without nulls in the continuous columns.
+// - The counts of the discrete columns, using the rows without nulls in the discrete columns. If families is empty,
+//   the sparse joint counts of all the discrete columns are stored, so the counts of any family can be computed. Their
+//   size is the number of distinct configurations. Otherwise, a dense count table is stored for each family, so the
+//   size does not depend on the data, and only the counts of the subsets of the families can be computed.
+//
+// The number of stored counts is limited by max_configurations. The counts of each family are computed once from the
+// stored counts, and reused in the next queries of the same family.
+//
+// All the batches must have the same schema and the same categories for each discrete column.
+class SufficientStatistics {
+public:
+    SufficientStatistics(std::vector<std::vector<std::string>> families = {}, int64_t max_configurations = 10000000)
+        : m_df(),
+          m_initialized(false),
+          m_gaussian(),
+          m_continuous_indices(),
+          m_discrete_indices(),
+          m_cardinality(),
+          m_strides(),
+          m_discrete_rows(0),
+          m_max_configurations(max_configurations),
+          m_family_names(std::move(families)),
+          m_families(),
+          m_counts(),
+          m_memo(std::make_shared<FamilyCountsMemo>()) {
+        if (max_configurations <= 0) {
+            throw std::invalid_argument("The maximum number of configurations must be positive.");
+        }
+    }
+
+    // Sufficient statistics of a dataset with continuous columns names given its aggregates: the number of rows, the
+    // means and the sample covariance matrix (with denominator rows - 1).
+    static SufficientStatistics from_covariance(const std::vector<std::string>& names,
+                                                int64_t rows,
+                                                const VectorXd& means,
+                                                const MatrixXd& covariance);
+    // Sufficient statistics of a discrete dataset given as a sparse count table: each row of df is a configuration of
+    // the categorical columns, and the integer column count_column is its number of occurrences.
+    static SufficientStatistics from_counts(const DataFrame& df,
+                                            const std::string& count_column,
+                                            int64_t max_configurations = 10000000);
+
+    // Adds the rows of a batch to the statistics.
+    void update(const DataFrame& df);
+
+    // A DataFrame without rows with the schema (and categories) of the dataset.
+    const DataFrame& data() const { return m_df; }
+
+    const GaussianStatistics& gaussian_statistics() const { return m_gaussian; }
+    // Index of each continuous column in the GaussianStatistics.
+    const std::unordered_map<std::string, int>& continuous_indices() const { return m_continuous_indices; }
+
+    int64_t discrete_rows() const { return m_discrete_rows; }
+    // Number of stored counts: the distinct configurations of the joint counts, or the cells of the family tables.
+    int64_t num_configurations() const;
+    bool has_discrete(const std::string& name) const { return m_discrete_indices.count(name) > 0; }
+
+    // Returns the same result as factors::discrete::joint_counts(df, variable, evidence, cardinality, strides) on the
+    // full dataset without the rows that contain nulls in a discrete column.
+    VectorXi joint_counts(const std::string& variable,
+                          const std::vector<std::string>& evidence,
+                          const VectorXi& cardinality,
+                          const VectorXi& strides) const;
+
+private:
+    using VectorXl = Eigen::Matrix<int64_t, Eigen::Dynamic, 1>;
+
+    // Dense count table of a family of discrete columns.
+    struct FamilyCounts {
+        // Positions of the discrete columns, sorted.
+        std::vector<int> positions;
+        // Stride of each discrete column position in the table index, or 0 if the column is not in the family.
+        std::vector<int64_t> strides;
+        VectorXl counts;
+    };
+
+    // Counts of the families requested in joint_counts(), keyed by the sorted positions of their columns. The memo is
+    // shared by the copies of the statistics, and replaced when the statistics change.
+    struct FamilyCountsMemo {
+        std::map<std::vector<int>, FamilyCounts> tables;
+        int64_t cells = 0;
+        std::mutex mutex;
+    };
+
+    void initialize(const DataFrame& df);
+    void check_schema(const DataFrame& df) const;
+    FamilyCounts empty_family(std::vector<int> positions) const;
+    // Index of the configuration of each row of discrete_df, a DataFrame with the discrete columns in order and without
+    // nulls, using the given stride for each discrete column position.
+    std::vector<int64_t> configurations(const DataFrame& discrete_df, const std::vector<int64_t>& strides) const;
+    void add_configurations(const std::vector<int64_t>& configurations);
+    // Counts of the family with the given sorted positions, computed from the stored counts.
+    FamilyCounts compute_family(const std::vector<int>& positions) const;
+
+    DataFrame m_df;
+    bool m_initialized;
+
+    GaussianStatistics m_gaussian;
+    std::unordered_map<std::string, int> m_continuous_indices;
+
+    // Position of each discrete column in the configuration index of m_counts.
+    std::unordered_map<std::string, int> m_discrete_indices;
+    std::vector<int64_t> m_cardinality;
+    // Stride of each discrete column in the configuration index of m_counts. Only used if there are no families.
+    std::vector<int64_t> m_strides;
+    int64_t m_discrete_rows;
+    int64_t m_max_configurations;
+    std::vector<std::vector<std::string>> m_family_names;
+    std::vector<FamilyCounts> m_families;
+    std::unordered_map<int64_t, int64_t> m_counts;
+    std::shared_ptr<FamilyCountsMemo> m_memo;
+};
+
+}  // namespace learning::scores
+
+#endif  // PYBNESIAN_LEARNING_SCORES_SUFFICIENT_STATISTICS_HPP
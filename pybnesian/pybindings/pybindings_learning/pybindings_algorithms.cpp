@@ -28,6 +28,10 @@ public:
     void call(BayesianNetworkBase& model, Operator* new_operator, Score& score, int num_iter) const override {
         PYBIND11_OVERRIDE_PURE(void, Callback, call, model.shared_from_this(), new_operator, &score, num_iter);
     }
+
+    void report(double elapsed_time, long long score_evaluations) const override {
+        PYBIND11_OVERRIDE(void, Callback, report, elapsed_time, score_evaluations);
+    }
 };
 
 void pybindings_algorithms_callbacks(py::module& root) {
@@ -55,6 +59,17 @@ This method is called after each iteration of
 :param score: The score used in the :class:`GreedyHillClimbing <pybnesian.GreedyHillClimbing>`.
 :param iteration: Iteration number of the
                   :class:`GreedyHillClimbing <pybnesian.GreedyHillClimbing>`. It is 0 at the start.
+)doc")
+        .def("report",
+             &Callback::report,
+             py::arg("elapsed_time"),
+             py::arg("score_evaluations"),
+             R"doc(
+This method is called after each call to :func:`Callback.call` with the resources consumed by the
+:class:`GreedyHillClimbing <pybnesian.GreedyHillClimbing>`. It does nothing by default.
+
+:param elapsed_time: Elapsed time (in seconds) since the start of the search.
+:param score_evaluations: Number of local scores evaluated since the start of the search.
 )doc");
 
     py::class_<SaveModel, Callback, std::shared_ptr<SaveModel>>(root, "SaveModel", R"doc(
@@ -72,6 +87,8 @@ Initializes a :class:`SaveModel`. It saves all the models in the folder ``folder
 void pybindings_algorithms(py::module& root) {
     pybindings_algorithms_callbacks(root);
 
+    py::register_exception<learning::algorithms::BudgetExhausted>(root, "BudgetExhausted", PyExc_RuntimeError);
+
     root.def("hc",
              &learning::algorithms::hc,
              py::arg("df"),
@@ -92,6 +109,13 @@ void pybindings_algorithms(py::module& root) {
              py::arg("num_folds") = 10,
              py::arg("test_holdout_ratio") = 0.2,
              py::arg("verbose") = 0,
+             py::arg("num_threads") = 1,
+             py::arg("arc_candidates") = ArcCandidates(),
+             py::arg("batch_size") = 1,
+             py::arg("max_time") = 0,
+             py::arg("max_score_evaluations") = 0,
+             py::arg("screening_rows") = 0,
+             py::arg("num_confirmations") = 5,
              R"doc(
 Executes a greedy hill-climbing algorithm. This calls :func:`GreedyHillClimbing.estimate`.
 
@@ -105,7 +129,11 @@ Executes a greedy hill-climbing algorithm. This calls :func:`GreedyHillClimbing.
               :class:`CVLikelihood <pybnesian.CVLikelihood>`, "holdout-lik" for
               :class:`HoldoutLikelihood <pybnesian.HoldoutLikelihood>`, "validated-lik for
               :class:`ValidatedLikelihood <pybnesian.ValidatedLikelihood>`.
-:param operators: Set of operators in the search process.
+:param operators: Set of operators in the search process. The possible options are: "arcs" for
+                  :class:`ArcOperatorSet <pybnesian.ArcOperatorSet>` (or
+                  :class:`CandidateArcOperatorSet <pybnesian.CandidateArcOperatorSet>` if ``arc_candidates`` is not
+                  empty), "candidate_arcs" for :class:`CandidateArcOperatorSet <pybnesian.CandidateArcOperatorSet>`
+                  and "node_type" for :class:`ChangeNodeTypeSet <pybnesian.ChangeNodeTypeSet>`.
 :param arc_blacklist: List of arcs blacklist (forbidden arcs).
 :param arc_whitelist: List of arcs whitelist (forced arcs).
 :param type_blacklist: List of type blacklist (forbidden :class:`FactorType <pybnesian.FactorType>`).
@@ -123,9 +151,83 @@ Executes a greedy hill-climbing algorithm. This calls :func:`GreedyHillClimbing.
 :param test_holdout_ratio: Parameter for the :class:`HoldoutLikelihood <pybnesian.HoldoutLikelihood>`
                            and :class:`ValidatedLikelihood <pybnesian.ValidatedLikelihood>` scores.
 :param verbose: If True the progress will be displayed, otherwise nothing will be displayed.
+:param num_threads: Number of threads used to compute the delta scores of the operators. If it is less or equal
+                    than 0, all the hardware threads are used. The result is the same for any number of threads.
+                    Multiple threads are only used if the score is thread-safe (see
+                    :func:`Score.is_thread_safe <pybnesian.Score.is_thread_safe>`).
+:param arc_candidates: A dict with the list of candidate parents of each node. If it is not empty, the arc operators
+                       only consider the arcs from the candidate parents (see
+                       :class:`CandidateArcOperatorSet <pybnesian.CandidateArcOperatorSet>`).
+:param batch_size: Maximum number of operators applied in each iteration. See :func:`GreedyHillClimbing.estimate`.
+:param max_time: Maximum time (in seconds) of the search. See :func:`GreedyHillClimbing.estimate`.
+:param max_score_evaluations: Maximum number of local score evaluations. See :func:`GreedyHillClimbing.estimate`.
+:param screening_rows: If it is greater than 0, the operators are ranked with the score learned from a stratified
+                       subsample of ``df`` with approximately ``screening_rows`` rows, and the best operators are
+                       confirmed with the score learned from the full ``df`` (see
+                       :class:`ScreeningScore <pybnesian.ScreeningScore>`). It cannot be used with "validated-lik".
+:param num_confirmations: Number of operators confirmed with the full ``df`` in each iteration when
+                          ``screening_rows`` is greater than 0.
 :returns: The estimated Bayesian network structure.
 )doc");
 
+    root.def("hc_restarts",
+             &learning::algorithms::hc_restarts,
+             py::arg("df"),
+             py::arg("bn_type"),
+             py::arg("n_starts"),
+             py::arg("score") = std::nullopt,
+             py::arg("operators") = std::nullopt,
+             py::arg("arc_blacklist") = ArcStringVector(),
+             py::arg("arc_whitelist") = ArcStringVector(),
+             py::arg("type_blacklist") = FactorTypeVector(),
+             py::arg("type_whitelist") = FactorTypeVector(),
+             py::arg("max_indegree") = 0,
+             py::arg("max_iters") = std::numeric_limits<int>::max(),
+             py::arg("epsilon") = 0,
+             py::arg("patience") = 0,
+             py::arg("seed") = std::nullopt,
+             py::arg("num_folds") = 10,
+             py::arg("test_holdout_ratio") = 0.2,
+             py::arg("num_threads") = 1,
+             py::arg("arc_candidates") = ArcCandidates(),
+             py::arg("max_cache_size") = 100000,
+             R"doc(
+Executes a greedy hill-climbing algorithm (see :func:`hc`) from ``n_starts`` starting structures and returns the best
+learned model. The first start is the empty network and the rest are random DAGs with, on average, as many arcs as
+nodes. All the starts share a :class:`CachedScore <pybnesian.CachedScore>`, so a local score is only computed once.
+
+If the score is thread-safe (see :func:`Score.is_thread_safe <pybnesian.Score.is_thread_safe>`), the starts are
+learned concurrently. The random start ``i`` is generated with the seed ``seed + i``, so the result is the same for
+any number of threads.
+
+:param df: DataFrame used to learn a Bayesian network model.
+:param bn_type: :class:`BayesianNetworkType` of the returned model.
+:param n_starts: Number of starting structures.
+:param score: A string representing the score used to drive the search. See :func:`hc`.
+:param operators: Set of operators in the search process. See :func:`hc`.
+:param arc_blacklist: List of arcs blacklist (forbidden arcs).
+:param arc_whitelist: List of arcs whitelist (forced arcs).
+:param type_blacklist: List of type blacklist (forbidden :class:`FactorType <pybnesian.FactorType>`).
+:param type_whitelist: List of type whitelist (forced :class:`FactorType <pybnesian.FactorType>`).
+:param max_indegree: Maximum indegree allowed in the graph.
+:param max_iters: Maximum number of search iterations of each start.
+:param epsilon: Minimum delta score allowed for each operator. If the new operator is less than epsilon, the search
+                process is stopped.
+:param patience: The patience parameter (only used with
+                :class:`ValidatedScore <pybnesian.ValidatedScore>`). See `patience`_.
+:param seed: Seed of the score (if needed) and of the random starts.
+:param num_folds: Number of folds for the :class:`CVLikelihood <pybnesian.CVLikelihood>` and
+                  :class:`ValidatedLikelihood <pybnesian.ValidatedLikelihood>` scores.
+:param test_holdout_ratio: Parameter for the :class:`HoldoutLikelihood <pybnesian.HoldoutLikelihood>`
+                           and :class:`ValidatedLikelihood <pybnesian.ValidatedLikelihood>` scores.
+:param num_threads: Number of threads. If it is less or equal than 0, all the hardware threads are used.
+:param arc_candidates: A dict with the list of candidate parents of each node. See :func:`hc`.
+:param max_cache_size: Maximum number of local scores kept in the shared
+                       :class:`CachedScore <pybnesian.CachedScore>`.
+:returns: A tuple (model, scores) with the best model and the list of scores of the model learned from each start.
+          If the score is a :class:`ValidatedScore <pybnesian.ValidatedScore>`, the validation score is used.
+)doc");
+
     py::class_<GreedyHillClimbing> hc(root, "GreedyHillClimbing", R"doc(
 This class implements a greedy hill-climbing algorithm. It finds the best structure applying small local changes
 iteratively. The best operator is found using a delta score.
@@ -163,6 +265,10 @@ Initializes a :class:`GreedyHillClimbing`.
                                  int,
                                  double,
                                  int,
+                                 int,
+                                 int,
+                                 int,
+                                 double,
                                  int>(&GreedyHillClimbing::estimate<ConditionalBayesianNetworkBase>),
                py::arg("operators"),
                py::arg("score"),
@@ -176,7 +282,11 @@ Initializes a :class:`GreedyHillClimbing`.
                py::arg("max_iters") = std::numeric_limits<int>::max(),
                py::arg("epsilon") = 0,
                py::arg("patience") = 0,
-               py::arg("verbose") = 0)
+               py::arg("verbose") = 0,
+               py::arg("num_threads") = 1,
+               py::arg("batch_size") = 1,
+               py::arg("max_time") = 0,
+               py::arg("max_score_evaluations") = 0)
             .def("estimate",
                  py::overload_cast<OperatorSet&,
                                    Score&,
@@ -190,6 +300,10 @@ Initializes a :class:`GreedyHillClimbing`.
                                    int,
                                    double,
                                    int,
+                                   int,
+                                   int,
+                                   int,
+                                   double,
                                    int>(&GreedyHillClimbing::estimate<BayesianNetworkBase>),
                  py::arg("operators"),
                  py::arg("score"),
@@ -204,8 +318,12 @@ Initializes a :class:`GreedyHillClimbing`.
                  py::arg("epsilon") = 0,
                  py::arg("patience") = 0,
                  py::arg("verbose") = 0,
+                 py::arg("num_threads") = 1,
+                 py::arg("batch_size") = 1,
+                 py::arg("max_time") = 0,
+                 py::arg("max_score_evaluations") = 0,
                  R"doc(
-estimate(self: pybnesian.GreedyHillClimbing, operators: pybnesian.OperatorSet, score: pybnesian.Score, start: BayesianNetworkBase or ConditionalBayesianNetworkBase, arc_blacklist: List[Tuple[str, str]] = [], arc_whitelist: List[Tuple[str, str]] = [], type_blacklist: List[Tuple[str, pybnesian.FactorType]] = [], type_whitelist: List[Tuple[str, pybnesian.FactorType]] = [], callback: pybnesian.Callback = None, max_indegree: int = 0, max_iters: int = 2147483647, epsilon: float = 0, patience: int = 0, verbose: int = 0) -> type[start]
+estimate(self: pybnesian.GreedyHillClimbing, operators: pybnesian.OperatorSet, score: pybnesian.Score, start: BayesianNetworkBase or ConditionalBayesianNetworkBase, arc_blacklist: List[Tuple[str, str]] = [], arc_whitelist: List[Tuple[str, str]] = [], type_blacklist: List[Tuple[str, pybnesian.FactorType]] = [], type_whitelist: List[Tuple[str, pybnesian.FactorType]] = [], callback: pybnesian.Callback = None, max_indegree: int = 0, max_iters: int = 2147483647, epsilon: float = 0, patience: int = 0, verbose: int = 0, num_threads: int = 1, batch_size: int = 1, max_time: float = 0, max_score_evaluations: int = 0) -> type[start]
 
 Estimates the structure of a Bayesian network. The estimated Bayesian network is of the same type as ``start``. The set
 of operators allowed in the search is ``operators``. The delta score of each operator is evaluated using the ``score``.
@@ -229,6 +347,21 @@ There are many optional parameters that restricts to the learning process.
 :param patience: The patience parameter (only used with
                 :class:`ValidatedScore <pybnesian.ValidatedScore>`). See `patience`_.
 :param verbose: If True the progress will be displayed, otherwise nothing will be displayed.
+:param num_threads: Number of threads used to compute the delta scores of the operators. If it is less or equal
+                    than 0, all the hardware threads are used. The result is the same for any number of threads.
+                    Multiple threads are only used if the score is thread-safe (see
+                    :func:`Score.is_thread_safe <pybnesian.Score.is_thread_safe>`).
+:param batch_size: Maximum number of operators applied in each iteration. The operators are taken from
+                   :func:`OperatorSet.find_max_batch`, so they change the local score of different nodes and their
+                   delta scores are still exact when they are applied together. An operator that would create a cycle
+                   with the previous operators of the batch is not applied. A ``batch_size`` greater than 1 reduces the
+                   number of iterations, but the search path (and the result) may change.
+:param max_time: Maximum time (in seconds) of the search. If it is less or equal than 0, the time is not limited.
+                 The budgets are also checked while the delta scores of the operators are cached or updated. When a
+                 budget is exhausted, the search stops and the best model found so far is returned. The elapsed time
+                 and the number of evaluations are reported to the ``callback`` (see :func:`Callback.report`).
+:param max_score_evaluations: Maximum number of local score evaluations. If it is less or equal than 0, the number
+                              of evaluations is not limited.
 :returns: The estimated Bayesian network structure of the same type as ``start``.
 )doc");
     }
@@ -259,6 +392,7 @@ Initializes a :class:`PC`.
              py::arg("ambiguous_threshold") = 0.5,
              py::arg("allow_bidirected") = true,
              py::arg("verbose") = 0,
+             py::arg("num_threads") = 1,
              R"doc(
 Estimates the skeleton (the partially directed graph) using the PC algorithm.
 
@@ -283,6 +417,11 @@ Estimates the skeleton (the partially directed graph) using the PC algorithm.
                          order-independent while applying v-structures (as in LCPC and LMPC in [pc-stable]_). Otherwise,
                          it does not return bi-directed arcs.
 :param verbose: If True the progress will be displayed, otherwise nothing will be displayed.
+:param num_threads: Number of threads used to run the independence tests. If it is less or equal than 0, all the
+                    hardware threads are used. All the tests of a sepset size are run concurrently on the same
+                    skeleton, and the edges are removed when all the tests of the size have finished, so the result
+                    is the same for any number of threads. Multiple threads are only used if the test is thread-safe
+                    (see :func:`IndependenceTest.is_thread_safe <pybnesian.IndependenceTest.is_thread_safe>`).
 :returns: A :class:`PartiallyDirectedGraph <pybnesian.PartiallyDirectedGraph>` trained by PC that represents
           the conditional independences in ``hypot_test``.
 )doc")
@@ -300,6 +439,7 @@ Estimates the skeleton (the partially directed graph) using the PC algorithm.
              py::arg("ambiguous_threshold") = 0.5,
              py::arg("allow_bidirected") = true,
              py::arg("verbose") = 0,
+             py::arg("num_threads") = 1,
              R"doc(
 Estimates the conditional skeleton (the conditional partially directed graph) using the PC algorithm.
 
@@ -324,6 +464,11 @@ Estimates the conditional skeleton (the conditional partially directed graph) us
                          order-independent while applying v-structures (as in LCPC and LMPC in [pc-stable]_). Otherwise,
                          it does not return bi-directed arcs.
 :param verbose: If True the progress will be displayed, otherwise nothing will be displayed.
+:param num_threads: Number of threads used to run the independence tests. If it is less or equal than 0, all the
+                    hardware threads are used. All the tests of a sepset size are run concurrently on the same
+                    skeleton, and the edges are removed when all the tests of the size have finished, so the result
+                    is the same for any number of threads. Multiple threads are only used if the test is thread-safe
+                    (see :func:`IndependenceTest.is_thread_safe <pybnesian.IndependenceTest.is_thread_safe>`).
 :returns: A :class:`ConditionalPartiallyDirectedGraph <pybnesian.ConditionalPartiallyDirectedGraph>` trained by PC
           that represents the conditional independences in ``hypot_test``.
 )doc");
@@ -404,6 +549,7 @@ Initializes a :class:`MMPC`.
              py::arg("ambiguous_threshold") = 0.5,
              py::arg("allow_bidirected") = true,
              py::arg("verbose") = 0,
+             py::arg("num_threads") = 1,
              R"doc(
 Estimates the skeleton (the partially directed graph) using the MMPC algorithm.
 
@@ -423,6 +569,11 @@ Estimates the skeleton (the partially directed graph) using the MMPC algorithm.
                          order-independent while applying v-structures (as in LCPC and LMPC in [pc-stable]_). Otherwise,
                          it does not return bi-directed arcs.
 :param verbose: If True the progress will be displayed, otherwise nothing will be displayed.
+:param num_threads: Number of threads used to run the independence tests. If it is less or equal than 0, all the
+                    hardware threads are used. The forward and backward phases of each variable are run concurrently,
+                    so the result is the same for any number of threads. Multiple threads are only used if the test is
+                    thread-safe
+                    (see :func:`IndependenceTest.is_thread_safe <pybnesian.IndependenceTest.is_thread_safe>`).
 :returns: A :class:`PartiallyDirectedGraph <pybnesian.PartiallyDirectedGraph>` trained by MMPC.
 )doc")
         .def("estimate_conditional",
@@ -438,6 +589,7 @@ Estimates the skeleton (the partially directed graph) using the MMPC algorithm.
              py::arg("ambiguous_threshold") = 0.5,
              py::arg("allow_bidirected") = true,
              py::arg("verbose") = 0,
+             py::arg("num_threads") = 1,
              R"doc(
 Estimates the conditional skeleton (the conditional partially directed graph) using the MMPC algorithm.
 
@@ -457,6 +609,11 @@ Estimates the conditional skeleton (the conditional partially directed graph) us
                          order-independent while applying v-structures (as in LCPC and LMPC in [pc-stable]_). Otherwise,
                          it does not return bi-directed arcs.
 :param verbose: If True the progress will be displayed, otherwise nothing will be displayed.
+:param num_threads: Number of threads used to run the independence tests. If it is less or equal than 0, all the
+                    hardware threads are used. The forward and backward phases of each variable are run concurrently,
+                    so the result is the same for any number of threads. Multiple threads are only used if the test is
+                    thread-safe
+                    (see :func:`IndependenceTest.is_thread_safe <pybnesian.IndependenceTest.is_thread_safe>`).
 :returns: A :class:`PartiallyDirectedGraph <pybnesian.PartiallyDirectedGraph>` trained by MMPC.
 )doc");
 
@@ -486,6 +643,7 @@ This class implements Max-Min Hill-Climbing (MMHC) [mmhc]_. The MMHC algorithm f
              py::arg("patience") = 0,
              py::arg("alpha") = 0.05,
              py::arg("verbose") = 0,
+             py::arg("num_threads") = 1,
              R"doc(
 Estimates the structure of a Bayesian network. This implementation calls :class:`MMPC` and :class:`GreedyHillClimbing`
 with the set of parameters provided.
@@ -514,6 +672,9 @@ with the set of parameters provided.
                 :class:`GreedyHillClimbing`).
 :param alpha: The type I error of each independence test (for :class:`MMPC`).
 :param verbose: If True the progress will be displayed, otherwise nothing will be displayed.
+:param num_threads: Number of threads used to run the independence tests (for :class:`MMPC`) and to compute the
+                    delta scores of the operators (for :class:`GreedyHillClimbing`). If it is less or equal than 0, all
+                    the hardware threads are used. The result is the same for any number of threads.
 :returns: The Bayesian network structure learned by MMHC.
 )doc")
         .def("estimate_conditional",
@@ -537,6 +698,7 @@ with the set of parameters provided.
              py::arg("patience") = 0,
              py::arg("alpha") = 0.05,
              py::arg("verbose") = 0,
+             py::arg("num_threads") = 1,
              R"doc(
 Estimates the structure of a conditional Bayesian network. This implementation calls :class:`MMPC` and
 :class:`GreedyHillClimbing` with the set of parameters provided.
@@ -565,6 +727,9 @@ Estimates the structure of a conditional Bayesian network. This implementation c
                 :class:`GreedyHillClimbing`).
 :param alpha: The type I error of each independence test (for :class:`MMPC`).
 :param verbose: If True the progress will be displayed, otherwise nothing will be displayed.
+:param num_threads: Number of threads used to run the independence tests (for :class:`MMPC`) and to compute the
+                    delta scores of the operators (for :class:`GreedyHillClimbing`). If it is less or equal than 0, all
+                    the hardware threads are used. The result is the same for any number of threads.
 :returns: The conditional Bayesian network structure learned by MMHC.
 )doc");
 
@@ -589,6 +754,7 @@ train the static and transition components of the dynamic Bayesian network.
              py::arg("patience") = 0,
              py::arg("alpha") = 0.05,
              py::arg("verbose") = 0,
+             py::arg("num_threads") = 1,
              R"doc(
 Estimates a dynamic Bayesian network. This implementation uses :class:`MMHC` to estimate both the static and transition
 Bayesian networks. This set of parameters are provided to the functions :func:`MMHC.estimate` and
@@ -616,6 +782,9 @@ Bayesian networks. This set of parameters are provided to the functions :func:`M
                 :class:`GreedyHillClimbing`).
 :param alpha: The type I error of each independence test (for :class:`MMPC`).
 :param verbose: If True the progress will be displayed, otherwise nothing will be displayed.
+:param num_threads: Number of threads used to run the independence tests (for :class:`MMPC`) and to compute the
+                    delta scores of the operators (for :class:`GreedyHillClimbing`). If it is less or equal than 0, all
+                    the hardware threads are used. The result is the same for any number of threads.
 :returns: The dynamic Bayesian network structure learned by DMMHC.
 )doc");
 }
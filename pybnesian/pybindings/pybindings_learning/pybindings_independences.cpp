@@ -2,6 +2,7 @@
 #include <pybind11/stl.h>
 #include <pybind11/eigen.h>
 #include <learning/independences/independence.hpp>
+#include <learning/independences/cached_independence.hpp>
 #include <learning/independences/continuous/linearcorrelation.hpp>
 #include <learning/independences/continuous/mutual_information.hpp>
 #include <learning/independences/continuous/RCoT.hpp>
@@ -13,12 +14,15 @@ namespace py = pybind11;
 
 using learning::independences::IndependenceTest, learning::independences::continuous::LinearCorrelation,
     learning::independences::continuous::KMutualInformation, learning::independences::continuous::RCoT,
-    learning::independences::discrete::ChiSquare, learning::independences::hybrid::MutualInformation;
+    learning::independences::discrete::ChiSquare, learning::independences::hybrid::MutualInformation,
+    learning::independences::CachedIndependenceTest;
 
 using learning::independences::DynamicIndependenceTest, learning::independences::continuous::DynamicLinearCorrelation,
     learning::independences::continuous::DynamicKMutualInformation, learning::independences::continuous::DynamicRCoT,
     learning::independences::discrete::DynamicChiSquare, learning::independences::hybrid::DynamicMutualInformation;
 
+using learning::scores::SufficientStatistics;
+
 using util::random_seed_arg;
 
 class PyIndependenceTest : public IndependenceTest {
@@ -55,6 +59,18 @@ public:
         );
     }
 
+    std::vector<double> pvalues(const std::string& v1,
+                                const std::vector<std::string>& ys,
+                                const std::vector<std::string>& ev) const override {
+        PYBIND11_OVERRIDE(std::vector<double>, /* Return type */
+                          IndependenceTest,    /* Parent class */
+                          pvalues,             /* Name of function in C++ (must match Python name) */
+                          v1,
+                          ys,
+                          ev /* Argument(s) */
+        );
+    }
+
     int num_variables() const override {
         PYBIND11_OVERRIDE_PURE(int,              /* Return type */
                                IndependenceTest, /* Parent class */
@@ -149,6 +165,21 @@ Calculates the p-value of a multivariate conditional test of independence :math:
 :param y: A variable name.
 :param z: A list of variable names.
 :returns: The p-value of a multivariate conditional test of independence :math:`x \perp y \mid \mathbf{z}`.
+)doc")
+        .def("pvalues",
+             &IndependenceTest::pvalues,
+             py::arg("x"),
+             py::arg("ys"),
+             py::arg("z") = std::vector<std::string>(),
+             R"doc(
+Calculates the p-values of the conditional tests of independence :math:`x \perp y \mid \mathbf{z}` for each :math:`y`
+in ``ys``. All the tests share the conditioning set, so some tests compute them faster than calling :func:`pvalue` for
+each :math:`y` (e.g. :class:`LinearCorrelation` factorizes the covariance of :math:`\mathbf{z}` once).
+
+:param x: A variable name.
+:param ys: A list of variable names.
+:param z: A list of variable names. If empty (the default value), the unconditional tests are calculated.
+:returns: A list with the p-value of each test, in the order of ``ys``.
 )doc")
         .def("num_variables", &IndependenceTest::num_variables, R"doc(
 Gets the number of variables of the :class:`IndependenceTest`.
@@ -165,6 +196,12 @@ Gets the variable name of the index-th variable.
 
 :param index: Index of the variable.
 :returns: Variable name at the ``index`` position.
+)doc")
+        .def("is_thread_safe", &IndependenceTest::is_thread_safe, R"doc(
+Checks whether the p-values of this :class:`IndependenceTest` can be computed concurrently by many threads. The
+independence tests implemented in Python are never thread-safe.
+
+:returns: True if the :class:`IndependenceTest` is thread-safe, False otherwise.
 )doc");
 
     {
@@ -196,7 +233,18 @@ data.
         .def(py::init<const DataFrame&>(), py::arg("df"), R"doc(
 Initializes a :class:`LinearCorrelation` for the continuous variables in the DataFrame ``df``.
 
+Each test uses the rows of ``df`` where all the tested variables are not null. If ``df`` contains nulls, the statistics
+of the rows with each missingness pattern (the set of variables that are not null) are precomputed, so the cost of a
+test does not depend on the number of rows. If there are too many patterns, each test reads the data instead.
+
 :param df: DataFrame on which to calculate the independence tests.
+)doc")
+        .def(py::init<const std::shared_ptr<SufficientStatistics>&>(), py::arg("statistics"), R"doc(
+Initializes a :class:`LinearCorrelation` for the continuous variables in the
+:class:`SufficientStatistics <pybnesian.SufficientStatistics>` ``statistics``.
+
+:param statistics: :class:`SufficientStatistics <pybnesian.SufficientStatistics>` on which to calculate the
+    independence tests.
 )doc");
 
     py::class_<MutualInformation, IndependenceTest, std::shared_ptr<MutualInformation>>(root,
@@ -369,8 +417,73 @@ Initializes a :class:`ChiSquare` for data ``df``. This independence test is only
 It implements the Pearson's X^2 test.
 
 :param df: DataFrame on which to calculate the independence tests.
+:param num_threads: Number of threads used to count the configurations of the variables. If 0, all the available
+    hardware threads are used.
+)doc")
+        .def(py::init<const DataFrame&, int>(), py::arg("df"), py::arg("num_threads") = 1)
+        .def(py::init<const std::shared_ptr<SufficientStatistics>&>(), py::arg("statistics"), R"doc(
+Initializes a :class:`ChiSquare` for the categorical variables in the
+:class:`SufficientStatistics <pybnesian.SufficientStatistics>` ``statistics``.
+
+:param statistics: :class:`SufficientStatistics <pybnesian.SufficientStatistics>` on which to calculate the
+    independence tests.
+)doc");
+
+    py::class_<CachedIndependenceTest, IndependenceTest, std::shared_ptr<CachedIndependenceTest>>(
+        root, "CachedIndependenceTest", R"doc(
+This class memoizes the p-values of another :class:`IndependenceTest`. A test :math:`x \perp y \mid \mathbf{z}` is
+identified by the pair :math:`\{x, y\}` (the order of ``x`` and ``y`` is not relevant) and the set
+:math:`\mathbf{z}` (the order of the conditioning variables is not relevant), so the underlying test must be symmetric.
+
+The cache is kept between structure learning runs. The p-values do not depend on the significance level, so running
+:class:`PC <pybnesian.PC>` or :class:`MMPC <pybnesian.MMPC>` many times with different ``alpha`` values only executes
+each test once. Its memory is bounded: the least recently used p-values are removed when the cache is full. It can be
+used concurrently by many threads if the underlying test is thread-safe.
 )doc")
-        .def(py::init<const DataFrame&>(), py::arg("df"));
+        .def(py::init<std::shared_ptr<IndependenceTest>, int>(),
+             py::keep_alive<1, 2>(),
+             py::arg("test"),
+             py::arg("max_cache_size") = 100000,
+             R"doc(
+Initializes a :class:`CachedIndependenceTest` over ``test``.
+
+:param test: The :class:`IndependenceTest` to cache.
+:param max_cache_size: The maximum number of p-values stored in the cache.
+)doc")
+        .def_property_readonly("base_test", &CachedIndependenceTest::base_test, R"doc(
+The underlying independence test whose p-values are cached.
+)doc")
+        .def(
+            "cache_size", [](const CachedIndependenceTest& self) { return self.memo().size(); }, R"doc(
+Gets the number of p-values currently stored in the cache.
+
+:returns: The number of cached p-values.
+)doc")
+        .def(
+            "max_cache_size", [](const CachedIndependenceTest& self) { return self.memo().max_size(); }, R"doc(
+Gets the maximum number of p-values stored in the cache. When the cache is full, the least recently used p-value is
+removed.
+
+:returns: The maximum number of cached p-values.
+)doc")
+        .def(
+            "hits", [](const CachedIndependenceTest& self) { return self.memo().hits(); }, R"doc(
+Gets the number of p-value evaluations that were found in the cache since its creation or the last call to
+:func:`clear_cache`.
+
+:returns: The number of cache hits.
+)doc")
+        .def(
+            "misses", [](const CachedIndependenceTest& self) { return self.memo().misses(); }, R"doc(
+Gets the number of p-value evaluations that were not found in the cache (and were computed by the underlying test) since
+its creation or the last call to :func:`clear_cache`.
+
+:returns: The number of cache misses.
+)doc")
+        .def(
+            "clear_cache", [](CachedIndependenceTest& self) { self.memo().clear(); }, R"doc(
+Removes all the cached p-values and resets the hit/miss counters.
+)doc");
 
     py::class_<DynamicIndependenceTest, std::shared_ptr<DynamicIndependenceTest>> dynamic_indep_test(
         root, "DynamicIndependenceTest", R"doc(
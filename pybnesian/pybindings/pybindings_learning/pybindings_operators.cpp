@@ -1,6 +1,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <learning/operators/operators.hpp>
+#include <learning/algorithms/budget.hpp>
 
 namespace py = pybind11;
 
@@ -8,6 +9,32 @@ using learning::operators::Operator, learning::operators::ArcOperator, learning:
     learning::operators::RemoveArc, learning::operators::FlipArc, learning::operators::ChangeNodeType,
     learning::operators::OperatorTabuSet, learning::operators::LocalScoreCache, learning::operators::OperatorSet,
     learning::operators::ArcOperatorSet, learning::operators::ChangeNodeTypeSet, learning::operators::OperatorPool;
+using learning::operators::CandidateArcOperatorSet, learning::operators::ArcCandidates;
+using graph::PartiallyDirectedGraph, graph::UndirectedGraph;
+
+// The candidate parents of each node are its adjacent nodes in the graph.
+ArcCandidates adjacent_candidates(const PartiallyDirectedGraph& g) {
+    ArcCandidates candidates;
+    for (const auto& node : g.nodes()) {
+        auto& c = candidates[node];
+        c = g.neighbors(node);
+        auto parents = g.parents(node);
+        auto children = g.children(node);
+        c.insert(c.end(), parents.begin(), parents.end());
+        c.insert(c.end(), children.begin(), children.end());
+    }
+
+    return candidates;
+}
+
+ArcCandidates adjacent_candidates(const UndirectedGraph& g) {
+    ArcCandidates candidates;
+    for (const auto& node : g.nodes()) {
+        candidates[node] = g.neighbors(node);
+    }
+
+    return candidates;
+}
 
 void register_ArcOperators(py::module& m) {
     py::class_<AddArc, ArcOperator, std::shared_ptr<AddArc>>(m, "AddArc", R"doc(
@@ -261,6 +288,22 @@ public:
     }
 };
 
+// A BudgetExhausted raised by the score inside Python code reaches C++ as a Python exception. It is translated back, so
+// the hill-climbing ends the search cleanly.
+template <typename F>
+void rethrow_budget_exhausted(F&& f) {
+    try {
+        f();
+    } catch (py::error_already_set& e) {
+        auto t = py::module_::import("pybnesian").attr("BudgetExhausted");
+        if (e.matches(t)) {
+            throw learning::algorithms::BudgetExhausted();
+        } else {
+            throw;
+        }
+    }
+}
+
 class PyOperatorSet : public OperatorSet {
 public:
     PyOperatorSet(bool calculate_local_score = true) : m_calculate_local_score(calculate_local_score) {}
@@ -280,7 +323,7 @@ public:
                 }
             }
 
-            override(model.shared_from_this(), &score);
+            rethrow_budget_exhausted([&]() { override(model.shared_from_this(), &score); });
         } else {
             py::pybind11_fail("Tried to call pure virtual function \"OperatorSet::cache_scores\"");
         }
@@ -299,7 +342,7 @@ public:
                 }
             }
 
-            override(model.shared_from_this(), &score);
+            rethrow_budget_exhausted([&]() { override(model.shared_from_this(), &score); });
         } else {
             py::pybind11_fail("Tried to call pure virtual function \"OperatorSet::cache_scores\"");
         }
@@ -455,7 +498,7 @@ public:
         pybind11::function override = pybind11::get_override(static_cast<const OperatorSet*>(this), "update_scores");
 
         if (override) {
-            override(model.shared_from_this(), &score, changed_nodes);
+            rethrow_budget_exhausted([&]() { override(model.shared_from_this(), &score, changed_nodes); });
         } else {
             py::pybind11_fail("Tried to call pure virtual function \"OperatorSet::update_scores\"");
         }
@@ -470,7 +513,7 @@ public:
         pybind11::function override = pybind11::get_override(static_cast<const OperatorSet*>(this), "update_scores");
 
         if (override) {
-            override(model.shared_from_this(), &score, changed_nodes);
+            rethrow_budget_exhausted([&]() { override(model.shared_from_this(), &score, changed_nodes); });
         } else {
             py::pybind11_fail("Tried to call pure virtual function \"OperatorSet::update_scores\"");
         }
@@ -516,6 +559,14 @@ public:
         );
     }
 
+    void set_num_threads(int num_threads) override {
+        PYBIND11_OVERRIDE(void,            /* Return type */
+                          OperatorSet,     /* Parent class */
+                          set_num_threads, /* Name of function in C++ (must match Python name) */
+                          num_threads      /* Argument(s) */
+        );
+    }
+
     void finished() override {
         {
             pybind11::gil_scoped_acquire gil;
@@ -791,6 +842,29 @@ This method must not return an operator in the ``tabu_set`` in addition to the r
 :param model: Bayesian network model.
 :param tabu_set: Tabu set of operators.
 :returns: The best valid operator, or ``None`` if there is no valid operator.
+)doc")
+        .def(
+            "find_max_batch",
+            [](OperatorSet& self, BayesianNetworkBase& model, int max_operators, const OperatorTabuSet& tabu) {
+                return self.find_max_batch(model, tabu, max_operators);
+            },
+            py::arg("model"),
+            py::arg("max_operators"),
+            py::arg("tabu_set") = OperatorTabuSet(),
+            R"doc(
+Finds up to ``max_operators`` operators that can be applied together to the ``model``, sorted by decreasing delta
+score. The first operator is the result of :func:`OperatorSet.find_max_tabu`. The rest of the operators have positive
+delta score and do not change the local score of the nodes changed by the previous operators, so their delta scores
+are still exact after applying the previous operators. However, the operators may create a cycle when they are applied
+together.
+
+The operator sets implemented in C++ find the operators efficiently. For other operator sets, only the result of
+:func:`OperatorSet.find_max_tabu` is returned.
+
+:param model: Bayesian network model.
+:param max_operators: Maximum number of operators.
+:param tabu_set: Tabu set of operators.
+:returns: A list of operators.
 )doc")
         .def(
             "update_scores",
@@ -851,6 +925,12 @@ Sets the type blacklist (a list of :class:`FactorType` that are not allowed).
 Sets the type whitelist (a list of :class:`FactorType` that are forced).
 
 :param type_whitelist: The list of whitelisted :class:`FactorType`.
+)doc")
+        .def("set_num_threads", &OperatorSet::set_num_threads, py::arg("num_threads"), R"doc(
+Sets the number of threads used to compute the delta scores. If it is less or equal than 0, all the hardware threads
+are used. The delta scores are equal for any number of threads.
+
+:param num_threads: Number of threads.
 )doc")
         .def("finished", &OperatorSet::finished, R"doc(
 Marks the finalization of the algorithm. It clears the state of the object, so
@@ -871,6 +951,71 @@ Initializes an :class:`ArcOperatorSet` with optional sets of arc blacklists/whit
 :param blacklist: List of blacklisted arcs.
 :param whitelist: List of whitelisted arcs.
 :param max_indegree: Max indegree allowed.
+)doc");
+
+    py::class_<CandidateArcOperatorSet, OperatorSet, std::shared_ptr<CandidateArcOperatorSet>>(
+        root, "CandidateArcOperatorSet", R"doc(
+This set of operators contains the arc operators (:class:`AddArc`, :class:`RemoveArc`, :class:`FlipArc`) of the arcs
+``source`` -> ``target`` where ``source`` is a candidate parent of ``target``. The arcs of the model are always
+included in both directions, so they can be removed or flipped.
+
+Unlike :class:`ArcOperatorSet`, the memory and the number of delta scores computed grow with the number of candidates
+and not with the square of the number of nodes, so it can be used with very wide networks. The candidates can be
+obtained, for example, from the skeleton estimated by :class:`MMPC <pybnesian.MMPC>`.
+)doc")
+        .def(py::init<ArcCandidates, ArcStringVector, ArcStringVector, int>(),
+             py::arg("candidates"),
+             py::arg("blacklist") = ArcStringVector(),
+             py::arg("whitelist") = ArcStringVector(),
+             py::arg("max_indegree") = 0,
+             R"doc(
+Initializes a :class:`CandidateArcOperatorSet` with the candidate parents of each node, optional sets of arc
+blacklists/whitelists and maximum indegree.
+
+:param candidates: A dict with the list of candidate parents of each node. The nodes not in the dict have no candidate
+                   parents. It can also be a :class:`PartiallyDirectedGraph <pybnesian.PartiallyDirectedGraph>` or an
+                   :class:`UndirectedGraph <pybnesian.UndirectedGraph>`. In that case, the candidate parents of each
+                   node are its adjacent nodes.
+:param blacklist: List of blacklisted arcs.
+:param whitelist: List of whitelisted arcs.
+:param max_indegree: Max indegree allowed.
+)doc")
+        .def(py::init<>([](const PartiallyDirectedGraph& candidates,
+                           ArcStringVector blacklist,
+                           ArcStringVector whitelist,
+                           int max_indegree) {
+                 return CandidateArcOperatorSet(adjacent_candidates(candidates), blacklist, whitelist, max_indegree);
+             }),
+             py::arg("candidates"),
+             py::arg("blacklist") = ArcStringVector(),
+             py::arg("whitelist") = ArcStringVector(),
+             py::arg("max_indegree") = 0)
+        .def(py::init<>([](const UndirectedGraph& candidates,
+                           ArcStringVector blacklist,
+                           ArcStringVector whitelist,
+                           int max_indegree) {
+                 return CandidateArcOperatorSet(adjacent_candidates(candidates), blacklist, whitelist, max_indegree);
+             }),
+             py::arg("candidates"),
+             py::arg("blacklist") = ArcStringVector(),
+             py::arg("whitelist") = ArcStringVector(),
+             py::arg("max_indegree") = 0)
+        .def("arc_candidates", &CandidateArcOperatorSet::arc_candidates, R"doc(
+Gets the candidate parents of each node.
+
+:returns: A dict with the list of candidate parents of each node.
+)doc")
+        .def("set_arc_candidates", &CandidateArcOperatorSet::set_arc_candidates, py::arg("candidates"), R"doc(
+Sets the candidate parents of each node. The change is applied in the next call to
+:func:`OperatorSet.cache_scores <pybnesian.OperatorSet.cache_scores>`.
+
+:param candidates: A dict with the list of candidate parents of each node.
+)doc")
+        .def("num_candidate_arcs", &CandidateArcOperatorSet::num_candidate_arcs, R"doc(
+Gets the number of arcs scored in the last call to
+:func:`OperatorSet.cache_scores <pybnesian.OperatorSet.cache_scores>`.
+
+:returns: Number of scored arcs.
 )doc");
 
     py::class_<ChangeNodeTypeSet, OperatorSet, std::shared_ptr<ChangeNodeTypeSet>>(root, "ChangeNodeTypeSet", R"doc(
@@ -1,5 +1,6 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/eigen.h>
 #include <learning/scores/scores.hpp>
 #include <learning/scores/bic.hpp>
 #include <learning/scores/bge.hpp>
@@ -7,13 +8,17 @@
 #include <learning/scores/cv_likelihood.hpp>
 #include <learning/scores/holdout_likelihood.hpp>
 #include <learning/scores/validated_likelihood.hpp>
+#include <learning/scores/cached_score.hpp>
+#include <learning/scores/screening_score.hpp>
+#include <learning/scores/sufficient_statistics.hpp>
 #include <util/util_types.hpp>
 
 namespace py = pybind11;
 
 using learning::scores::Score, learning::scores::ValidatedScore, learning::scores::BIC, learning::scores::BGe,
     learning::scores::BDe, learning::scores::CVLikelihood, learning::scores::HoldoutLikelihood,
-    learning::scores::ValidatedLikelihood;
+    learning::scores::ValidatedLikelihood, learning::scores::CachedScore, learning::scores::CachedValidatedScore,
+    learning::scores::SufficientStatistics, learning::scores::ScreeningScore;
 
 using learning::scores::DynamicScore, learning::scores::DynamicBIC, learning::scores::DynamicBGe,
     learning::scores::DynamicBDe, learning::scores::DynamicCVLikelihood, learning::scores::DynamicHoldoutLikelihood,
@@ -121,6 +126,33 @@ distribution of ``"a"`` is a :class:`LinearGaussianCPD <pybnesian.LinearGaussian
 :param evidence: A list of parent names.
 :returns: Local score value of ``node`` in the ``model`` with ``evidence`` as parents and ``variable_type`` as
           conditional distribution.
+)doc")
+        .def(
+            "local_score_bound",
+            [](const CppClass& self,
+               const BayesianNetworkBase& m,
+               const std::string& variable,
+               const std::vector<std::string>& evidence,
+               double threshold) {
+                auto bound = self.local_score_bound(m, variable, evidence, threshold);
+                return std::make_pair(bound.value, bound.exact);
+            },
+            py::arg("model"),
+            py::arg("variable"),
+            py::arg("evidence"),
+            py::arg("threshold"),
+            R"doc(
+Returns the local score value of a node ``variable`` in the ``model`` if it had ``evidence`` as parents, or an upper
+bound of it if the score can determine that the local score is lower than ``threshold`` before computing it completely.
+The operator sets use this method to abandon the evaluation of the operators that cannot improve the model. By default,
+the local score is always computed.
+
+:param model: Bayesian network model.
+:param variable: A variable name.
+:param evidence: A list of parent names.
+:param threshold: The local score of interest.
+:returns: A tuple (value, exact). If ``exact`` is True, ``value`` is the local score. Otherwise, ``value`` is an upper
+          bound of the local score lower than ``threshold``.
 )doc")
         .def("data", &Score::data, R"doc(
 Returns the DataFrame used to calculate the score and local scores.
@@ -278,6 +310,45 @@ Returns the validated score value of the ``model``.
     }
 }
 
+template <typename CppClass, typename PyClass>
+void register_CachedScore_methods(PyClass& pyclass) {
+    pyclass
+        .def_property_readonly("base_score", &CppClass::base_score, R"doc(
+The underlying score whose local scores are cached.
+)doc")
+        .def(
+            "cache_size", [](const CppClass& self) { return self.memo().size(); }, R"doc(
+Gets the number of local scores currently stored in the cache.
+
+:returns: The number of cached local scores.
+)doc")
+        .def(
+            "max_cache_size", [](const CppClass& self) { return self.memo().max_size(); }, R"doc(
+Gets the maximum number of local scores stored in the cache. When the cache is full, the least recently used local score
+is removed.
+
+:returns: The maximum number of cached local scores.
+)doc")
+        .def(
+            "hits", [](const CppClass& self) { return self.memo().hits(); }, R"doc(
+Gets the number of local score evaluations that were found in the cache since its creation or the last call to
+:func:`clear_cache`.
+
+:returns: The number of cache hits.
+)doc")
+        .def(
+            "misses", [](const CppClass& self) { return self.memo().misses(); }, R"doc(
+Gets the number of local score evaluations that were not found in the cache (and were computed by the underlying score)
+since its creation or the last call to :func:`clear_cache`.
+
+:returns: The number of cache misses.
+)doc")
+        .def(
+            "clear_cache", [](CppClass& self) { self.memo().clear(); }, R"doc(
+Removes all the cached local scores and resets the hit/miss counters.
+)doc");
+}
+
 template <typename ScoreBase = Score>
 class PyScore : public ScoreBase {
 public:
@@ -500,6 +571,13 @@ Checks whether the ``model`` is compatible (can be used) with this :class:`Score
 )doc");
     }
 
+    score.def("is_thread_safe", &Score::is_thread_safe, R"doc(
+Checks whether the local score of this :class:`Score` can be computed concurrently by many threads. The scores
+implemented in Python are never thread-safe.
+
+:returns: True if the :class:`Score` is thread-safe, False otherwise.
+)doc");
+
     py::class_<ValidatedScore, Score, PyValidatedScore<>, std::shared_ptr<ValidatedScore>> validated_score(
         root, "ValidatedScore", R"doc(
 A :class:`ValidatedScore` is a score with training and validation scores. In a :class:`ValidatedScore`, the training
@@ -513,13 +591,147 @@ a validation likelihood (usually defined over different data) through the functi
     // register_Score_methods<ValidatedScore>(validated_score);
     register_ValidatedScore_methods<ValidatedScore>(validated_score);
 
+    py::class_<SufficientStatistics, std::shared_ptr<SufficientStatistics>>(root, "SufficientStatistics", R"doc(
+This class accumulates the sufficient statistics of a dataset that is read in batches, so the dataset does not need to
+fit in memory. The statistics are:
+
+- The number of rows, the means and the sum of squared errors matrix of the continuous variables, using the rows
+  without nulls in the continuous variables.
+- The counts of the discrete variables, using the rows without nulls in the discrete variables. By default, the joint
+  counts of all the discrete variables are stored (only the observed configurations), so the counts of any family of
+  variables can be computed. If ``families`` is given, a count table is stored for each family instead, so the memory
+  does not depend on the data, but only the counts of the subsets of the families can be computed. The number of stored
+  counts is limited by ``max_configurations``.
+
+The statistics can also be created from aggregates, without the data, with
+:func:`SufficientStatistics.from_covariance` and :func:`SufficientStatistics.from_counts`.
+
+The :class:`BIC`, :class:`BGe` and :class:`BDe` scores and the
+:class:`LinearCorrelation <pybnesian.LinearCorrelation>` and :class:`ChiSquare <pybnesian.ChiSquare>` independence
+tests can be computed from a :class:`SufficientStatistics`, so the structure learning algorithms
+(:class:`GreedyHillClimbing <pybnesian.GreedyHillClimbing>`, :class:`PC <pybnesian.PC>` and
+:class:`MMPC <pybnesian.MMPC>`) do not read the data. The conditional linear Gaussian local scores of :class:`BIC`
+require the data, so they cannot be computed from the sufficient statistics.
+)doc")
+        .def(py::init<std::vector<std::vector<std::string>>, int64_t>(),
+             py::arg("families") = std::vector<std::vector<std::string>>(),
+             py::arg("max_configurations") = 10000000,
+             R"doc(
+Initializes an empty :class:`SufficientStatistics`.
+
+:param families: Families of discrete variables to count. If empty, the joint counts of all the discrete variables are
+    stored.
+:param max_configurations: Maximum number of stored counts. If the joint counts (or the count tables of the families)
+    need more counts, a ``ValueError`` is raised.
+)doc")
+        .def(py::init([](py::iterable batches,
+                         std::vector<std::vector<std::string>> families,
+                         int64_t max_configurations) {
+                 auto statistics = std::make_shared<SufficientStatistics>(std::move(families), max_configurations);
+                 for (auto batch : batches) {
+                     statistics->update(batch.cast<DataFrame>());
+                 }
+                 return statistics;
+             }),
+             py::arg("batches"),
+             py::arg("families") = std::vector<std::vector<std::string>>(),
+             py::arg("max_configurations") = 10000000,
+             R"doc(
+Initializes a :class:`SufficientStatistics` reading all the batches of ``batches`` in a single pass.
+
+:param batches: An iterable of DataFrames. For example, a :class:`pyarrow.RecordBatchReader` that reads an Arrow IPC
+    file, or an iterator of :class:`pandas.DataFrame` chunks. All the batches must have the same schema and the same
+    categories for each discrete variable.
+:param families: Families of discrete variables to count. If empty, the joint counts of all the discrete variables are
+    stored.
+:param max_configurations: Maximum number of stored counts. If the joint counts (or the count tables of the families)
+    need more counts, a ``ValueError`` is raised.
+)doc")
+        .def_static(
+            "from_covariance",
+            [](const std::vector<std::string>& names,
+               int64_t rows,
+               const VectorXd& means,
+               const MatrixXd& covariance) {
+                return std::make_shared<SufficientStatistics>(
+                    SufficientStatistics::from_covariance(names, rows, means, covariance));
+            },
+            py::arg("names"),
+            py::arg("rows"),
+            py::arg("means"),
+            py::arg("covariance"),
+            R"doc(
+Creates the :class:`SufficientStatistics` of a continuous dataset from its aggregates, without the data.
+
+:param names: Names of the continuous variables.
+:param rows: Number of rows of the dataset.
+:param means: Means of the variables, in the order of ``names``.
+:param covariance: Sample covariance matrix (with denominator ``rows - 1``) of the variables, in the order of
+    ``names``.
+:returns: The :class:`SufficientStatistics` of the dataset.
+)doc")
+        .def_static(
+            "from_counts",
+            [](const DataFrame& df, const std::string& count_column, int64_t max_configurations) {
+                return std::make_shared<SufficientStatistics>(
+                    SufficientStatistics::from_counts(df, count_column, max_configurations));
+            },
+            py::arg("df"),
+            py::arg("count_column") = "count",
+            py::arg("max_configurations") = 10000000,
+            R"doc(
+Creates the :class:`SufficientStatistics` of a categorical dataset from a sparse count table, without the data.
+
+:param df: Count table. Each row is a configuration of the categorical columns, and ``count_column`` contains the
+    number of occurrences of the configuration. Configurations not present in the table have zero count.
+:param count_column: Name of the integer column with the counts.
+:param max_configurations: Maximum number of distinct configurations of the count table.
+:returns: The :class:`SufficientStatistics` of the dataset.
+)doc")
+        .def("update", &SufficientStatistics::update, py::arg("df"), R"doc(
+Adds the rows of a batch to the sufficient statistics.
+
+:param df: DataFrame with the batch.
+)doc")
+        .def("data", &SufficientStatistics::data, R"doc(
+Returns a DataFrame without rows with the schema of the dataset.
+
+:returns: A DataFrame with the schema of the dataset.
+)doc")
+        .def(
+            "continuous_rows",
+            [](const SufficientStatistics& self) { return self.gaussian_statistics().rows(); },
+            R"doc(
+Returns the number of rows used to compute the statistics of the continuous variables.
+
+:returns: Number of rows without nulls in the continuous variables.
+)doc")
+        .def("discrete_rows", &SufficientStatistics::discrete_rows, R"doc(
+Returns the number of rows used to compute the counts of the discrete variables.
+
+:returns: Number of rows without nulls in the discrete variables.
+)doc")
+        .def("num_configurations", &SufficientStatistics::num_configurations, R"doc(
+Returns the number of stored counts: the number of distinct configurations of the discrete variables observed in the
+data or, if ``families`` was given, the number of cells of the count tables of the families.
+
+:returns: Number of stored counts.
+)doc");
+
     py::class_<BIC, Score, std::shared_ptr<BIC>>(root, "BIC", R"doc(
 This class implements the Bayesian Information Criterion (BIC).
 )doc")
-        .def(py::init<const DataFrame&>(), py::arg("df"), R"doc(
+        .def(py::init<const DataFrame&, int>(), py::arg("df"), py::arg("num_threads") = 1, R"doc(
 Initializes a :class:`BIC` with the given DataFrame ``df``.
 
 :param df: DataFrame to compute the BIC score.
+:param num_threads: Number of threads used to count the configurations of the discrete variables. If 0, all the
+    available hardware threads are used.
+)doc")
+        .def(py::init<const std::shared_ptr<SufficientStatistics>&>(), py::arg("statistics"), R"doc(
+Initializes a :class:`BIC` with the given :class:`SufficientStatistics` ``statistics``.
+
+:param statistics: :class:`SufficientStatistics` of the data to compute the BIC score.
 )doc");
 
     py::class_<BGe, Score, std::shared_ptr<BGe>>(root, "BGe", R"doc(
@@ -537,42 +749,99 @@ Initializes a :class:`BGe` with the given DataFrame ``df``.
 :param iss_mu: Imaginary sample size for the normal component of the normal-Wishart prior.
 :param iss_w: Imaginary sample size for the Wishart component of the normal-Wishart prior.
 :param nu: Mean vector of the normal-Wishart prior.
+)doc")
+        .def(py::init<const std::shared_ptr<SufficientStatistics>&,
+                      double,
+                      std::optional<double>,
+                      std::optional<VectorXd>>(),
+             py::arg("statistics"),
+             py::arg("iss_mu") = 1,
+             py::arg("iss_w") = std::nullopt,
+             py::arg("nu") = std::nullopt,
+             R"doc(
+Initializes a :class:`BGe` with the given :class:`SufficientStatistics` ``statistics``.
+
+:param statistics: :class:`SufficientStatistics` of the data to compute the BGe score.
+:param iss_mu: Imaginary sample size for the normal component of the normal-Wishart prior.
+:param iss_w: Imaginary sample size for the Wishart component of the normal-Wishart prior.
+:param nu: Mean vector of the normal-Wishart prior.
 )doc");
 
     py::class_<BDe, Score, std::shared_ptr<BDe>>(root, "BDe", R"doc(
 This class implements the Bayesian Dirichlet equivalent (BDe).
 )doc")
-        .def(py::init<const DataFrame&, double>(),
+        .def(py::init<const DataFrame&, double, int>(),
              py::arg("df"),
              py::arg("iss") = 1,
+             py::arg("num_threads") = 1,
              R"doc(
 Initializes a :class:`BDe` with the given DataFrame ``df``.
 
 :param df: DataFrame to compute the BDe score.
 :param iss: Imaginary sample size of the Dirichlet prior.
+:param num_threads: Number of threads used to count the configurations of the variables. If 0, all the available
+    hardware threads are used.
+)doc")
+        .def(py::init<const std::shared_ptr<SufficientStatistics>&, double>(),
+             py::arg("statistics"),
+             py::arg("iss") = 1,
+             R"doc(
+Initializes a :class:`BDe` with the given :class:`SufficientStatistics` ``statistics``.
+
+:param statistics: :class:`SufficientStatistics` of the data to compute the BDe score.
+:param iss: Imaginary sample size of the Dirichlet prior.
 )doc");
 
     py::class_<CVLikelihood, Score, std::shared_ptr<CVLikelihood>>(root, "CVLikelihood", R"doc(
 This class implements an estimation of the log-likelihood on unseen data using k-fold cross validation over the data.
 )doc")
-        .def(py::init([](const DataFrame& df, int k, std::optional<unsigned int> seed, Arguments construction_args) {
-                 return CVLikelihood(df, k, random_seed_arg(seed), construction_args);
+        .def(py::init([](const DataFrame& df,
+                         int k,
+                         std::optional<unsigned int> seed,
+                         Arguments construction_args,
+                         int num_threads,
+                         std::optional<double> abandon_confidence) {
+                 return CVLikelihood(
+                     df, k, random_seed_arg(seed), construction_args, num_threads, abandon_confidence);
              }),
              py::arg("df"),
              py::arg("k") = 10,
              py::arg("seed") = std::nullopt,
              py::arg("construction_args") = Arguments(),
+             py::arg("num_threads") = 1,
+             py::arg("abandon_confidence") = std::nullopt,
              R"doc(
 Initializes a :class:`CVLikelihood` with the given DataFrame ``df``. It uses a
 :class:`CrossValidation <pybnesian.CrossValidation>` with ``k`` folds and the given ``seed``.
 
+If ``num_threads`` is not 1, the folds of each local score are evaluated concurrently. Only the folds of
+:class:`LinearGaussianCPDType <pybnesian.LinearGaussianCPDType>` and
+:class:`DiscreteFactorType <pybnesian.DiscreteFactorType>` nodes are evaluated concurrently. The rest of node types
+are evaluated sequentially.
+
+The operator sets evaluate the local scores with :func:`Score.local_score_bound`, so the evaluation of the folds is
+abandoned when the operator cannot improve the model. The score of a
+:class:`DiscreteFactorType <pybnesian.DiscreteFactorType>` node is abandoned when the log-likelihood of the evaluated
+folds is already too low, because the log-likelihood of discrete data is never positive. This does not change the
+learned model. If ``abandon_confidence`` is set, any node type is also abandoned when the normal upper confidence bound
+of the score (estimated from the mean and variance of the evaluated folds) is too low. This saves most of the
+evaluations of expensive node types (e.g. :class:`CKDEType <pybnesian.CKDEType>`), but an improving operator can be
+wrongly abandoned with probability about ``1 - abandon_confidence``.
+
 :param df: DataFrame to compute the score.
 :param k: Number of folds of the cross validation.
 :param seed: A random seed number. If not specified or ``None``, a random seed is generated.
 :param construction_args: Additional arguments provided to construct the :class:`Factor <pybnesian.Factor>`.
+:param num_threads: Number of threads used to evaluate the folds. By default, the folds are evaluated sequentially.
+    If it is less or equal than 0, all the hardware threads are used. The score is equal for any number of threads.
+:param abandon_confidence: Confidence level of the upper bound used to abandon the evaluation of the folds. It must be
+    in the interval (0, 1). If ``None``, only the provable bounds are used.
 )doc")
         .def_property_readonly("cv", &CVLikelihood::cv, R"doc(
 The underlying :class:`CrossValidation <pybnesian.CrossValidation>` object to compute the score.
+)doc")
+        .def_property_readonly("abandon_confidence", &CVLikelihood::abandon_confidence, R"doc(
+The confidence level of the upper bound used to abandon the evaluation of the folds, or ``None``.
 )doc");
 
     py::class_<HoldoutLikelihood, Score, std::shared_ptr<HoldoutLikelihood>>(root, "HoldoutLikelihood", R"doc(
@@ -655,6 +924,96 @@ The underlying training data of the :class:`HoldOut <pybnesian.HoldOut>`.
              py::return_value_policy::reference_internal,
              R"doc(
 The underlying holdout data of the :class:`HoldOut <pybnesian.HoldOut>`.
+)doc");
+
+    py::class_<CachedScore, Score, std::shared_ptr<CachedScore>> cached_score(root, "CachedScore", R"doc(
+This class memoizes the local scores of another :class:`Score`. The local scores are identified by the variable, its
+node type and its parent set (the order of the parents is not relevant), so the underlying score must be decomposable.
+
+The cache is kept between structure learning runs: reusing the same :class:`CachedScore` avoids recomputing the local
+scores of the families visited in previous runs (e.g. when trying different starting models, operators or
+hyperparameters). Its memory is bounded: the least recently used local scores are removed when the cache is full.
+)doc");
+    cached_score.def(py::init<std::shared_ptr<Score>, int>(),
+                     py::keep_alive<1, 2>(),
+                     py::arg("score"),
+                     py::arg("max_cache_size") = 100000,
+                     R"doc(
+Initializes a :class:`CachedScore` over ``score``.
+
+:param score: The :class:`Score` to cache. A :class:`ValidatedScore` should be wrapped with a
+              :class:`CachedValidatedScore` to also cache its validation local scores.
+:param max_cache_size: The maximum number of local scores stored in the cache.
+)doc");
+    register_CachedScore_methods<CachedScore>(cached_score);
+
+    py::class_<CachedValidatedScore, ValidatedScore, std::shared_ptr<CachedValidatedScore>> cached_validated_score(
+        root, "CachedValidatedScore", R"doc(
+This class memoizes the local scores and the validation local scores of a :class:`ValidatedScore`. It works like
+:class:`CachedScore`.
+)doc");
+    cached_validated_score.def(py::init<std::shared_ptr<ValidatedScore>, int>(),
+                               py::keep_alive<1, 2>(),
+                               py::arg("score"),
+                               py::arg("max_cache_size") = 100000,
+                               R"doc(
+Initializes a :class:`CachedValidatedScore` over ``score``.
+
+:param score: The :class:`ValidatedScore` to cache.
+:param max_cache_size: The maximum number of local scores (training and validation) stored in the cache.
+)doc");
+    register_CachedScore_methods<CachedValidatedScore>(cached_validated_score);
+
+    py::class_<ScreeningScore, Score, std::shared_ptr<ScreeningScore>>(root, "ScreeningScore", R"doc(
+This class evaluates the structure learning operators in two stages, to learn from very large datasets. The local
+scores are computed with a ``screening`` score (usually learned from a subsample of the data), so all the operators
+are ranked cheaply. In each iteration, :class:`GreedyHillClimbing <pybnesian.GreedyHillClimbing>` evaluates the
+``num_confirmations`` operators with the best screening delta with an ``exact`` score (usually learned from the full
+data), and applies the operator with the best exact delta. The search stops when the best exact delta is less than
+``epsilon``.
+
+It cannot be used with a ``batch_size`` greater than 1.
+)doc")
+        .def(py::init<std::shared_ptr<Score>, std::shared_ptr<Score>, int>(),
+             py::keep_alive<1, 2>(),
+             py::keep_alive<1, 3>(),
+             py::arg("screening"),
+             py::arg("exact"),
+             py::arg("num_confirmations") = 5,
+             R"doc(
+Initializes a :class:`ScreeningScore`.
+
+:param screening: The :class:`Score` used to rank the operators.
+:param exact: The :class:`Score` used to confirm the best operators.
+:param num_confirmations: The number of operators confirmed with ``exact`` in each iteration.
+)doc")
+        .def_property_readonly("screening_score", &ScreeningScore::screening_score, R"doc(
+The :class:`Score` used to rank the operators.
+)doc")
+        .def_property_readonly("exact_score", &ScreeningScore::exact_score, R"doc(
+The :class:`Score` used to confirm the best operators.
+)doc")
+        .def_property_readonly("num_confirmations", &ScreeningScore::num_confirmations, R"doc(
+The number of operators confirmed with the exact score in each iteration.
+)doc")
+        .def_static(
+            "stratified_subsample",
+            [](const DataFrame& df, int num_rows, std::optional<unsigned int> seed) {
+                return ScreeningScore::stratified_subsample(df, num_rows, random_seed_arg(seed));
+            },
+            py::arg("df"),
+            py::arg("num_rows"),
+            py::arg("seed") = std::nullopt,
+            R"doc(
+Returns a subsample of ``num_rows`` rows of ``df``, stratified by the joint configuration of the categorical columns.
+Each configuration receives a number of rows proportional to its frequency, rounded with the largest remainder method,
+so the rare configurations can receive no rows. The rows keep the order of ``df``. If ``num_rows`` is greater or equal than the number of rows of ``df``, ``df`` is
+returned.
+
+:param df: DataFrame to subsample.
+:param num_rows: Number of rows of the subsample.
+:param seed: A random seed number. If not specified or ``None``, a random seed is generated.
+:returns: The subsample of ``df``.
 )doc");
 
     py::class_<DynamicScore, PyDynamicScore<>, std::shared_ptr<DynamicScore>> dynamic_score(root, "DynamicScore", R"doc(
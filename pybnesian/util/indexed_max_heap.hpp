@@ -0,0 +1,134 @@
+#ifndef PYBNESIAN_UTIL_INDEXED_MAX_HEAP_HPP
+#define PYBNESIAN_UTIL_INDEXED_MAX_HEAP_HPP
+
+#include <algorithm>
+#include <vector>
+
+namespace util {
+
+// Binary max-heap over a subset of the keys [0, capacity). The priority of each key is read from an external array
+// (e.g. the data of a delta matrix) and copied into the heap, so the owner must call update(key) after the priority
+// of a key changes. Many priorities can change before calling update() for each of them. Ties are broken in favour of
+// the lower key.
+class IndexedMaxHeap {
+public:
+    IndexedMaxHeap() : m_priority(nullptr), m_value(), m_heap(), m_position() {}
+
+    // Builds the heap with the keys in keys. priority must be valid until the next call to build().
+    void build(const std::vector<int>& keys, const double* priority, int capacity) {
+        m_priority = priority;
+        m_value.assign(capacity, 0);
+        m_heap = keys;
+        m_position.assign(capacity, -1);
+
+        for (int i = 0, i_end = static_cast<int>(m_heap.size()); i < i_end; ++i) {
+            m_value[m_heap[i]] = priority[m_heap[i]];
+            m_position[m_heap[i]] = i;
+        }
+
+        for (int i = static_cast<int>(m_heap.size()) / 2 - 1; i >= 0; --i) {
+            sift_down(i);
+        }
+    }
+
+    bool contains(int key) const {
+        return key >= 0 && key < static_cast<int>(m_position.size()) && m_position[key] >= 0;
+    }
+
+    // Restores the heap order after the priority of key has changed. Keys not in the heap are ignored.
+    void update(int key) {
+        if (!contains(key) || m_value[key] == m_priority[key]) return;
+
+        m_value[key] = m_priority[key];
+        int pos = m_position[key];
+        sift_up(pos);
+        sift_down(m_position[key]);
+    }
+
+    bool empty() const { return m_heap.empty(); }
+    int size() const { return static_cast<int>(m_heap.size()); }
+    int top() const { return m_heap[0]; }
+
+    // Visits the keys from the highest to the lowest priority without modifying the heap. Each step costs
+    // O(log k), where k is the number of keys already visited, so stopping early is cheap.
+    class DescendingIterator {
+    public:
+        DescendingIterator(const IndexedMaxHeap& heap) : m_heap(heap), m_frontier() {
+            if (!m_heap.empty()) m_frontier.push_back(0);
+        }
+
+        bool end() const { return m_frontier.empty(); }
+        int operator*() const { return m_heap.m_heap[m_frontier.front()]; }
+
+        DescendingIterator& operator++() {
+            auto cmp = [this](int p1, int p2) { return m_heap.greater(p2, p1); };
+
+            std::pop_heap(m_frontier.begin(), m_frontier.end(), cmp);
+            int pos = m_frontier.back();
+            m_frontier.pop_back();
+
+            for (int child = 2 * pos + 1, last = std::min(2 * pos + 2, m_heap.size() - 1); child <= last; ++child) {
+                m_frontier.push_back(child);
+                std::push_heap(m_frontier.begin(), m_frontier.end(), cmp);
+            }
+
+            return *this;
+        }
+
+    private:
+        const IndexedMaxHeap& m_heap;
+        // Heap positions that are candidates to be the next visited key.
+        std::vector<int> m_frontier;
+    };
+
+    DescendingIterator descending() const { return DescendingIterator(*this); }
+
+private:
+    // Returns true if the key at heap position p1 goes before the key at heap position p2.
+    bool greater(int p1, int p2) const {
+        int k1 = m_heap[p1], k2 = m_heap[p2];
+        return m_value[k1] > m_value[k2] || (m_value[k1] == m_value[k2] && k1 < k2);
+    }
+
+    void swap_positions(int p1, int p2) {
+        std::swap(m_heap[p1], m_heap[p2]);
+        m_position[m_heap[p1]] = p1;
+        m_position[m_heap[p2]] = p2;
+    }
+
+    void sift_up(int pos) {
+        while (pos > 0) {
+            int parent = (pos - 1) / 2;
+            if (!greater(pos, parent)) break;
+
+            swap_positions(pos, parent);
+            pos = parent;
+        }
+    }
+
+    void sift_down(int pos) {
+        int n = static_cast<int>(m_heap.size());
+        while (true) {
+            int best = pos;
+            int left = 2 * pos + 1;
+            int right = left + 1;
+
+            if (left < n && greater(left, best)) best = left;
+            if (right < n && greater(right, best)) best = right;
+            if (best == pos) break;
+
+            swap_positions(pos, best);
+            pos = best;
+        }
+    }
+
+    const double* m_priority;
+    // Priorities of the keys at the moment they were last updated.
+    std::vector<double> m_value;
+    std::vector<int> m_heap;
+    std::vector<int> m_position;
+};
+
+}  // namespace util
+
+#endif  // PYBNESIAN_UTIL_INDEXED_MAX_HEAP_HPP
@@ -0,0 +1,90 @@
+#ifndef PYBNESIAN_UTIL_PARALLEL_HPP
+#define PYBNESIAN_UTIL_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+namespace util {
+
+// Returns the number of threads to use. A non-positive value selects all the hardware threads.
+inline int resolve_num_threads(int num_threads) {
+    if (num_threads > 0) return num_threads;
+
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+// True in the threads that run a parallel_for.
+inline thread_local bool in_parallel_for = false;
+
+// Calls f(i) for every i in [begin, end) using up to num_threads threads (the calling thread included). The indices
+// are distributed dynamically, so f(i) must only write state owned by i. If any call throws, the remaining indices
+// are skipped and the first exception is rethrown in the calling thread after all the threads have finished.
+//
+// The GIL is released while the workers run, so f must not touch Python objects. A parallel_for called inside another
+// parallel_for runs sequentially, so nested parallel code does not oversubscribe the CPU.
+template <typename F>
+void parallel_for(int begin, int end, int num_threads, F&& f) {
+    num_threads = std::min(resolve_num_threads(num_threads), end - begin);
+
+    if (num_threads <= 1 || in_parallel_for) {
+        for (int i = begin; i < end; ++i) {
+            f(i);
+        }
+        return;
+    }
+
+    std::atomic<int> next(begin);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error = nullptr;
+    std::mutex error_mutex;
+
+    auto worker = [&]() {
+        in_parallel_for = true;
+
+        while (!failed.load(std::memory_order_relaxed)) {
+            int i = next.fetch_add(1);
+            if (i >= end) break;
+
+            try {
+                f(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+                failed = true;
+            }
+        }
+
+        in_parallel_for = false;
+    };
+
+    {
+        std::optional<py::gil_scoped_release> release;
+        if (Py_IsInitialized() && PyGILState_Check()) release.emplace();
+
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads - 1);
+        for (int t = 1; t < num_threads; ++t) {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    if (error) std::rethrow_exception(error);
+}
+
+}  // namespace util
+
+#endif  // PYBNESIAN_UTIL_PARALLEL_HPP
@@ -7,7 +7,8 @@
 #include <learning/scores/bge.hpp>
 #include <learning/scores/validated_likelihood.hpp>
 
-using learning::operators::ArcOperatorSet, learning::operators::ChangeNodeTypeSet, learning::operators::OperatorPool;
+using learning::operators::ArcOperatorSet, learning::operators::CandidateArcOperatorSet,
+    learning::operators::ChangeNodeTypeSet, learning::operators::OperatorPool;
 using learning::scores::BIC, learning::scores::BGe, learning::scores::ValidatedLikelihood;
 using models::GaussianNetworkType, models::KDENetworkType, models::SemiparametricBNType, models::DiscreteBNType;
 
@@ -49,13 +50,29 @@ std::shared_ptr<OperatorSet> check_valid_operators(const BayesianNetworkType& bn
                                                    const ArcStringVector& arc_blacklist,
                                                    const ArcStringVector& arc_whitelist,
                                                    int max_indegree,
-                                                   const FactorTypeVector& type_whitelist) {
+                                                   const FactorTypeVector& type_whitelist,
+                                                   const ArcCandidates& arc_candidates) {
     std::vector<std::shared_ptr<OperatorSet>> res;
 
+    // If the candidate parents are given, the arc operators only score the candidate arcs.
+    auto arc_operators = [&]() -> std::shared_ptr<OperatorSet> {
+        if (arc_candidates.empty())
+            return std::make_shared<ArcOperatorSet>(arc_blacklist, arc_whitelist, max_indegree);
+        else
+            return std::make_shared<CandidateArcOperatorSet>(
+                arc_candidates, arc_blacklist, arc_whitelist, max_indegree);
+    };
+
     if (operators && !operators->empty()) {
         for (auto& op : *operators) {
             if (op == "arcs") {
-                res.push_back(std::make_shared<ArcOperatorSet>(arc_blacklist, arc_whitelist, max_indegree));
+                res.push_back(arc_operators());
+            } else if (op == "candidate_arcs") {
+                if (arc_candidates.empty()) {
+                    throw std::invalid_argument("Operator \"candidate_arcs\" requires the arc candidates.");
+                }
+
+                res.push_back(arc_operators());
             } else if (op == "node_type") {
                 if (bn_type != SemiparametricBNType::get_ref()) {
                     throw std::invalid_argument(
@@ -68,17 +85,18 @@ std::shared_ptr<OperatorSet> check_valid_operators(const BayesianNetworkType& bn
             } else
                 throw std::invalid_argument("Wrong operator set \"" + op +
                                             "\". Valid choices are:"
-                                            "\"arcs\" (Changes in arcs; addition, removal and flip) or "
+                                            "\"arcs\" (Changes in arcs; addition, removal and flip), "
+                                            "\"candidate_arcs\" (Changes in the candidate arcs) or "
                                             "\"node_type\" (Change of node type)");
         }
     } else {
         if (bn_type == GaussianNetworkType::get_ref())
-            res.push_back(std::make_shared<ArcOperatorSet>(arc_blacklist, arc_whitelist, max_indegree));
+            res.push_back(arc_operators());
         else if (bn_type == SemiparametricBNType::get_ref()) {
-            res.push_back(std::make_shared<ArcOperatorSet>(arc_blacklist, arc_whitelist, max_indegree));
+            res.push_back(arc_operators());
             res.push_back(std::make_shared<ChangeNodeTypeSet>(type_whitelist));
         } else if (bn_type == KDENetworkType::get_ref())
-            res.push_back(std::make_shared<ArcOperatorSet>(arc_blacklist, arc_whitelist, max_indegree));
+            res.push_back(arc_operators());
         else
             throw std::invalid_argument("Default operators not defined for " + bn_type.ToString() + ".");
     }
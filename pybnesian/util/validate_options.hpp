@@ -4,7 +4,7 @@
 #include <learning/operators/operators.hpp>
 #include <models/BayesianNetwork.hpp>
 
-using learning::operators::OperatorSet;
+using learning::operators::OperatorSet, learning::operators::ArcCandidates;
 using models::BayesianNetworkType;
 
 namespace util {
@@ -21,7 +21,8 @@ std::shared_ptr<OperatorSet> check_valid_operators(const BayesianNetworkType& bn
                                                    const ArcStringVector& arc_blacklist,
                                                    const ArcStringVector& arc_whitelist,
                                                    int max_indegree,
-                                                   const FactorTypeVector& type_whitelist);
+                                                   const FactorTypeVector& type_whitelist,
+                                                   const ArcCandidates& arc_candidates = ArcCandidates());
 
 }  // namespace util
 
@@ -133,6 +133,7 @@ ext_modules = [
          'pybnesian/factors/continuous/CKDE.cpp',
          'pybnesian/factors/discrete/DiscreteFactor.cpp',
          'pybnesian/factors/discrete/discrete_indices.cpp',
+         'pybnesian/factors/discrete/contingency_cache.cpp',
          'pybnesian/dataset/dataset.cpp',
          'pybnesian/dataset/dynamic_dataset.cpp',
          'pybnesian/dataset/crossvalidation_adaptator.cpp',
@@ -157,6 +158,7 @@ ext_modules = [
          'pybnesian/learning/independences/continuous/RCoT.cpp',
          'pybnesian/learning/independences/discrete/chi_square.cpp',
          'pybnesian/learning/independences/hybrid/mutual_information.cpp',
+         'pybnesian/learning/independences/cached_independence.cpp',
          'pybnesian/learning/parameters/mle_LinearGaussianCPD.cpp',
          'pybnesian/learning/parameters/mle_DiscreteFactor.cpp',
          'pybnesian/learning/scores/bic.cpp',
@@ -164,6 +166,11 @@ ext_modules = [
          'pybnesian/learning/scores/bde.cpp',
          'pybnesian/learning/scores/cv_likelihood.cpp',
          'pybnesian/learning/scores/holdout_likelihood.cpp',
+         'pybnesian/learning/scores/cached_score.cpp',
+         'pybnesian/learning/scores/gaussian_statistics.cpp',
+         'pybnesian/learning/scores/sufficient_statistics.cpp',
+         'pybnesian/learning/scores/cholesky_cache.cpp',
+         'pybnesian/learning/scores/screening_score.cpp',
          'pybnesian/graph/generic_graph.cpp',
          'pybnesian/models/BayesianNetwork.cpp',
          'pybnesian/models/GaussianNetwork.cpp',
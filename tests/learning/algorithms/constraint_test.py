@@ -1,4 +1,8 @@
+import pytest
+import numpy as np
+import pybnesian as pbn
 from pybnesian import PartiallyDirectedGraph, MeekRules
+import util_test
 
 def test_meek_rule1():
     # From Koller Chapter 3.4, Figure 3.12, pag 89.
@@ -41,4 +45,134 @@ def test_meek_sequential():
         changed = changed or MeekRules.rule3(koller)
 
     assert set(koller.edges()) == set([('A', 'B'), ('B', 'D')])
-    assert set(koller.arcs()) == set([('B', 'E'), ('C', 'E'), ('E', 'F'), ('C', 'F'), ('F', 'G')])
\ No newline at end of file
+    assert set(koller.arcs()) == set([('B', 'E'), ('C', 'E'), ('E', 'F'), ('C', 'F'), ('F', 'G')])
+
+def test_pc_sufficient_statistics():
+    df = util_test.generate_normal_data(5000)
+    statistics = pbn.SufficientStatistics.from_covariance(list(df.columns), df.shape[0], df.mean().to_numpy(),
+                                                          df.cov().to_numpy())
+    lc = pbn.LinearCorrelation(df)
+    lc_statistics = pbn.LinearCorrelation(statistics)
+    assert np.isclose(lc.pvalue('a', 'c', ['b']), lc_statistics.pvalue('a', 'c', ['b']))
+
+    pdag = pbn.PC().estimate(lc)
+    pdag_statistics = pbn.PC().estimate(lc_statistics)
+    assert set(pdag.arcs()) == set(pdag_statistics.arcs())
+    assert set(pdag.edges()) == set(pdag_statistics.edges())
+
+    discrete_df = util_test.generate_discrete_data_dependent(5000)
+    count_table = discrete_df.groupby(['A', 'B', 'C', 'D'], observed=True).size().reset_index(name='count')
+    chi = pbn.ChiSquare(discrete_df)
+    chi_statistics = pbn.ChiSquare(pbn.SufficientStatistics.from_counts(count_table))
+    assert np.isclose(chi.pvalue('A', 'D', ['B', 'C']), chi_statistics.pvalue('A', 'D', ['B', 'C']))
+
+    pdag = pbn.MMPC().estimate(chi)
+    pdag_statistics = pbn.MMPC().estimate(chi_statistics)
+    assert set(pdag.arcs()) == set(pdag_statistics.arcs())
+    assert set(pdag.edges()) == set(pdag_statistics.edges())
+
+def test_pc_num_threads():
+    df = util_test.generate_normal_data(5000)
+    lc = pbn.LinearCorrelation(df)
+    assert lc.is_thread_safe()
+
+    pdag = pbn.PC().estimate(lc)
+    pdag_threads = pbn.PC().estimate(lc, num_threads=4)
+    assert set(pdag.arcs()) == set(pdag_threads.arcs())
+    assert set(pdag.edges()) == set(pdag_threads.edges())
+
+    # PC-stable: the result does not depend on the order of the nodes.
+    pdag_reversed = pbn.PC().estimate(lc, nodes=list(reversed(df.columns)), num_threads=4)
+    assert set(pdag.arcs()) == set(pdag_reversed.arcs())
+    assert set(map(frozenset, pdag.edges())) == set(map(frozenset, pdag_reversed.edges()))
+
+def test_mmpc_num_threads():
+    df = util_test.generate_normal_data(5000)
+    lc = pbn.LinearCorrelation(df)
+
+    pdag = pbn.MMPC().estimate(lc)
+    pdag_threads = pbn.MMPC().estimate(lc, num_threads=4)
+    assert set(pdag.arcs()) == set(pdag_threads.arcs())
+    assert set(pdag.edges()) == set(pdag_threads.edges())
+
+    # The forward phase also starts from the whitelisted CPCs.
+    pdag = pbn.MMPC().estimate(lc, edge_whitelist=[('a', 'c')])
+    pdag_threads = pbn.MMPC().estimate(lc, edge_whitelist=[('a', 'c')], num_threads=4)
+    assert set(pdag.arcs()) == set(pdag_threads.arcs())
+    assert set(pdag.edges()) == set(pdag_threads.edges())
+
+def test_cached_independence_test():
+    df = util_test.generate_normal_data(5000)
+    lc = pbn.LinearCorrelation(df)
+    cached = pbn.CachedIndependenceTest(lc)
+    assert cached.is_thread_safe()
+
+    assert np.isclose(cached.pvalue('a', 'c', ['b', 'd']), lc.pvalue('a', 'c', ['b', 'd']))
+    assert cached.misses() == 1 and cached.hits() == 0
+    # The order of the variables and of the conditioning set is not relevant.
+    assert np.isclose(cached.pvalue('c', 'a', ['d', 'b']), lc.pvalue('a', 'c', ['b', 'd']))
+    assert np.isclose(cached.pvalue('a', 'c'), lc.pvalue('a', 'c'))
+    assert np.isclose(cached.pvalue('c', 'a', 'b'), lc.pvalue('a', 'c', 'b'))
+    assert cached.misses() == 3 and cached.hits() == 1
+
+    cached.clear_cache()
+    assert cached.cache_size() == 0
+
+    # The p-values do not depend on alpha, so the runs with different alpha values share the cache.
+    for alpha in [0.01, 0.05, 0.1]:
+        pdag_cached = pbn.PC().estimate(cached, alpha=alpha)
+        pdag_lc = pbn.PC().estimate(lc, alpha=alpha)
+        assert set(pdag_cached.arcs()) == set(pdag_lc.arcs())
+        assert set(pdag_cached.edges()) == set(pdag_lc.edges())
+
+    # A repeated run does not execute new tests.
+    misses = cached.misses()
+    pbn.PC().estimate(cached, alpha=0.05, num_threads=4)
+    assert cached.misses() == misses
+
+    small = pbn.CachedIndependenceTest(lc, max_cache_size=2)
+    small.pvalue('a', 'b')
+    small.pvalue('a', 'c')
+    small.pvalue('a', 'd')
+    assert small.cache_size() == 2
+
+    with pytest.raises(ValueError) as ex:
+        pbn.CachedIndependenceTest(lc, max_cache_size=0)
+    assert "must be positive" in str(ex.value)
+
+def test_linear_correlation_pvalues():
+    df = util_test.generate_normal_data(5000)
+    lc = pbn.LinearCorrelation(df)
+
+    for z in [[], ['d'], ['c', 'd']]:
+        ys = [y for y in ['b', 'c', 'd'] if y not in z]
+        pvalues = lc.pvalues('a', ys, z)
+        assert np.all(np.isclose(pvalues, [lc.pvalue('a', y, z) for y in ys]))
+
+    # The cached p-values are not computed again.
+    cached = pbn.CachedIndependenceTest(lc)
+    cached.pvalue('a', 'b', ['c', 'd'])
+    pvalues = cached.pvalues('a', ['b', 'c'], ['d'])
+    assert np.all(np.isclose(pvalues, lc.pvalues('a', ['b', 'c'], ['d'])))
+    assert cached.misses() == 3
+    cached.pvalues('a', ['b'], ['d', 'c'])
+    assert cached.hits() == 1
+
+def test_linear_correlation_null():
+    df = util_test.generate_normal_data(5000)
+
+    np.random.seed(0)
+    df_null = df.copy()
+    for col in df.columns:
+        df_null.loc[df_null.index[np.random.randint(0, df.shape[0], size=200)], col] = np.nan
+
+    lc = pbn.LinearCorrelation(df_null)
+
+    # The tests use the rows where all the tested variables are not null.
+    for x, y, z in [('a', 'b', []), ('a', 'c', ['b']), ('a', 'd', ['b', 'c']), ('b', 'd', ['a', 'c'])]:
+        lc_complete = pbn.LinearCorrelation(df_null[[x, y] + z].dropna())
+        assert np.isclose(lc.pvalue(x, y, z), lc_complete.pvalue(x, y, z))
+
+    assert np.isclose(lc.pvalue('a', 'b'), pbn.LinearCorrelation(df_null[['a', 'b']].dropna()).pvalue('a', 'b'))
+    assert np.isclose(lc.pvalue('a', 'c', 'b'),
+                      pbn.LinearCorrelation(df_null[['a', 'b', 'c']].dropna()).pvalue('a', 'c', 'b'))
@@ -1,3 +1,4 @@
+import pytest
 import numpy as np
 import pybnesian as pbn
 from pybnesian import BayesianNetworkType, BayesianNetwork
@@ -160,6 +161,27 @@ def test_hc_shortcut_function():
     model = pbn.hc(df, bn_type=MyRestrictedGaussianNetworkType(), score="bic", operators=["arcs"])
     assert type(model) == NewBN
 
+def test_hc_num_threads():
+    bic = pbn.BIC(df)
+    assert bic.is_thread_safe()
+    assert not pbn.CVLikelihood(df).is_thread_safe()
+
+    start = pbn.GaussianNetwork(list(df.columns.values))
+    hc = pbn.GreedyHillClimbing()
+
+    serial = hc.estimate(pbn.ArcOperatorSet(), bic, start)
+    parallel = hc.estimate(pbn.ArcOperatorSet(), bic, start, num_threads=4)
+    assert set(serial.arcs()) == set(parallel.arcs())
+    assert bic.score(serial) == bic.score(parallel)
+
+    serial = pbn.hc(df, bn_type=pbn.GaussianNetworkType(), max_indegree=1)
+    parallel = pbn.hc(df, bn_type=pbn.GaussianNetworkType(), max_indegree=1, num_threads=4)
+    assert set(serial.arcs()) == set(parallel.arcs())
+
+    # Python-derived types are evaluated serially.
+    model = pbn.hc(df, bn_type=MyRestrictedGaussianNetworkType(), score="bic", operators=["arcs"], num_threads=4)
+    assert type(model) == NewBN
+
 class MyRestrictedGaussianNetworkType(BayesianNetworkType):
     def __init__(self):
         BayesianNetworkType.__init__(self)
@@ -203,4 +225,183 @@ def test_newbn_estimate_validation():
     estimated = hc.estimate(arc, bic, start)
 
     assert type(start) == type(estimated)
-    assert estimated.extra_data == "extra"
\ No newline at end of file
+    assert estimated.extra_data == "extra"
+
+def test_hc_candidate_arcs():
+    candidates = {'b': ['a'], 'c': ['a', 'b'], 'd': ['c']}
+    model = pbn.hc(df, bn_type=pbn.GaussianNetworkType(), arc_candidates=candidates)
+    assert all(arc[0] in candidates[arc[1]] for arc in model.arcs())
+
+    model_op = pbn.hc(df, bn_type=pbn.GaussianNetworkType(), operators=["candidate_arcs"], arc_candidates=candidates)
+    assert set(model.arcs()) == set(model_op.arcs())
+
+    # The "arcs" operators also use the arc candidates.
+    model_arcs = pbn.hc(df, bn_type=pbn.GaussianNetworkType(), operators=["arcs"], arc_candidates=candidates)
+    assert set(model.arcs()) == set(model_arcs.arcs())
+
+def test_hc_restarts():
+    model, scores = pbn.hc_restarts(df, pbn.GaussianNetworkType(), 4, seed=0)
+    assert type(model) == pbn.GaussianNetwork
+    assert len(scores) == 4
+
+    bic = pbn.BIC(df)
+    assert np.isclose(bic.score(model), max(scores))
+
+    # The first start is the empty network.
+    assert np.isclose(scores[0], bic.score(pbn.hc(df, bn_type=pbn.GaussianNetworkType())))
+
+    model_parallel, scores_parallel = pbn.hc_restarts(df, pbn.GaussianNetworkType(), 4, seed=0, num_threads=4)
+    assert set(model.arcs()) == set(model_parallel.arcs())
+    assert np.allclose(scores, scores_parallel)
+
+def test_hc_restarts_clg():
+    hybrid_df = util_test.generate_hybrid_data(1000)
+    # The random starts cannot contain continuous -> discrete arcs.
+    model, scores = pbn.hc_restarts(hybrid_df, pbn.CLGNetworkType(), 8, seed=0)
+    assert type(model) == pbn.CLGNetwork
+    assert len(scores) == 8
+    assert all(np.isfinite(scores))
+
+    discrete = {'A', 'B'}
+    for source, target in model.arcs():
+        assert target not in discrete or source in discrete
+
+    bic = pbn.BIC(hybrid_df)
+    assert np.isclose(bic.score(model), max(scores))
+
+def test_hc_batch():
+    bic = pbn.BIC(df)
+    start = pbn.GaussianNetwork(list(df.columns.values))
+    hc = pbn.GreedyHillClimbing()
+
+    res = hc.estimate(pbn.ArcOperatorSet(), bic, start, batch_size=10)
+
+    # The search stops in a local optimum.
+    arc_op = pbn.ArcOperatorSet()
+    arc_op.cache_scores(res, bic)
+    op = arc_op.find_max(res)
+    assert op is None or op.delta() < 1e-8
+
+    model = pbn.hc(df, bn_type=pbn.GaussianNetworkType(), batch_size=10)
+    assert set(model.arcs()) == set(res.arcs())
+
+    with pytest.raises(ValueError) as ex:
+        hc.estimate(pbn.ArcOperatorSet(), bic, start, batch_size=0)
+    assert "batch_size must be positive" in str(ex.value)
+
+class BudgetCallback(pbn.Callback):
+    def __init__(self):
+        pbn.Callback.__init__(self)
+        self.reports = []
+
+    def call(self, model, operator, score, iteration):
+        pass
+
+    def report(self, elapsed_time, score_evaluations):
+        self.reports.append((elapsed_time, score_evaluations))
+
+def test_hc_budget():
+    bic = pbn.BIC(df)
+    start = pbn.GaussianNetwork(list(df.columns.values))
+    hc = pbn.GreedyHillClimbing()
+
+    callback = BudgetCallback()
+    full = hc.estimate(pbn.ArcOperatorSet(), bic, start, callback=callback)
+    full_evaluations = callback.reports[-1][1]
+    assert full_evaluations > 0
+    assert all(callback.reports[i][1] <= callback.reports[i + 1][1] for i in range(len(callback.reports) - 1))
+
+    callback = BudgetCallback()
+    limited = hc.estimate(pbn.ArcOperatorSet(), bic, start, callback=callback,
+                          max_score_evaluations=full_evaluations // 2)
+    assert callback.reports[-1][1] <= full_evaluations // 2
+    assert limited.num_arcs() <= full.num_arcs()
+    assert bic.score(limited) <= bic.score(full)
+
+    # The budget is exhausted while the scores are cached, so the start model is returned.
+    limited = hc.estimate(pbn.ArcOperatorSet(), bic, start, max_score_evaluations=1)
+    assert limited.num_arcs() == 0
+
+    limited = hc.estimate(pbn.ArcOperatorSet(), bic, start, max_time=1e-9)
+    assert limited.num_arcs() == 0
+
+class LocalScoreOperatorSet(pbn.OperatorSet):
+    def __init__(self, score):
+        pbn.OperatorSet.__init__(self, False)
+        self.score = score
+        self.received_score = []
+
+    def cache_scores(self, model, score):
+        self.received_score.append(score is self.score)
+        for node in model.nodes():
+            score.local_score(model, node, [])
+
+    def find_max(self, model):
+        return None
+
+    def find_max_tabu(self, model, tabu_set):
+        return None
+
+    def update_scores(self, model, score, changed_nodes):
+        pass
+
+def test_hc_budget_python_operators():
+    bic = pbn.BIC(df)
+    start = pbn.GaussianNetwork(list(df.columns.values))
+    hc = pbn.GreedyHillClimbing()
+
+    # Without a budget, the operators receive the original score.
+    op_set = LocalScoreOperatorSet(bic)
+    hc.estimate(op_set, bic, start)
+    assert op_set.received_score == [True]
+
+    # The BudgetExhausted raised inside the Python code ends the search cleanly.
+    op_set = LocalScoreOperatorSet(bic)
+    limited = hc.estimate(op_set, bic, start, max_score_evaluations=2)
+    assert limited.num_arcs() == 0
+    assert op_set.received_score == [False]
+
+def test_hc_screening():
+    bic = pbn.BIC(df)
+    start = pbn.GaussianNetwork(list(df.columns.values))
+    hc = pbn.GreedyHillClimbing()
+
+    # With the same screening and exact scores, the search path does not change.
+    res = hc.estimate(pbn.ArcOperatorSet(), bic, start)
+    screening = pbn.ScreeningScore(bic, bic, num_confirmations=3)
+    res_screening = hc.estimate(pbn.ArcOperatorSet(), screening, start)
+    assert set(res.arcs()) == set(res_screening.arcs())
+
+    subsample = pbn.ScreeningScore.stratified_subsample(df, 200, seed=0).to_pandas()
+    assert subsample.shape[0] == 200
+    assert list(subsample.columns.values) == list(df.columns.values)
+
+    # The applied operators improve the exact score.
+    screening = pbn.ScreeningScore(pbn.BIC(subsample), bic)
+    res_screening = hc.estimate(pbn.ArcOperatorSet(), screening, start)
+    assert bic.score(res_screening) > bic.score(start)
+
+    model = pbn.hc(df, bn_type=pbn.GaussianNetworkType(), seed=0, screening_rows=200)
+    assert bic.score(model) > bic.score(start)
+
+    with pytest.raises(ValueError) as ex:
+        hc.estimate(pbn.ArcOperatorSet(), screening, start, batch_size=2)
+    assert "batch_size" in str(ex.value)
+
+    # A ScreeningScore wrapped in a CachedScore is also detected.
+    cached_screening = pbn.CachedScore(screening)
+    with pytest.raises(ValueError) as ex:
+        hc.estimate(pbn.ArcOperatorSet(), cached_screening, start, batch_size=2)
+    assert "batch_size" in str(ex.value)
+
+    res_cached = hc.estimate(pbn.ArcOperatorSet(), cached_screening, start)
+    assert set(res_cached.arcs()) == set(hc.estimate(pbn.ArcOperatorSet(), screening, start).arcs())
+
+    discrete_df = util_test.generate_discrete_data_dependent(1000)
+    discrete_subsample = pbn.ScreeningScore.stratified_subsample(discrete_df, 100, seed=0).to_pandas()
+    assert discrete_subsample.shape[0] == 100
+    # Each configuration of the discrete variables receives its proportional share of rows, rounded up or down.
+    subsample_counts = discrete_subsample.value_counts()
+    for configuration, count in discrete_df.value_counts().items():
+        share = 100 * count / discrete_df.shape[0]
+        assert np.floor(share) <= subsample_counts.get(configuration, 0) <= np.ceil(share)
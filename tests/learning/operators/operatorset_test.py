@@ -76,3 +76,122 @@ def test_nomax():
 
 
 
+
+def test_update_scores_max():
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd'])
+
+    bic = pbn.BIC(df)
+    arc_op = pbn.ArcOperatorSet()
+    arc_op.cache_scores(gbn, bic)
+
+    # The best operator after incremental updates must match the one found after caching all the scores again.
+    for _ in range(4):
+        op = arc_op.find_max(gbn)
+        op.apply(gbn)
+        arc_op.update_scores(gbn, bic, op.nodes_changed(gbn))
+
+        fresh_op = pbn.ArcOperatorSet()
+        fresh_op.cache_scores(gbn, bic)
+
+        # Compare deltas: score equivalent operators can be tied.
+        assert np.isclose(arc_op.find_max(gbn).delta(), fresh_op.find_max(gbn).delta())
+
+def test_update_scores_num_threads():
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd'])
+    gbn_parallel = pbn.GaussianNetwork(['a', 'b', 'c', 'd'])
+
+    bic = pbn.BIC(df)
+    arc_op = pbn.ArcOperatorSet()
+    arc_op_parallel = pbn.ArcOperatorSet()
+    arc_op_parallel.set_num_threads(4)
+    arc_op.cache_scores(gbn, bic)
+    arc_op_parallel.cache_scores(gbn_parallel, bic)
+
+    # The deltas updated in parallel are equal to the serial ones, so both searches follow the same path.
+    for _ in range(4):
+        op = arc_op.find_max(gbn)
+        op_parallel = arc_op_parallel.find_max(gbn_parallel)
+        assert op == op_parallel
+        assert op.delta() == op_parallel.delta()
+
+        op.apply(gbn)
+        op_parallel.apply(gbn_parallel)
+        arc_op.update_scores(gbn, bic, op.nodes_changed(gbn))
+        arc_op_parallel.update_scores(gbn_parallel, bic, op_parallel.nodes_changed(gbn_parallel))
+
+    assert set(gbn.arcs()) == set(gbn_parallel.arcs())
+
+    start = pbn.GaussianNetwork(['a', 'b', 'c', 'd'])
+    hc = pbn.GreedyHillClimbing()
+    res = hc.estimate(pbn.ArcOperatorSet(), bic, start)
+    res_parallel = hc.estimate(pbn.ArcOperatorSet(), bic, start, num_threads=4)
+    assert set(res.arcs()) == set(res_parallel.arcs())
+
+def test_candidate_arcs():
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd'], [('a', 'b')])
+
+    bic = pbn.BIC(df)
+    cand_op = pbn.CandidateArcOperatorSet({'c': ['a', 'b'], 'd': ['c']})
+    cand_op.cache_scores(gbn, bic)
+    # The arc a -> b is included in both directions.
+    assert cand_op.num_candidate_arcs() == 5
+
+    for _ in range(4):
+        op = cand_op.find_max(gbn)
+        if op is None or op.delta() <= 0:
+            break
+
+        assert (op.source(), op.target()) in [('a', 'b'), ('b', 'a'), ('a', 'c'), ('b', 'c'), ('c', 'd')]
+        op.apply(gbn)
+        cand_op.update_scores(gbn, bic, op.nodes_changed(gbn))
+
+    # With all the candidates, the best operator is the same as in ArcOperatorSet.
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd'])
+    nodes = gbn.nodes()
+    cand_op = pbn.CandidateArcOperatorSet({n: [p for p in nodes if p != n] for n in nodes})
+    arc_op = pbn.ArcOperatorSet()
+    cand_op.cache_scores(gbn, bic)
+    arc_op.cache_scores(gbn, bic)
+
+    for _ in range(4):
+        op = arc_op.find_max(gbn)
+        assert np.isclose(cand_op.find_max(gbn).delta(), op.delta())
+        op.apply(gbn)
+        arc_op.update_scores(gbn, bic, op.nodes_changed(gbn))
+        cand_op.update_scores(gbn, bic, op.nodes_changed(gbn))
+
+    with pytest.raises(ValueError) as ex:
+        pbn.CandidateArcOperatorSet({'e': ['a']}).cache_scores(gbn, bic)
+    assert "not present in the graph" in str(ex.value)
+
+def test_find_max_batch():
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd'])
+    bic = pbn.BIC(df)
+    arc_op = pbn.ArcOperatorSet()
+    arc_op.cache_scores(gbn, bic)
+
+    ops = arc_op.find_max_batch(gbn, 4)
+    assert 1 <= len(ops) <= 4
+    assert ops[0] == arc_op.find_max(gbn)
+
+    changed = set()
+    for i, op in enumerate(ops):
+        if i > 0:
+            assert 0 < op.delta() <= ops[i - 1].delta()
+        assert changed.isdisjoint(op.nodes_changed(gbn))
+        changed.update(op.nodes_changed(gbn))
+
+    assert arc_op.find_max_batch(gbn, 1) == [ops[0]]
+
+    spbn = pbn.SemiparametricBN(['a', 'b', 'c', 'd'])
+    cv = pbn.CVLikelihood(df, k=2, seed=0)
+    pool = pbn.OperatorPool([pbn.ArcOperatorSet(), pbn.ChangeNodeTypeSet()])
+    pool.cache_scores(spbn, cv)
+
+    ops = pool.find_max_batch(spbn, 8)
+    assert ops[0].delta() == pool.find_max(spbn).delta()
+
+    changed = set()
+    for op in ops:
+        assert changed.isdisjoint(op.nodes_changed(spbn))
+        changed.update(op.nodes_changed(spbn))
@@ -1,4 +1,5 @@
 import pybnesian as pbn
+import util_test
 
 def test_OperatorTabuSet():
     tabu_set = pbn.OperatorTabuSet()
@@ -21,4 +22,23 @@ def test_OperatorTabuSet():
     tabu_set.clear()
     assert tabu_set.empty()
 
+def test_find_max_tabu():
+    df = util_test.generate_normal_data(1000)
+    gbn = pbn.GaussianNetwork(['c', 'd'])
+    bic = pbn.BIC(df)
 
+    arc_op = pbn.ArcOperatorSet()
+    arc_op.cache_scores(gbn, bic)
+    op = arc_op.find_max(gbn)
+
+    tabu_set = pbn.OperatorTabuSet()
+    assert arc_op.find_max(gbn, tabu_set) == op
+
+    # BIC is score equivalent, so the best non-tabu operator is the arc in reverse direction.
+    tabu_set.insert(op)
+    op2 = arc_op.find_max(gbn, tabu_set)
+    assert type(op2) == pbn.AddArc
+    assert op2.source() == op.target() and op2.target() == op.source()
+
+    tabu_set.insert(op2)
+    assert arc_op.find_max(gbn, tabu_set) is None
@@ -0,0 +1,46 @@
+import numpy as np
+from scipy.special import gammaln
+import pybnesian as pbn
+import util_test
+
+SIZE = 10000
+
+df = util_test.generate_normal_data(SIZE)
+
+def numpy_local_score(data, variable, evidence, total_nodes, iss_mu=1):
+    iss_w = data.shape[1] + 2
+    node_data = data.loc[:, [variable] + evidence].to_numpy()
+    N = node_data.shape[0]
+    p = len(evidence)
+
+    t = iss_mu * (iss_w - total_nodes - 1) / (iss_mu + 1)
+    logprob = 0.5 * (np.log(iss_mu) - np.log(N + iss_mu))
+    logprob += gammaln(0.5 * (N + iss_w - total_nodes + p + 1)) - gammaln(0.5 * (iss_w - total_nodes + p + 1))
+    logprob -= 0.5 * N * np.log(np.pi)
+    logprob += 0.5 * (iss_w - total_nodes + 2 * p + 1) * np.log(t)
+
+    centered = node_data - node_data.mean(axis=0)
+    r = centered.T @ centered + t * np.eye(p + 1)
+
+    logprob -= 0.5 * (N + iss_w - total_nodes + p + 1) * np.linalg.slogdet(r)[1]
+    logprob += 0.5 * (N + iss_w - total_nodes + p) * np.linalg.slogdet(r[1:, 1:])[1]
+    return logprob
+
+def test_bge_local_score():
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd'], [('a', 'd'), ('b', 'd')])
+    bge = pbn.BGe(df)
+
+    # The parent sets evaluated by the arc operators add or remove one parent of the current parents.
+    for evidence in [['a', 'b'], ['b', 'a'], ['a', 'b', 'c'], ['a'], ['b'], ['c'], ['c', 'a'], []]:
+        assert np.isclose(bge.local_score(gbn, 'd', evidence), numpy_local_score(df, 'd', evidence, 4))
+
+    # The parents of the model changed.
+    gbn.add_arc('c', 'd')
+    gbn.remove_arc('a', 'd')
+    for evidence in [['b', 'c'], ['a', 'b', 'c'], ['c'], ['a']]:
+        assert np.isclose(bge.local_score(gbn, 'd', evidence), numpy_local_score(df, 'd', evidence, 4))
+
+    # The number of nodes of the model changes the prior.
+    gbn2 = pbn.GaussianNetwork(['a', 'b', 'd'], [('a', 'd')])
+    for evidence in [['a'], ['a', 'b'], ['b']]:
+        assert np.isclose(bge.local_score(gbn2, 'd', evidence), numpy_local_score(df, 'd', evidence, 3))
@@ -1,4 +1,6 @@
+import pytest
 import numpy as np
+import pyarrow as pa
 from scipy.stats import norm
 import pybnesian as pbn
 import util_test
@@ -72,6 +74,150 @@ def test_bic_local_score_null():
     assert bic.local_score(gbn, 'c') == bic.local_score(gbn, 'c', gbn.parents('c'))
     assert bic.local_score(gbn, 'd') == bic.local_score(gbn, 'd', gbn.parents('d'))
 
+def test_bic_local_score_cached():
+    df_collinear = df.copy()
+    df_collinear['e'] = 2 * df_collinear['a'] + 1
+    # A null value in other column disables the cached sufficient statistics.
+    df_uncached = df_collinear.copy()
+    df_uncached['f'] = df_uncached['a']
+    df_uncached.loc[df_uncached.index[0], 'f'] = np.nan
+
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd', 'e'])
+    cached = pbn.BIC(df_collinear)
+    uncached = pbn.BIC(df_uncached)
+
+    for variable, evidence in [('a', []), ('b', ['a']), ('c', ['a', 'b']), ('d', ['a', 'b', 'c']),
+                               ('b', ['a', 'e']), ('d', ['e', 'b', 'a', 'c'])]:
+        assert np.isclose(cached.local_score(gbn, variable, evidence), uncached.local_score(gbn, variable, evidence))
+
+def test_bic_local_score_wide():
+    # Wide DataFrames do not cache the SSE matrix and fit each family.
+    np.random.seed(0)
+    df_wide = df.iloc[:500].copy()
+    for i in range(300):
+        df_wide['x' + str(i)] = np.random.normal(size=500)
+
+    gbn = pbn.GaussianNetwork(list(df_wide.columns))
+    bic = pbn.BIC(df_wide)
+
+    assert np.isclose(bic.local_score(gbn, 'a', []), numpy_local_score(df_wide, 'a', []))
+    assert np.isclose(bic.local_score(gbn, 'c', ['a', 'x10']), numpy_local_score(df_wide, 'c', ['a', 'x10']))
+    assert np.isclose(bic.local_score(gbn, 'x5', ['b', 'x299']), numpy_local_score(df_wide, 'x5', ['b', 'x299']))
+
+def numpy_discrete_local_score(data, variable, evidence):
+    node_data = data.loc[:, [variable] + evidence].dropna()
+    N = node_data.shape[0]
+
+    counts = node_data.groupby([variable] + evidence, observed=False).size().to_numpy()
+    counts = counts.reshape([data[v].cat.categories.size for v in [variable] + evidence])
+    parent_counts = counts.sum(axis=0)
+
+    nonzero = counts > 0
+    ll = np.sum(counts[nonzero] * np.log((counts / np.maximum(parent_counts, 1))[nonzero]))
+
+    r = counts.shape[0]
+    q = parent_counts.size
+    return ll - np.log(N) * 0.5 * (r - 1) * q
+
+def test_bic_local_score_discrete():
+    discrete_df = util_test.generate_discrete_data_dependent(SIZE)
+    null_df = discrete_df.copy()
+    null_df.loc[null_df.index[:50], 'D'] = np.nan
+
+    for data in [discrete_df, null_df]:
+        dbn = pbn.DiscreteBN(['A', 'B', 'C', 'D'])
+        bic = pbn.BIC(data)
+        # The data has more than one block of rows, so the counts are split among the threads.
+        bic_parallel = pbn.BIC(data, num_threads=4)
+
+        # The first query fills the count cache. The rest are answered from it, marginalizing and reordering the
+        # cached tables.
+        for variable, evidence in [('D', ['A', 'B', 'C']), ('B', ['A']), ('A', ['C', 'B']), ('C', ['D', 'A']),
+                                   ('D', ['C', 'B', 'A']), ('A', []), ('D', [])]:
+            expected = numpy_discrete_local_score(data, variable, evidence)
+            assert np.isclose(bic.local_score(dbn, variable, evidence), expected)
+            assert np.isclose(bic_parallel.local_score(dbn, variable, evidence), expected)
+
+def test_scores_sufficient_statistics():
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd'])
+    batches = pa.Table.from_pandas(df, preserve_index=False).to_batches(max_chunksize=1000)
+    statistics = pbn.SufficientStatistics(batches)
+    assert statistics.continuous_rows() == SIZE
+
+    for score, streamed in [(pbn.BIC(df), pbn.BIC(statistics)), (pbn.BGe(df), pbn.BGe(statistics))]:
+        for variable, evidence in [('a', []), ('b', ['a']), ('c', ['a', 'b']), ('d', ['a', 'b', 'c'])]:
+            assert np.isclose(score.local_score(gbn, variable, evidence), streamed.local_score(gbn, variable, evidence))
+
+    discrete_df = util_test.generate_discrete_data_dependent(SIZE)
+    discrete_df.loc[discrete_df.index[:50], 'D'] = np.nan
+    dbn = pbn.DiscreteBN(['A', 'B', 'C', 'D'])
+
+    # Batches with nulls: the counts of the streamed scores only use the rows without nulls.
+    discrete_statistics = pbn.SufficientStatistics(discrete_df.iloc[i:i + 1000] for i in range(0, SIZE, 1000))
+    assert discrete_statistics.discrete_rows() == SIZE - 50
+    complete_df = discrete_df.dropna()
+
+    for score, streamed in [(pbn.BIC(complete_df), pbn.BIC(discrete_statistics)),
+                            (pbn.BDe(complete_df), pbn.BDe(discrete_statistics))]:
+        for variable, evidence in [('D', ['A', 'B', 'C']), ('B', ['A']), ('A', ['C', 'B']), ('C', [])]:
+            assert np.isclose(score.local_score(dbn, variable, evidence), streamed.local_score(dbn, variable, evidence))
+
+    # Only the count tables of the families are stored.
+    family_statistics = pbn.SufficientStatistics((discrete_df.iloc[i:i + 1000] for i in range(0, SIZE, 1000)),
+                                                 families=[['A', 'B'], ['C', 'D', 'A']])
+    for score, streamed in [(pbn.BIC(complete_df), pbn.BIC(family_statistics)),
+                            (pbn.BDe(complete_df), pbn.BDe(family_statistics))]:
+        # The repeated family is computed from the memoized counts.
+        for variable, evidence in [('B', ['A']), ('A', ['C']), ('D', ['C', 'A']), ('C', []), ('A', ['C'])]:
+            assert np.isclose(score.local_score(dbn, variable, evidence), streamed.local_score(dbn, variable, evidence))
+
+        with pytest.raises(ValueError) as ex:
+            streamed.local_score(dbn, 'D', ['B'])
+        assert "not contained in the families" in str(ex.value)
+
+    with pytest.raises(ValueError) as ex:
+        pbn.SufficientStatistics([discrete_df], max_configurations=2)
+    assert "distinct configurations" in str(ex.value)
+
+def test_scores_aggregated_statistics():
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd'])
+    statistics = pbn.SufficientStatistics.from_covariance(list(df.columns), SIZE, df.mean().to_numpy(),
+                                                          df.cov().to_numpy())
+
+    for score, aggregated in [(pbn.BIC(df), pbn.BIC(statistics)), (pbn.BGe(df), pbn.BGe(statistics))]:
+        for variable, evidence in [('a', []), ('b', ['a']), ('c', ['a', 'b']), ('d', ['a', 'b', 'c'])]:
+            assert np.isclose(score.local_score(gbn, variable, evidence),
+                              aggregated.local_score(gbn, variable, evidence))
+
+    start = pbn.GaussianNetwork(list(df.columns.values))
+    hc = pbn.GreedyHillClimbing()
+    res = hc.estimate(pbn.ArcOperatorSet(), pbn.BIC(df), start)
+    res_aggregated = hc.estimate(pbn.ArcOperatorSet(), pbn.BIC(statistics), start)
+    assert set(res.arcs()) == set(res_aggregated.arcs())
+
+    # The number of rows of the aggregates can exceed the 32-bit integers.
+    large_rows = 5 * 10**9
+    large_statistics = pbn.SufficientStatistics.from_covariance(list(df.columns), large_rows, df.mean().to_numpy(),
+                                                                df.cov().to_numpy())
+    assert large_statistics.continuous_rows() == large_rows
+    large_score = pbn.BIC(large_statistics).local_score(gbn, 'b', ['a'])
+    assert np.isfinite(large_score) and large_score < 0
+
+    with pytest.raises(ValueError):
+        pbn.SufficientStatistics.from_covariance(list(df.columns), 0, df.mean().to_numpy(), df.cov().to_numpy())
+
+    discrete_df = util_test.generate_discrete_data_dependent(SIZE)
+    count_table = discrete_df.groupby(['A', 'B', 'C', 'D'], observed=True).size().reset_index(name='count')
+    count_statistics = pbn.SufficientStatistics.from_counts(count_table)
+    assert count_statistics.discrete_rows() == SIZE
+
+    dbn = pbn.DiscreteBN(['A', 'B', 'C', 'D'])
+    for score, aggregated in [(pbn.BIC(discrete_df), pbn.BIC(count_statistics)),
+                              (pbn.BDe(discrete_df), pbn.BDe(count_statistics))]:
+        for variable, evidence in [('D', ['A', 'B', 'C']), ('B', ['A']), ('A', ['C', 'B']), ('C', [])]:
+            assert np.isclose(score.local_score(dbn, variable, evidence),
+                              aggregated.local_score(dbn, variable, evidence))
+
 def test_bic_score():
     gbn = pbn.GaussianNetwork([('a', 'b'), ('a', 'c'), ('a', 'd'), ('b', 'c'), ('b', 'd'), ('c', 'd')])
     
@@ -0,0 +1,108 @@
+import pytest
+import numpy as np
+import pybnesian as pbn
+import util_test
+
+SIZE = 1000
+
+df = util_test.generate_normal_data(SIZE)
+
+def test_cached_local_score():
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd'], [('a', 'b'), ('c', 'd')])
+
+    bic = pbn.BIC(df)
+    cached = pbn.CachedScore(bic)
+
+    assert cached.cache_size() == 0
+    assert np.isclose(cached.local_score(gbn, 'd', ['a', 'b']), bic.local_score(gbn, 'd', ['a', 'b']))
+    assert cached.misses() == 1 and cached.hits() == 0
+
+    # The order of the parents is not relevant.
+    assert np.isclose(cached.local_score(gbn, 'd', ['b', 'a']), bic.local_score(gbn, 'd', ['a', 'b']))
+    assert cached.misses() == 1 and cached.hits() == 1
+
+    # Explicit node types are cached separately.
+    assert np.isclose(cached.local_score_node_type(gbn, pbn.LinearGaussianCPDType(), 'd', ['a', 'b']),
+                      bic.local_score_node_type(gbn, pbn.LinearGaussianCPDType(), 'd', ['a', 'b']))
+    assert cached.misses() == 2 and cached.hits() == 1
+
+    assert np.isclose(cached.score(gbn), bic.score(gbn))
+    assert cached.cache_size() == 6
+
+    cached.clear_cache()
+    assert cached.cache_size() == 0
+    assert cached.hits() == 0 and cached.misses() == 0
+
+def test_cached_parent_types():
+    spbn = pbn.SemiparametricBN(['a', 'b', 'c', 'd'], [('a', 'b')])
+    cached = pbn.CachedScore(pbn.BIC(df))
+
+    cached.local_score(spbn, 'b', ['a'])
+    assert cached.misses() == 1
+
+    # The node types of the parents are part of the key.
+    spbn.set_node_type('a', pbn.CKDEType())
+    cached.local_score(spbn, 'b', ['a'])
+    assert cached.misses() == 2 and cached.cache_size() == 2
+
+    spbn.set_node_type('a', pbn.LinearGaussianCPDType())
+    cached.local_score(spbn, 'b', ['a'])
+    assert cached.misses() == 2 and cached.hits() == 1
+
+def test_cached_lru():
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd'])
+
+    cached = pbn.CachedScore(pbn.BIC(df), max_cache_size=2)
+    assert cached.max_cache_size() == 2
+
+    cached.local_score(gbn, 'a', [])
+    cached.local_score(gbn, 'b', [])
+    cached.local_score(gbn, 'a', [])
+    # 'b' is the least recently used local score.
+    cached.local_score(gbn, 'c', [])
+    assert cached.cache_size() == 2
+
+    cached.local_score(gbn, 'a', [])
+    assert cached.hits() == 2
+    cached.local_score(gbn, 'b', [])
+    assert cached.misses() == 4
+
+    with pytest.raises(ValueError) as ex:
+        pbn.CachedScore(pbn.BIC(df), max_cache_size=0)
+    assert "must be positive" in str(ex.value)
+
+def test_cached_hc():
+    bic = pbn.BIC(df)
+    cached = pbn.CachedScore(bic)
+    assert cached.is_thread_safe()
+
+    start = pbn.GaussianNetwork(list(df.columns.values))
+    hc = pbn.GreedyHillClimbing()
+
+    res = hc.estimate(pbn.ArcOperatorSet(), bic, start)
+    res_cached = hc.estimate(pbn.ArcOperatorSet(), cached, start)
+    assert set(res.arcs()) == set(res_cached.arcs())
+
+    # A second estimation reuses the local scores of the first one.
+    misses = cached.misses()
+    hc.estimate(pbn.ArcOperatorSet(), cached, start)
+    assert cached.misses() == misses
+
+def test_cached_validated():
+    vl = pbn.ValidatedLikelihood(df, seed=0)
+    cached = pbn.CachedValidatedScore(vl)
+    assert not cached.is_thread_safe()
+
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd'], [('a', 'b')])
+
+    assert np.isclose(cached.local_score(gbn, 'b', ['a']), vl.local_score(gbn, 'b', ['a']))
+    assert np.isclose(cached.vlocal_score(gbn, 'b', ['a']), vl.vlocal_score(gbn, 'b', ['a']))
+    assert cached.misses() == 2
+    assert np.isclose(cached.vlocal_score(gbn, 'b', ['a']), vl.vlocal_score(gbn, 'b', ['a']))
+    assert cached.hits() == 1
+
+    start = pbn.GaussianNetwork(list(df.columns.values))
+    hc = pbn.GreedyHillClimbing()
+    res = hc.estimate(pbn.ArcOperatorSet(), vl, start, max_iters=2)
+    res_cached = hc.estimate(pbn.ArcOperatorSet(), cached, start, max_iters=2)
+    assert set(res.arcs()) == set(res_cached.arcs())
@@ -200,6 +200,17 @@ def test_cvl_local_score_null_spbn():
     assert np.isclose(cvl.local_score_node_type(spbn, pbn.CKDEType(), 'd', ['a', 'b', 'c']),
                       numpy_local_score(pbn.CKDEType(), df_null, 'd', ['b', 'c', 'a']))
 
+def test_cvl_local_score_num_threads():
+    gbn = pbn.GaussianNetwork([('a', 'b'), ('a', 'c'), ('a', 'd'), ('b', 'c'), ('b', 'd'), ('c', 'd')])
+
+    cvl = pbn.CVLikelihood(df, 10, seed, num_threads=1)
+    cvl_threads = pbn.CVLikelihood(df, 10, seed, num_threads=4)
+
+    for variable, evidence in [('a', []), ('b', ['a']), ('c', ['a', 'b']), ('d', ['a', 'b', 'c'])]:
+        assert cvl.local_score(gbn, variable, evidence) == cvl_threads.local_score(gbn, variable, evidence)
+        assert np.isclose(cvl_threads.local_score(gbn, variable, evidence),
+                          numpy_local_score(pbn.LinearGaussianCPDType(), df, variable, evidence))
+
 def test_cvl_score():
     gbn = pbn.GaussianNetwork([('a', 'b'), ('a', 'c'), ('a', 'd'), ('b', 'c'), ('b', 'd'), ('c', 'd')])
 
@@ -218,4 +229,64 @@ def test_cvl_score():
                             cv.local_score(spbn, 'a') +
                             cv.local_score(spbn, 'b') +
                             cv.local_score(spbn, 'c') +
-                            cv.local_score(spbn, 'd')))
\ No newline at end of file
+                            cv.local_score(spbn, 'd')))
+
+def test_cvl_local_score_bound():
+    spbn = pbn.SemiparametricBN([('a', 'b'), ('a', 'c'), ('a', 'd'), ('b', 'c'), ('b', 'd'), ('c', 'd')],
+                            [('a', pbn.CKDEType()), ('c', pbn.CKDEType())])
+
+    cvl = pbn.CVLikelihood(df, 10, seed)
+    cvl_abandon = pbn.CVLikelihood(df, 10, seed, abandon_confidence=0.99)
+    assert cvl.abandon_confidence is None
+    assert cvl_abandon.abandon_confidence == 0.99
+
+    for variable, evidence in [('a', []), ('c', ['a', 'b'])]:
+        local_score = cvl.local_score(spbn, variable, evidence)
+        # Without abandon_confidence, the score of a continuous node is never abandoned.
+        assert cvl.local_score_bound(spbn, variable, evidence, 1e10) == (local_score, True)
+        assert cvl_abandon.local_score_bound(spbn, variable, evidence, -1e10) == (local_score, True)
+
+        value, exact = cvl_abandon.local_score_bound(spbn, variable, evidence, 1e10)
+        assert not exact
+        assert value < 1e10
+
+    discrete_df = util_test.generate_discrete_data_dependent(SIZE)
+    dbn = pbn.DiscreteBN(['A', 'B', 'C', 'D'])
+    cvl_discrete = pbn.CVLikelihood(discrete_df, 10, seed)
+
+    local_score = cvl_discrete.local_score(dbn, 'B', ['A'])
+    assert cvl_discrete.local_score_bound(dbn, 'B', ['A'], -1e10) == (local_score, True)
+    # The log-likelihood of discrete data is never positive, so the score is abandoned after the first fold.
+    value, exact = cvl_discrete.local_score_bound(dbn, 'B', ['A'], 1)
+    assert not exact
+    assert local_score <= value < 1
+
+    with pytest.raises(ValueError) as ex:
+        pbn.CVLikelihood(df, 10, seed, abandon_confidence=1)
+    assert "abandon_confidence must be in the interval" in str(ex.value)
+
+def test_cvl_local_score_cached():
+    # A float column disables the cached statistics, so the factors are fitted on the data of each fold.
+    df_uncached = df.copy()
+    df_uncached['e'] = df_uncached['a'].astype('float32')
+
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd'])
+    cached = pbn.CVLikelihood(df, 10, seed)
+    uncached = pbn.CVLikelihood(df_uncached, 10, seed)
+
+    for variable, evidence in [('a', []), ('b', ['a']), ('c', ['a', 'b']), ('d', ['a', 'b', 'c'])]:
+        assert np.isclose(cached.local_score(gbn, variable, evidence), uncached.local_score(gbn, variable, evidence))
+
+    hybrid_df = util_test.generate_hybrid_data(SIZE)
+    hybrid_uncached = hybrid_df.copy()
+    hybrid_uncached['E'] = hybrid_uncached['C'].astype('float32')
+
+    clg = pbn.CLGNetwork(['A', 'B', 'C', 'D'], [('A', pbn.DiscreteFactorType()), ('B', pbn.DiscreteFactorType()),
+                                                ('C', pbn.LinearGaussianCPDType()),
+                                                ('D', pbn.LinearGaussianCPDType())])
+    cached = pbn.CVLikelihood(hybrid_df, 10, seed)
+    uncached = pbn.CVLikelihood(hybrid_uncached, 10, seed)
+
+    for variable, evidence in [('C', []), ('C', ['A']), ('D', ['C']), ('D', ['A', 'C']), ('D', ['A', 'B', 'C']),
+                               ('D', ['C', 'B', 'A'])]:
+        assert np.isclose(cached.local_score(clg, variable, evidence), uncached.local_score(clg, variable, evidence))
@@ -194,4 +194,30 @@ def test_holdout_score():
                             hl.local_score(spbn, 'a') +
                             hl.local_score(spbn, 'b') +
                             hl.local_score(spbn, 'c') +
-                            hl.local_score(spbn, 'd')))
\ No newline at end of file
+                            hl.local_score(spbn, 'd')))
+
+def test_holdout_local_score_cached():
+    # A float column disables the cached statistics, so the factors are fitted on the training data.
+    df_uncached = df.copy()
+    df_uncached['e'] = df_uncached['a'].astype('float32')
+
+    gbn = pbn.GaussianNetwork(['a', 'b', 'c', 'd'])
+    cached = pbn.HoldoutLikelihood(df, 0.2, 0)
+    uncached = pbn.HoldoutLikelihood(df_uncached, 0.2, 0)
+
+    for variable, evidence in [('a', []), ('b', ['a']), ('c', ['a', 'b']), ('d', ['a', 'b', 'c'])]:
+        assert np.isclose(cached.local_score(gbn, variable, evidence), uncached.local_score(gbn, variable, evidence))
+
+    hybrid_df = util_test.generate_hybrid_data(SIZE)
+    hybrid_uncached = hybrid_df.copy()
+    hybrid_uncached['E'] = hybrid_uncached['C'].astype('float32')
+
+    clg = pbn.CLGNetwork(['A', 'B', 'C', 'D'], [('A', pbn.DiscreteFactorType()), ('B', pbn.DiscreteFactorType()),
+                                                ('C', pbn.LinearGaussianCPDType()),
+                                                ('D', pbn.LinearGaussianCPDType())])
+    cached = pbn.HoldoutLikelihood(hybrid_df, 0.2, 0)
+    uncached = pbn.HoldoutLikelihood(hybrid_uncached, 0.2, 0)
+
+    for variable, evidence in [('C', []), ('C', ['A']), ('D', ['C']), ('D', ['A', 'C']), ('D', ['A', 'B', 'C']),
+                               ('D', ['C', 'B', 'A'])]:
+        assert np.isclose(cached.local_score(clg, variable, evidence), uncached.local_score(clg, variable, evidence))
@@ -218,6 +218,32 @@ def test_arcs():
     assert not gbn.has_path('a', 'c')
     assert not gbn.has_path('b', 'c')
 
+def test_arcs_random_acyclicity():
+    # The acyclicity checks use a topological order updated incrementally. Compare them with has_path().
+    nodes = ['a', 'b', 'c', 'd', 'e', 'f', 'g', 'h']
+    gbn = GaussianNetwork(nodes)
+    rng = np.random.default_rng(0)
+
+    for _ in range(1000):
+        source, target = rng.choice(nodes, size=2, replace=False)
+
+        if gbn.has_arc(source, target):
+            can_flip = gbn.can_flip_arc(source, target)
+            # The arc can be flipped if there is no other path from source to target.
+            gbn.remove_arc(source, target)
+            assert can_flip == (not gbn.has_path(source, target))
+            gbn.add_arc(source, target)
+        else:
+            assert gbn.can_add_arc(source, target) == (not gbn.has_path(target, source))
+
+        op = rng.integers(3)
+        if op == 0 and not gbn.has_arc(target, source) and gbn.can_add_arc(source, target):
+            gbn.add_arc(source, target)
+        elif op == 1 and gbn.has_arc(source, target):
+            gbn.remove_arc(source, target)
+        elif op == 2 and gbn.has_arc(source, target) and gbn.can_flip_arc(source, target):
+            gbn.flip_arc(source, target)
+
 def test_bn_fit():
     gbn = GaussianNetwork([('a', 'b'), ('a', 'c'), ('a', 'd'), ('b', 'c'), ('b', 'd'), ('c', 'd')])
 